@@ -0,0 +1,62 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_JSONWRITER_H_
+#define MAINS_JSONWRITER_H_
+
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+/// \file JsonWriter.h
+/// Helpers used by the benchmarking applications to write their results in JSON.
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+/// \brief Stream manipulator writing a string as a quoted JSON string.
+///
+/// Quotes, backslashes and control characters are escaped, so names read from the configuration
+/// (e.g. of benchmarks or components) cannot produce invalid output.
+class JsonString {
+ public:
+  explicit JsonString(const std::string & str) : str_(str) {}
+
+  friend std::ostream & operator<<(std::ostream & os, const JsonString & json) {
+    os << '"';
+    for (const char c : json.str_) {
+      switch (c) {
+      case '"': os << "\\\""; break;
+      case '\\': os << "\\\\"; break;
+      case '\b': os << "\\b"; break;
+      case '\f': os << "\\f"; break;
+      case '\n': os << "\\n"; break;
+      case '\r': os << "\\r"; break;
+      case '\t': os << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+          os << escaped;
+        } else {
+          os << c;
+        }
+      }
+    }
+    return os << '"';
+  }
+
+ private:
+  const std::string & str_;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
+
+#endif  // MAINS_JSONWRITER_H_
@@ -0,0 +1,96 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_METOFFICEMATRIXCACHEWRITER_H_
+#define MAINS_METOFFICEMATRIXCACHEWRITER_H_
+
+#include <string>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/mpi/Comm.h"
+
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Application.h"
+#include "oops/util/Logger.h"
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+#include "ufo/utils/metoffice/MetOfficeBMatrixStatic.h"
+#include "ufo/utils/metoffice/MetOfficeRMatrixRadiance.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+/// \brief A matrix to convert.
+class MatrixCacheParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(MatrixCacheParameters, Parameters)
+
+ public:
+  /// Options passed to the MetOfficeBMatrixStatic or MetOfficeRMatrixRadiance constructor.
+  oops::RequiredParameter<eckit::LocalConfiguration> matrix{"matrix", this};
+  /// Cache file to write.
+  oops::RequiredParameter<std::string> output{"output", this};
+  /// If true, the cache file also holds the inverse of each band of the B-matrix.
+  oops::Parameter<bool> inverse{"with inverse", false, this};
+};
+
+/// \brief Options of the ufo_metoffice_matrix_cache.x application.
+class MetOfficeMatrixCacheWriterParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(MetOfficeMatrixCacheWriterParameters, Parameters)
+
+ public:
+  oops::OptionalParameter<MatrixCacheParameters> bMatrix{"B-matrix", this};
+  oops::OptionalParameter<MatrixCacheParameters> rMatrix{"R-matrix", this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Converts Met Office B- and R-matrix files into binary cache files that
+/// MetOfficeBMatrixStatic and MetOfficeRMatrixRadiance memory-map when given the
+/// "BMatrix cache" and "RMatrix cache" options. The B-matrix cache can only be used with the
+/// "background fields" and "qtotal" options with which it was written.
+class MetOfficeMatrixCacheWriter : public oops::Application {
+ public:
+// -----------------------------------------------------------------------------
+  explicit MetOfficeMatrixCacheWriter(const eckit::mpi::Comm & comm = oops::mpi::world())
+    : Application(comm) {}
+// -----------------------------------------------------------------------------
+  int execute(const eckit::Configuration & fullConfig, bool validate) const {
+    MetOfficeMatrixCacheWriterParameters params;
+    if (validate) params.validate(fullConfig);
+    params.deserialize(fullConfig);
+
+    if (this->getComm().rank() != 0)
+      return 0;
+
+    if (params.bMatrix.value() != boost::none) {
+      const MatrixCacheParameters & bParams = *params.bMatrix.value();
+      const MetOfficeBMatrixStatic bmatrix(bParams.matrix.value());
+      bmatrix.writeCache(bParams.output.value(), bParams.matrix.value(), bParams.inverse.value());
+    }
+    if (params.rMatrix.value() != boost::none) {
+      const MatrixCacheParameters & rParams = *params.rMatrix.value();
+      const MetOfficeRMatrixRadiance rmatrix(rParams.matrix.value());
+      rmatrix.writeCache(rParams.output.value());
+    }
+    return 0;
+  }
+// -----------------------------------------------------------------------------
+ private:
+  std::string appname() const {
+    return "ufo::MetOfficeMatrixCacheWriter";
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
+
+#endif  // MAINS_METOFFICEMATRIXCACHEWRITER_H_
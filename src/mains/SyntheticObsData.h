@@ -0,0 +1,324 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_SYNTHETICOBSDATA_H_
+#define MAINS_SYNTHETICOBSDATA_H_
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsSpaceParameters.h"
+
+#include "oops/base/Variables.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Duration.h"
+#include "oops/util/IntSetParser.h"
+#include "oops/util/Logger.h"
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+
+/// \file SyntheticObsData.h
+/// Generation of obs spaces and GeoVaLs in memory, used by the benchmarking applications.
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+/// \brief Options controlling the generation of a synthetic obs space.
+///
+/// Locations are generated on all tasks from the same seed and distributed by ioda like the
+/// locations read from a file. The following distributions are available:
+///
+/// - `uniform`: locations spread uniformly over the sphere and the assimilation window;
+/// - `clustered`: locations scattered around `number of clusters` random centres with a standard
+///   deviation of `cluster radius` degrees;
+/// - `track`: `number of tracks` moving platforms (e.g. ships), each with a different
+///   `MetaData/station_id` and reporting at regular intervals;
+/// - `profile`: profiles with `levels per profile` locations each, grouped into records by
+///   latitude and with `MetaData/air_pressure` decreasing with height.
+///
+/// `ObsValue` and `HofX` are filled with smooth fields plus noise, so that filters comparing
+/// them have something to do.
+class SyntheticObsSpaceParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(SyntheticObsSpaceParameters, Parameters)
+
+ public:
+  oops::Parameter<std::string> name{"name", "Synthetic", this};
+  oops::RequiredParameter<std::vector<std::string>> simulatedVariables{
+    "simulated variables", this};
+  /// Channels of the simulated variables, e.g. `1-100`.
+  oops::OptionalParameter<std::string> channels{"channels", this};
+  oops::Parameter<std::string> distribution{"distribution", "uniform", this};
+  oops::Parameter<int> numberOfClusters{"number of clusters", 10, this};
+  oops::Parameter<double> clusterRadius{"cluster radius", 2.0, this};
+  oops::Parameter<int> numberOfTracks{"number of tracks", 100, this};
+  oops::Parameter<int> levelsPerProfile{"levels per profile", 50, this};
+  oops::Parameter<int> seed{"seed", 1, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Options controlling the generation of a synthetic GeoVaL.
+///
+/// Values vary linearly from `top value` at the first level (GeoVaLs are stored top-down) to
+/// `bottom value` at the last level, and are the same at all locations.
+class SyntheticGeoVaLParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(SyntheticGeoVaLParameters, Parameters)
+
+ public:
+  oops::RequiredParameter<std::string> name{"name", this};
+  oops::Parameter<int> levels{"levels", 1, this};
+  oops::Parameter<double> topValue{"top value", 0.0, this};
+  oops::Parameter<double> bottomValue{"bottom value", 0.0, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// Names of the simulated variables of \p params, expanded with channel numbers.
+inline std::vector<std::string> simulatedVariableNames(
+    const SyntheticObsSpaceParameters & params) {
+  std::vector<std::string> names;
+  for (const std::string & var : params.simulatedVariables.value()) {
+    if (params.channels.value() == boost::none) {
+      names.push_back(var);
+    } else {
+      for (int channel : oops::parseIntSet(*params.channels.value()))
+        names.push_back(var + "_" + std::to_string(channel));
+    }
+  }
+  return names;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Generate the latitudes, longitudes and times (in seconds since the start of the window) of
+/// \p nlocs locations.
+inline void generateLocations(const SyntheticObsSpaceParameters & params, size_t nlocs,
+                              int64_t windowLength, std::vector<double> & lats,
+                              std::vector<double> & lons, std::vector<int> & times) {
+  std::mt19937 gen(params.seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  auto randomLat = [&]() { return std::asin(2.0 * uniform(gen) - 1.0) * 180.0 / M_PI; };
+  auto randomLon = [&]() { return 360.0 * uniform(gen) - 180.0; };
+  // The assimilation window excludes its beginning.
+  auto randomTime = [&]() { return 1 + static_cast<int>(uniform(gen) * (windowLength - 1)); };
+  auto clampLat = [](double lat) { return std::max(-90.0, std::min(90.0, lat)); };
+  auto wrapLon = [](double lon) { return lon - 360.0 * std::floor((lon + 180.0) / 360.0); };
+
+  lats.resize(nlocs);
+  lons.resize(nlocs);
+  times.resize(nlocs);
+  const std::string & distribution = params.distribution;
+  if (distribution == "uniform") {
+    for (size_t i = 0; i < nlocs; ++i) {
+      lats[i] = randomLat();
+      lons[i] = randomLon();
+      times[i] = randomTime();
+    }
+  } else if (distribution == "clustered") {
+    const int nclusters = std::max(params.numberOfClusters.value(), 1);
+    std::vector<std::pair<double, double>> centres(nclusters);
+    for (auto & centre : centres) centre = std::make_pair(randomLat(), randomLon());
+    std::normal_distribution<double> offset(0.0, params.clusterRadius);
+    for (size_t i = 0; i < nlocs; ++i) {
+      const auto & centre = centres[i % nclusters];
+      lats[i] = clampLat(centre.first + offset(gen));
+      lons[i] = wrapLon(centre.second + offset(gen));
+      times[i] = randomTime();
+    }
+  } else if (distribution == "track") {
+    const size_t ntracks = std::max(params.numberOfTracks.value(), 1);
+    const size_t reportsPerTrack = (nlocs + ntracks - 1) / ntracks;
+    std::vector<double> lat(ntracks), lon(ntracks), dlat(ntracks), dlon(ntracks);
+    std::normal_distribution<double> speed(0.0, 0.05);
+    for (size_t t = 0; t < ntracks; ++t) {
+      lat[t] = 0.9 * randomLat();
+      lon[t] = randomLon();
+      dlat[t] = speed(gen);
+      dlon[t] = speed(gen);
+    }
+    for (size_t i = 0; i < nlocs; ++i) {
+      const size_t t = i % ntracks, step = i / ntracks;
+      lats[i] = clampLat(lat[t] + step * dlat[t]);
+      lons[i] = wrapLon(lon[t] + step * dlon[t]);
+      times[i] = 1 + static_cast<int>(step * (windowLength - 1) / reportsPerTrack);
+    }
+  } else if (distribution == "profile") {
+    const size_t nlevels = std::max(params.levelsPerProfile.value(), 1);
+    const size_t nprofiles = (nlocs + nlevels - 1) / nlevels;
+    for (size_t i = 0; i < nlocs; ++i) {
+      const size_t p = i / nlevels;
+      // Latitudes must differ between profiles because records are defined by latitude.
+      if (i % nlevels == 0) {
+        lats[i] = -89.0 + 178.0 * (p + uniform(gen)) / nprofiles;
+        lons[i] = randomLon();
+        times[i] = randomTime();
+      } else {
+        lats[i] = lats[i - 1];
+        lons[i] = lons[i - 1];
+        times[i] = times[i - 1];
+      }
+    }
+  } else {
+    throw eckit::BadParameter("Unknown synthetic obs distribution '" + distribution + "'",
+                              Here());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/// Parameters of an obs space holding \p nlocs locations generated as specified in \p params.
+inline ioda::ObsTopLevelParameters syntheticObsSpaceParameters(
+    const SyntheticObsSpaceParameters & params, size_t nlocs,
+    const util::DateTime & bgn, const util::DateTime & end) {
+  std::vector<double> lats, lons;
+  std::vector<int> times;
+  generateLocations(params, nlocs, (end - bgn).toSeconds(), lats, lons, times);
+
+  eckit::LocalConfiguration engine;
+  engine.set("type", "GenList");
+  engine.set("lats", lats);
+  engine.set("lons", lons);
+  engine.set("dateTimes", times);
+  engine.set("epoch", "seconds since " + bgn.toString());
+  engine.set("obs errors", std::vector<double>(simulatedVariableNames(params).size(), 1.0));
+  eckit::LocalConfiguration obsdatain;
+  obsdatain.set("engine", engine);
+  if (params.distribution.value() == "profile") {
+    eckit::LocalConfiguration grouping;
+    grouping.set("group variables", std::vector<std::string>{"latitude"});
+    obsdatain.set("obsgrouping", grouping);
+  }
+
+  eckit::LocalConfiguration conf;
+  conf.set("name", params.name.value());
+  conf.set("simulated variables", params.simulatedVariables.value());
+  if (params.channels.value() != boost::none)
+    conf.set("channels", *params.channels.value());
+  conf.set("obsdatain", obsdatain);
+
+  ioda::ObsTopLevelParameters obsparams;
+  obsparams.validateAndDeserialize(conf);
+  return obsparams;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Fill the ObsValue, HofX and distribution-specific MetaData variables of \p obsdb.
+inline void fillSyntheticObsSpace(const SyntheticObsSpaceParameters & params,
+                                  ioda::ObsSpace & obsdb) {
+  const size_t nlocal = obsdb.nlocs();
+  const std::vector<size_t> & index = obsdb.index();
+  std::vector<float> lats(nlocal);
+  obsdb.get_db("MetaData", "latitude", lats);
+
+  std::mt19937 gen(params.seed + 1 + obsdb.comm().rank());
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+  std::vector<float> obsValues(nlocal), hofx(nlocal);
+  for (const std::string & var : simulatedVariableNames(params)) {
+    for (size_t i = 0; i < nlocal; ++i) {
+      obsValues[i] = 280.0f - 0.5f * std::abs(lats[i]) + noise(gen);
+      hofx[i] = obsValues[i] + noise(gen);
+    }
+    obsdb.put_db("ObsValue", var, obsValues);
+    obsdb.put_db("HofX", var, hofx);
+  }
+
+  const std::string & distribution = params.distribution;
+  if (distribution == "track") {
+    const size_t ntracks = std::max(params.numberOfTracks.value(), 1);
+    std::vector<std::string> stationIds(nlocal);
+    for (size_t i = 0; i < nlocal; ++i)
+      stationIds[i] = "track" + std::to_string(index[i] % ntracks);
+    obsdb.put_db("MetaData", "station_id", stationIds);
+  } else if (distribution == "profile") {
+    const size_t nlevels = std::max(params.levelsPerProfile.value(), 1);
+    std::vector<float> pressures(nlocal);
+    for (size_t i = 0; i < nlocal; ++i)
+      pressures[i] = 100000.0f - 99000.0f * (index[i] % nlevels) / nlevels;
+    obsdb.put_db("MetaData", "air_pressure", pressures);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/// Locations of all observations held by \p obsdb on this task.
+inline std::unique_ptr<Locations> obsSpaceLocations(const ioda::ObsSpace & obsdb) {
+  std::vector<float> lons(obsdb.nlocs());
+  std::vector<float> lats(obsdb.nlocs());
+  std::vector<util::DateTime> times(obsdb.nlocs());
+  obsdb.get_db("MetaData", "latitude", lats);
+  obsdb.get_db("MetaData", "longitude", lons);
+  obsdb.get_db("MetaData", "dateTime", times);
+  return std::unique_ptr<Locations>(new Locations(lons, lats, times, obsdb.distribution()));
+}
+
+// -----------------------------------------------------------------------------
+
+inline const SyntheticGeoVaLParameters * findGeoVaL(
+    const std::vector<SyntheticGeoVaLParameters> & specs, const std::string & var) {
+  for (const SyntheticGeoVaLParameters & spec : specs)
+    if (spec.name.value() == var) return &spec;
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Numbers of levels of the GeoVaLs \p vars.
+inline std::vector<size_t> geovalLevels(const std::vector<SyntheticGeoVaLParameters> & specs,
+                                        const oops::Variables & vars) {
+  std::vector<size_t> nlevs;
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    const SyntheticGeoVaLParameters * spec = findGeoVaL(specs, vars[jv]);
+    if (spec == nullptr)
+      oops::Log::warning() << "No synthetic profile specified for GeoVaL "
+                           << vars[jv] << "; using a single level of zeros" << std::endl;
+    nlevs.push_back(spec ? std::max(spec->levels.value(), 1) : 1);
+  }
+  return nlevs;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Fill the GeoVaLs \p vars of \p gval with the profiles specified in \p specs.
+inline void fillSyntheticGeoVaLs(const std::vector<SyntheticGeoVaLParameters> & specs,
+                                 const oops::Variables & vars, const GeoVaLs & gval) {
+  std::vector<double> values(gval.nlocs());
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    const SyntheticGeoVaLParameters * spec = findGeoVaL(specs, vars[jv]);
+    const size_t nlevs = gval.nlevs(vars[jv]);
+    for (size_t jlev = 0; jlev < nlevs; ++jlev) {
+      double value = 0.0;
+      if (spec != nullptr) {
+        const double weight = nlevs > 1 ? static_cast<double>(jlev) / (nlevs - 1) : 0.0;
+        value = spec->topValue + weight * (spec->bottomValue - spec->topValue);
+      }
+      std::fill(values.begin(), values.end(), value);
+      gval.putAtLevel(values, vars[jv], jlev);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
+
+#endif  // MAINS_SYNTHETICOBSDATA_H_
@@ -0,0 +1,410 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_UFOBENCH_H_
+#define MAINS_UFOBENCH_H_
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/mpi/Comm.h"
+
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+
+#include "oops/base/ObsFilters.h"
+#include "oops/base/Variables.h"
+#include "oops/interface/GeoVaLs.h"
+#include "oops/interface/Locations.h"
+#include "oops/interface/ObsAuxControl.h"
+#include "oops/interface/ObsDataVector.h"
+#include "oops/interface/ObsDiagnostics.h"
+#include "oops/interface/ObsOperator.h"
+#include "oops/interface/ObsSpace.h"
+#include "oops/interface/ObsVector.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Application.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+#include "oops/util/parameters/NumericConstraints.h"
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+#include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/obsfunctions/ObsFunction.h"
+#include "ufo/filters/Variable.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsBiasParameters.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsOperatorParametersBase.h"
+#include "ufo/ObsTraits.h"
+#include "ufo/predictors/PredictorBase.h"
+#include "ufo/utils/parameters/ParameterTraitsVariable.h"
+
+#include "./JsonWriter.h"
+#include "./SyntheticObsData.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+/// \brief A single benchmark: an obs space and the components to be timed on it.
+///
+/// Each component that is configured is timed separately, in the following order: the obs
+/// operator, the bias predictors, the obs filters (using the H(x) and diagnostics computed by the
+/// operator, if there is one, and the synthetic `HofX` otherwise) and the obs function.
+class BenchmarkParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(BenchmarkParameters, Parameters)
+
+ public:
+  oops::RequiredParameter<std::string> name{"name", this};
+  oops::RequiredParameter<SyntheticObsSpaceParameters> obsSpace{"obs space", this};
+  oops::ObsFiltersParameters<ObsTraits> filtersParams{this};
+  oops::OptionalParameter<ObsOperatorParametersWrapper> obsOperator{"obs operator", this};
+  oops::OptionalParameter<Variable> obsFunction{"obs function", this};
+  oops::Parameter<ObsBiasParameters> obsBias{"obs bias", {}, this};
+  /// GeoVaLs required by the benchmarked components. GeoVaLs not listed here are given a single
+  /// level filled with zeros.
+  oops::Parameter<std::vector<SyntheticGeoVaLParameters>> geovals{"geovals", {}, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Results of an earlier run to compare against.
+class BenchmarkBaselineParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(BenchmarkBaselineParameters, Parameters)
+
+ public:
+  /// Output file of an earlier run of ufo_bench.x.
+  oops::RequiredParameter<std::string> file{"file", this};
+  /// The run fails if the median time of any measurement exceeds this multiple of the median
+  /// time of the same measurement (benchmark, component, size, threads and tasks) in `file`.
+  oops::Parameter<double> maxSlowdown{"max slowdown", 1.2, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Top-level options of ufo_bench.x.
+class UfoBenchParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(UfoBenchParameters, Parameters)
+
+ public:
+  oops::RequiredParameter<util::DateTime> windowBegin{"window begin", this};
+  oops::RequiredParameter<util::DateTime> windowEnd{"window end", this};
+  /// Total numbers of locations for which each benchmark is run.
+  oops::RequiredParameter<std::vector<int>> sizes{"sizes", this};
+  /// Numbers of OpenMP threads for which each benchmark is run. If empty, the default number of
+  /// threads is used. The number of MPI tasks is that of the run; see ufo_scaling.x.
+  oops::Parameter<std::vector<int>> threads{"threads", {}, this};
+  oops::Parameter<int> repetitions{"repetitions", 3, this, {oops::minConstraint(1)}};
+  oops::Parameter<int> warmUpRepetitions{"warm up repetitions", 1, this,
+                                         {oops::minConstraint(0)}};
+  oops::RequiredParameter<std::vector<BenchmarkParameters>> benchmarks{"benchmarks", this};
+  /// File to which the results are written (in JSON). If not set, they are only logged.
+  oops::OptionalParameter<std::string> outputFile{"output file", this};
+  oops::OptionalParameter<BenchmarkBaselineParameters> baseline{"baseline", this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Times UFO filters, obs functions, obs operators and bias predictors on synthetic data.
+///
+/// Obs spaces and GeoVaLs are generated in memory (see SyntheticObsSpaceParameters and
+/// SyntheticGeoVaLParameters), so no input files are needed. Each benchmark is run for every
+/// combination of the configured sizes and thread counts; the time of each repetition is the
+/// maximum over MPI tasks.
+template <typename OBS> class UfoBench : public oops::Application {
+  typedef oops::GeoVaLs<OBS>               GeoVaLs_;
+  typedef oops::Locations<OBS>             Locations_;
+  typedef oops::ObsAuxControl<OBS>         ObsAuxCtrl_;
+  typedef oops::ObsDataVector<OBS, float>  ObsDataVectorFloat_;
+  typedef oops::ObsDataVector<OBS, int>    ObsDataVectorInt_;
+  typedef oops::ObsDiagnostics<OBS>        ObsDiags_;
+  typedef oops::ObsFilters<OBS>            ObsFilters_;
+  typedef oops::ObsOperator<OBS>           ObsOperator_;
+  typedef oops::ObsSpace<OBS>              ObsSpace_;
+  typedef oops::ObsVector<OBS>             ObsVector_;
+
+  /// Times of all repetitions of one component of one benchmark.
+  struct Measurement {
+    std::string benchmark;
+    std::string component;
+    size_t nlocs;
+    int threads;
+    size_t tasks;
+    std::vector<double> seconds;
+
+    double min() const {
+      ASSERT(!seconds.empty());
+      return *std::min_element(seconds.begin(), seconds.end());
+    }
+    double mean() const {
+      return std::accumulate(seconds.begin(), seconds.end(), 0.0) / seconds.size();
+    }
+    double median() const {
+      ASSERT(!seconds.empty());
+      std::vector<double> sorted(seconds);
+      std::sort(sorted.begin(), sorted.end());
+      const size_t n = sorted.size();
+      return n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    }
+  };
+
+ public:
+// -----------------------------------------------------------------------------
+  explicit UfoBench(const eckit::mpi::Comm & comm = oops::mpi::world()) : Application(comm) {}
+// -----------------------------------------------------------------------------
+  virtual ~UfoBench() {}
+// -----------------------------------------------------------------------------
+  int execute(const eckit::Configuration & fullConfig, bool validate) const {
+    UfoBenchParameters params;
+    if (validate) params.validate(fullConfig);
+    params.deserialize(fullConfig);
+
+    std::vector<int> threadCounts = params.threads;
+    if (threadCounts.empty()) threadCounts.push_back(defaultThreadCount());
+
+    std::vector<Measurement> measurements;
+    for (const BenchmarkParameters & benchmark : params.benchmarks.value()) {
+      for (const int size : params.sizes.value()) {
+        for (const int nthreads : threadCounts) {
+          setThreadCount(nthreads);
+          runBenchmark(params, benchmark, size, nthreads, measurements);
+        }
+      }
+    }
+    setThreadCount(defaultThreadCount());
+
+    for (const Measurement & m : measurements)
+      oops::Log::info() << "ufo_bench: " << m.benchmark << " / " << m.component
+                        << ": nlocs = " << m.nlocs << ", threads = " << m.threads
+                        << ", tasks = " << m.tasks << ", median = " << m.median() << " s"
+                        << std::endl;
+
+    if (params.outputFile.value() != boost::none && this->getComm().rank() == 0) {
+      std::ofstream os(*params.outputFile.value());
+      writeJson(measurements, os);
+    }
+
+    if (params.baseline.value() != boost::none)
+      compareWithBaseline(measurements, *params.baseline.value());
+
+    return 0;
+  }
+// -----------------------------------------------------------------------------
+ private:
+  std::string appname() const {
+    return "ufo::UfoBench<" + OBS::name() + ">";
+  }
+// -----------------------------------------------------------------------------
+  static int defaultThreadCount() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+// -----------------------------------------------------------------------------
+  static void setThreadCount(int nthreads) {
+#ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+#else
+    if (nthreads != 1)
+      oops::Log::warning() << "ufo_bench: built without OpenMP, running single-threaded"
+                           << std::endl;
+#endif
+  }
+// -----------------------------------------------------------------------------
+  /// Run \p f `warm up repetitions` times untimed and `repetitions` times timed.
+  template <typename F>
+  std::vector<double> time(const UfoBenchParameters & params, const F & f) const {
+    const eckit::mpi::Comm & comm = this->getComm();
+    for (int i = 0; i < params.warmUpRepetitions; ++i)
+      f();
+    std::vector<double> seconds;
+    for (int i = 0; i < params.repetitions; ++i) {
+      comm.barrier();
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                     start).count();
+      comm.allReduceInPlace(elapsed, eckit::mpi::max());
+      seconds.push_back(elapsed);
+    }
+    return seconds;
+  }
+// -----------------------------------------------------------------------------
+  void runBenchmark(const UfoBenchParameters & params, const BenchmarkParameters & benchmark,
+                    size_t nlocs, int nthreads, std::vector<Measurement> & measurements) const {
+    const util::DateTime & bgn = params.windowBegin;
+    const util::DateTime & end = params.windowEnd;
+    ObsSpace_ obspace(syntheticObsSpaceParameters(benchmark.obsSpace, nlocs, bgn, end),
+                      this->getComm(), bgn, end, oops::mpi::myself());
+    ioda::ObsSpace & ios = obspace.obsspace();
+    fillSyntheticObsSpace(benchmark.obsSpace, ios);
+
+    auto record = [&](const std::string & component, std::vector<double> seconds) {
+      measurements.push_back(Measurement{benchmark.name, component, nlocs, nthreads,
+                                         this->getComm().size(), std::move(seconds)});
+    };
+
+    // Collect the variables required by all components.
+    ObsDataVectorFloat_ obserr0(obspace, obspace.obsvariables(), "ObsError");
+    std::shared_ptr<ObsDataVectorInt_> qcflags0(new ObsDataVectorInt_(obspace,
+                                                                      obspace.obsvariables()));
+    const ObsFilters_ filtersForVars(obspace, benchmark.filtersParams, qcflags0, obserr0);
+    const ObsAuxCtrl_ ybias(obspace, benchmark.obsBias);
+    std::unique_ptr<ObsOperator_> hop;
+    if (benchmark.obsOperator.value() != boost::none)
+      hop.reset(new ObsOperator_(obspace, *benchmark.obsOperator.value()));
+    std::unique_ptr<ObsFunction<float>> obsfunc;
+    if (benchmark.obsFunction.value() != boost::none)
+      obsfunc.reset(new ObsFunction<float>(*benchmark.obsFunction.value()));
+
+    oops::Variables geovars;
+    geovars += filtersForVars.requiredVars();
+    geovars += ybias.requiredVars();
+    if (hop) geovars += hop->requiredVars();
+    if (obsfunc) geovars += obsfunc->requiredVariables().allFromGroup("GeoVaLs").toOopsVariables();
+    oops::Variables diagvars;
+    diagvars += filtersForVars.requiredHdiagnostics();
+    diagvars += ybias.requiredHdiagnostics();
+
+    const Locations_ locs(obsSpaceLocations(ios));
+    const GeoVaLs_ gval(locs, geovars, geovalLevels(benchmark.geovals, geovars));
+    fillSyntheticGeoVaLs(benchmark.geovals, geovars, gval.geovals());
+
+    ObsVector_ bias(obspace);
+    bias.zero();
+    ObsVector_ hofx(obspace, "HofX");
+    ObsDiags_ diags(obspace, locs, diagvars);
+
+    if (hop) {
+      record("obs operator", time(params, [&]() {
+        hop->simulateObs(gval, hofx, ybias, bias, diags);
+      }));
+    }
+
+    const Predictors & predictors = ybias.obsauxcontrol().predictors();
+    if (!predictors.empty()) {
+      if (ybias.requiredHdiagnostics().size() > 0 && !hop)
+        throw eckit::UserError("ufo_bench: benchmarks of predictors requiring obs diagnostics "
+                               "need an obs operator", Here());
+      std::vector<ioda::ObsVector> predData(predictors.size(), ioda::ObsVector(ios));
+      record("bias predictors", time(params, [&]() {
+        for (size_t p = 0; p < predictors.size(); ++p)
+          predictors[p]->compute(ios, gval.geovals(), diags.obsdiagnostics(),
+                                 ybias.obsauxcontrol(), predData[p]);
+      }));
+    }
+
+    if (hasFilters(benchmark)) {
+      record("obs filters", time(params, [&]() {
+        ObsDataVectorFloat_ obserr(obspace, obspace.obsvariables(), "ObsError");
+        std::shared_ptr<ObsDataVectorInt_> qcflags(new ObsDataVectorInt_(
+                                                     obspace, obspace.obsvariables()));
+        ObsFilters_ filters(obspace, benchmark.filtersParams, qcflags, obserr);
+        filters.preProcess();
+        filters.priorFilter(gval);
+        filters.postFilter(gval, hofx, bias, diags);
+      }));
+    }
+
+    if (obsfunc) {
+      ObsFilterData data(ios);
+      data.associate(gval.geovals());
+      data.associate(hofx.obsvector(), "HofX");
+      data.associate(bias.obsvector(), "ObsBiasData");
+      data.associate(diags.obsdiagnostics());
+      ioda::ObsDataVector<float> values(ios, benchmark.obsFunction.value()->toOopsVariables());
+      record("obs function", time(params, [&]() {
+        obsfunc->compute(data, values);
+      }));
+    }
+  }
+// -----------------------------------------------------------------------------
+  static bool hasFilters(const BenchmarkParameters & benchmark) {
+    const eckit::LocalConfiguration conf = benchmark.toConfiguration();
+    for (const char * key : {"obs filters", "obs pre filters", "obs prior filters",
+                             "obs post filters"})
+      if (conf.has(key) && !conf.getSubConfigurations(key).empty()) return true;
+    return false;
+  }
+// -----------------------------------------------------------------------------
+  static void writeJson(const std::vector<Measurement> & measurements, std::ostream & os) {
+    os << std::setprecision(9) << "{\n  \"results\": [";
+    for (size_t i = 0; i < measurements.size(); ++i) {
+      const Measurement & m = measurements[i];
+      os << (i ? "," : "") << "\n    {\"benchmark\": " << JsonString(m.benchmark)
+         << ", \"component\": " << JsonString(m.component) << ", \"nlocs\": " << m.nlocs
+         << ", \"threads\": " << m.threads << ", \"tasks\": " << m.tasks
+         << ", \"min\": " << m.min() << ", \"median\": " << m.median()
+         << ", \"mean\": " << m.mean() << ", \"seconds\": [";
+      for (size_t j = 0; j < m.seconds.size(); ++j)
+        os << (j ? ", " : "") << m.seconds[j];
+      os << "]}";
+    }
+    os << "\n  ]\n}\n";
+  }
+// -----------------------------------------------------------------------------
+  void compareWithBaseline(const std::vector<Measurement> & measurements,
+                           const BenchmarkBaselineParameters & baseline) const {
+    typedef std::tuple<std::string, std::string, size_t, int, size_t> Key;
+    std::map<Key, double> baselineMedians;
+    const eckit::YAMLConfiguration baselineConf{eckit::PathName(baseline.file.value())};
+    for (const eckit::LocalConfiguration & result : baselineConf.getSubConfigurations("results"))
+      baselineMedians[Key(result.getString("benchmark"), result.getString("component"),
+                          result.getUnsigned("nlocs"), result.getInt("threads"),
+                          result.getUnsigned("tasks"))] = result.getDouble("median");
+
+    std::stringstream regressions;
+    for (const Measurement & m : measurements) {
+      const auto it = baselineMedians.find(Key(m.benchmark, m.component, m.nlocs, m.threads,
+                                               m.tasks));
+      if (it == baselineMedians.end() || it->second <= 0.0) continue;
+      const double ratio = m.median() / it->second;
+      oops::Log::info() << "ufo_bench: " << m.benchmark << " / " << m.component
+                        << ", nlocs = " << m.nlocs << ": " << ratio << " x baseline"
+                        << std::endl;
+      if (ratio > baseline.maxSlowdown)
+        regressions << "\n  " << m.benchmark << " / " << m.component << " (nlocs = "
+                    << m.nlocs << ", threads = " << m.threads << ", tasks = " << m.tasks
+                    << "): " << ratio << " x baseline";
+    }
+    if (!regressions.str().empty())
+      throw eckit::Exception("ufo_bench: slowdown above " +
+                             std::to_string(baseline.maxSlowdown.value()) + " x baseline in:" +
+                             regressions.str(), Here());
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
+
+#endif  // MAINS_UFOBENCH_H_
@@ -0,0 +1,377 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_UFOSCALING_H_
+#define MAINS_UFOSCALING_H_
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
+#include "eckit/system/ResourceUsage.h"
+
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsSpaceParameters.h"
+
+#include "oops/base/ObsFilters.h"
+#include "oops/base/Variables.h"
+#include "oops/interface/GeoVaLs.h"
+#include "oops/interface/Locations.h"
+#include "oops/interface/ObsAuxControl.h"
+#include "oops/interface/ObsDataVector.h"
+#include "oops/interface/ObsDiagnostics.h"
+#include "oops/interface/ObsOperator.h"
+#include "oops/interface/ObsSpace.h"
+#include "oops/interface/ObsVector.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Application.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/ObsBiasParameters.h"
+#include "ufo/ObsOperatorParametersBase.h"
+#include "ufo/ObsTraits.h"
+#include "ufo/utils/CommunicationStatistics.h"
+
+#include "./JsonWriter.h"
+#include "./SyntheticObsData.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+/// \brief Options controlling the observer pipeline run on a single obs space.
+///
+/// The obs space is either read from a file (`obs space`) or generated in memory
+/// (`synthetic obs space`). In the latter case, its size is set either by `locations` (the total
+/// number of locations, for strong-scaling studies) or by `locations per task` (for weak-scaling
+/// studies).
+///
+/// Model equivalents are computed by the `obs operator` if it is set and otherwise taken from the
+/// `HofX` group of the obs space (synthetic obs spaces always have one).
+class ObsPipelineParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(ObsPipelineParameters, Parameters)
+
+ public:
+  oops::OptionalParameter<ioda::ObsTopLevelParameters> obsSpace{"obs space", this};
+  oops::OptionalParameter<SyntheticObsSpaceParameters> syntheticObsSpace{
+    "synthetic obs space", this};
+  oops::OptionalParameter<int> locations{"locations", this};
+  oops::OptionalParameter<int> locationsPerTask{"locations per task", this};
+
+  oops::ObsFiltersParameters<ObsTraits> filtersParams{this};
+  oops::OptionalParameter<ObsOperatorParametersWrapper> obsOperator{"obs operator", this};
+  oops::Parameter<ObsBiasParameters> obsBias{"obs bias", {}, this};
+  oops::Parameter<std::string> hofx{"HofX", "HofX", this};
+
+  /// GeoVaLs file used with obs spaces read from a file.
+  oops::Parameter<GeoVaLsParameters> geovals{"geovals", {}, this};
+  /// GeoVaLs profiles used with synthetic obs spaces.
+  oops::Parameter<std::vector<SyntheticGeoVaLParameters>> syntheticGeovals{
+    "synthetic geovals", {}, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Top-level options of ufo_scaling.x.
+class UfoScalingParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(UfoScalingParameters, Parameters)
+
+ public:
+  oops::RequiredParameter<util::DateTime> windowBegin{"window begin", this};
+  oops::RequiredParameter<util::DateTime> windowEnd{"window end", this};
+  oops::RequiredParameter<std::vector<ObsPipelineParameters>> observations{
+    "observations", this};
+  /// File to which the results are written (in JSON). If not set, they are only logged.
+  oops::OptionalParameter<std::string> outputFile{"output file", this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Measures the cost of each stage of the UFO observer pipeline on the MPI tasks of the
+/// run.
+///
+/// For each obs space, the stages (setup, GeoVaLs, preProcess, priorFilter, simulateObs and
+/// postFilter) are run once and the following quantities are reported:
+///
+/// - the wall-clock time (maximum over tasks);
+/// - the volume of observation data received in collective operations issued by UFO
+///   components (total over tasks, maximum per task and breakdown by component; see
+///   CommunicationStatistics);
+/// - the peak resident set size (maximum over tasks).
+///
+/// Components whose received volume per task does not decrease as tasks are added gather the
+/// whole obs space. Runs at several task counts are driven by `ufo_scaling.py` (tools/scaling.py).
+template <typename OBS> class UfoScaling : public oops::Application {
+  typedef oops::GeoVaLs<OBS>               GeoVaLs_;
+  typedef oops::Locations<OBS>             Locations_;
+  typedef oops::ObsAuxControl<OBS>         ObsAuxCtrl_;
+  typedef oops::ObsDataVector<OBS, float>  ObsDataVectorFloat_;
+  typedef oops::ObsDataVector<OBS, int>    ObsDataVectorInt_;
+  typedef oops::ObsDiagnostics<OBS>        ObsDiags_;
+  typedef oops::ObsFilters<OBS>            ObsFilters_;
+  typedef oops::ObsOperator<OBS>           ObsOperator_;
+  typedef oops::ObsSpace<OBS>              ObsSpace_;
+  typedef oops::ObsVector<OBS>             ObsVector_;
+
+  /// Cost of one stage of the pipeline.
+  struct StageStatistics {
+    std::string stage;
+    double seconds;
+    size_t bytesReceived;
+    size_t maxBytesReceivedPerTask;
+    size_t peakMemory;
+    std::map<std::string, size_t> bytesReceivedPerSite;
+  };
+
+  /// Costs of all stages of the pipeline run on one obs space.
+  struct PipelineStatistics {
+    std::string obsSpace;
+    size_t nlocs;
+    std::vector<StageStatistics> stages;
+  };
+
+ public:
+// -----------------------------------------------------------------------------
+  explicit UfoScaling(const eckit::mpi::Comm & comm = oops::mpi::world()) : Application(comm) {}
+// -----------------------------------------------------------------------------
+  virtual ~UfoScaling() {}
+// -----------------------------------------------------------------------------
+  int execute(const eckit::Configuration & fullConfig, bool validate) const {
+    UfoScalingParameters params;
+    if (validate) params.validate(fullConfig);
+    params.deserialize(fullConfig);
+
+    std::vector<PipelineStatistics> results;
+    for (const ObsPipelineParameters & pipeline : params.observations.value())
+      results.push_back(runPipeline(params, pipeline));
+
+    for (const PipelineStatistics & result : results)
+      for (const StageStatistics & s : result.stages)
+        oops::Log::info() << "ufo_scaling: " << result.obsSpace << " / " << s.stage
+                          << ": " << s.seconds << " s, " << s.bytesReceived
+                          << " bytes received (max " << s.maxBytesReceivedPerTask
+                          << " per task), peak memory " << s.peakMemory << " bytes"
+                          << std::endl;
+
+    if (params.outputFile.value() != boost::none && this->getComm().rank() == 0) {
+      std::ofstream os(*params.outputFile.value());
+      writeJson(results, os);
+    }
+
+    return 0;
+  }
+// -----------------------------------------------------------------------------
+ private:
+  std::string appname() const {
+    return "ufo::UfoScaling<" + OBS::name() + ">";
+  }
+// -----------------------------------------------------------------------------
+  /// Return the sorted union of the communication sites in \p bytesPerSite on all tasks.
+  std::vector<std::string> allSites(const std::map<std::string, size_t> & bytesPerSite) const {
+    const eckit::mpi::Comm & comm = this->getComm();
+    // Exchange the lengths and the concatenated characters of the site names.
+    std::vector<size_t> lengths;
+    std::vector<char> chars;
+    for (const auto & siteAndBytes : bytesPerSite) {
+      lengths.push_back(siteAndBytes.first.size());
+      chars.insert(chars.end(), siteAndBytes.first.begin(), siteAndBytes.first.end());
+    }
+    std::vector<std::vector<size_t>> sentLengths(comm.size(), lengths), receivedLengths;
+    std::vector<std::vector<char>> sentChars(comm.size(), chars), receivedChars;
+    comm.allToAll(sentLengths, receivedLengths);
+    comm.allToAll(sentChars, receivedChars);
+
+    std::set<std::string> sites;
+    for (size_t task = 0; task < receivedLengths.size(); ++task) {
+      size_t offset = 0;
+      for (size_t length : receivedLengths[task]) {
+        sites.emplace(receivedChars[task].data() + offset, length);
+        offset += length;
+      }
+    }
+    return std::vector<std::string>(sites.begin(), sites.end());
+  }
+// -----------------------------------------------------------------------------
+  /// Run \p f and return its cost.
+  template <typename F>
+  StageStatistics measure(const std::string & stage, const F & f) const {
+    const eckit::mpi::Comm & comm = this->getComm();
+    const std::map<std::string, size_t> bytesBefore = CommunicationStatistics::bytesPerSite();
+    comm.barrier();
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                   start).count();
+    comm.allReduceInPlace(seconds, eckit::mpi::max());
+
+    StageStatistics result{stage, seconds, 0, 0, 0, {}};
+    // Some tasks may not have reached all sites (e.g. if they hold no obs), so the byte counts
+    // are reduced over the union of the sites known to any task.
+    const std::map<std::string, size_t> bytesAfter = CommunicationStatistics::bytesPerSite();
+    const std::vector<std::string> sites = allSites(bytesAfter);
+    std::vector<size_t> bytes(sites.size(), 0);
+    size_t bytesOnThisTask = 0;
+    for (size_t i = 0; i < sites.size(); ++i) {
+      const auto after = bytesAfter.find(sites[i]);
+      if (after == bytesAfter.end())
+        continue;
+      const auto before = bytesBefore.find(sites[i]);
+      bytes[i] = after->second - (before == bytesBefore.end() ? 0 : before->second);
+      bytesOnThisTask += bytes[i];
+    }
+    comm.allReduceInPlace(bytes.begin(), bytes.end(), eckit::mpi::sum());
+    for (size_t i = 0; i < sites.size(); ++i) {
+      if (bytes[i] > 0) result.bytesReceivedPerSite[sites[i]] = bytes[i];
+      result.bytesReceived += bytes[i];
+    }
+    result.maxBytesReceivedPerTask = bytesOnThisTask;
+    comm.allReduceInPlace(result.maxBytesReceivedPerTask, eckit::mpi::max());
+    result.peakMemory = eckit::system::ResourceUsage().maxResidentSetSize();
+    comm.allReduceInPlace(result.peakMemory, eckit::mpi::max());
+    return result;
+  }
+// -----------------------------------------------------------------------------
+  PipelineStatistics runPipeline(const UfoScalingParameters & params,
+                                 const ObsPipelineParameters & pipeline) const {
+    const util::DateTime & bgn = params.windowBegin;
+    const util::DateTime & end = params.windowEnd;
+    const bool synthetic = pipeline.syntheticObsSpace.value() != boost::none;
+    if (synthetic == (pipeline.obsSpace.value() != boost::none))
+      throw eckit::UserError("Exactly one of 'obs space' and 'synthetic obs space' must be set",
+                             Here());
+
+    std::unique_ptr<ObsSpace_> obspace;
+    std::unique_ptr<ObsDataVectorFloat_> obserr;
+    std::shared_ptr<ObsDataVectorInt_> qcflags;
+    std::unique_ptr<ObsFilters_> filters;
+    std::unique_ptr<ObsOperator_> hop;
+    std::unique_ptr<ObsAuxCtrl_> ybias;
+
+    PipelineStatistics result;
+    result.stages.push_back(measure("setup", [&]() {
+      if (synthetic) {
+        const SyntheticObsSpaceParameters & synthParams = *pipeline.syntheticObsSpace.value();
+        const size_t nlocs = syntheticObsSpaceSize(pipeline);
+        obspace.reset(new ObsSpace_(syntheticObsSpaceParameters(synthParams, nlocs, bgn, end),
+                                    this->getComm(), bgn, end, oops::mpi::myself()));
+        fillSyntheticObsSpace(synthParams, obspace->obsspace());
+      } else {
+        obspace.reset(new ObsSpace_(*pipeline.obsSpace.value(), this->getComm(), bgn, end,
+                                    oops::mpi::myself()));
+      }
+      obserr.reset(new ObsDataVectorFloat_(*obspace, obspace->obsvariables(), "ObsError"));
+      qcflags.reset(new ObsDataVectorInt_(*obspace, obspace->obsvariables()));
+      filters.reset(new ObsFilters_(*obspace, pipeline.filtersParams, qcflags, *obserr));
+      if (pipeline.obsOperator.value() != boost::none)
+        hop.reset(new ObsOperator_(*obspace, *pipeline.obsOperator.value()));
+      ybias.reset(new ObsAuxCtrl_(*obspace, pipeline.obsBias));
+    }));
+    ioda::ObsSpace & ios = obspace->obsspace();
+    result.obsSpace = ios.obsname();
+    result.nlocs = ios.globalNumLocs();
+
+    oops::Variables geovars;
+    geovars += filters->requiredVars();
+    geovars += ybias->requiredVars();
+    if (hop) geovars += hop->requiredVars();
+    oops::Variables diagvars;
+    diagvars += filters->requiredHdiagnostics();
+    diagvars += ybias->requiredHdiagnostics();
+
+    const Locations_ locs(obsSpaceLocations(ios));
+    std::unique_ptr<GeoVaLs_> gval;
+    result.stages.push_back(measure("geovals", [&]() {
+      if (synthetic) {
+        gval.reset(new GeoVaLs_(locs, geovars, geovalLevels(pipeline.syntheticGeovals,
+                                                            geovars)));
+        fillSyntheticGeoVaLs(pipeline.syntheticGeovals, geovars, gval->geovals());
+      } else {
+        gval.reset(new GeoVaLs_(pipeline.geovals, *obspace, geovars));
+      }
+    }));
+
+    result.stages.push_back(measure("preProcess", [&]() { filters->preProcess(); }));
+    result.stages.push_back(measure("priorFilter", [&]() { filters->priorFilter(*gval); }));
+
+    ObsVector_ bias(*obspace);
+    bias.zero();
+    std::unique_ptr<ObsVector_> hofx;
+    std::unique_ptr<ObsDiags_> diags;
+    if (hop) {
+      hofx.reset(new ObsVector_(*obspace));
+      diags.reset(new ObsDiags_(*obspace, hop->locations(), diagvars));
+      result.stages.push_back(measure("simulateObs", [&]() {
+        hop->simulateObs(*gval, *hofx, *ybias, bias, *diags);
+      }));
+    } else {
+      if (diagvars.size() > 0)
+        throw eckit::UserError("Filters requiring obs diagnostics need an obs operator", Here());
+      hofx.reset(new ObsVector_(*obspace, pipeline.hofx));
+      diags.reset(new ObsDiags_(*obspace, locs, diagvars));
+    }
+
+    result.stages.push_back(measure("postFilter", [&]() {
+      filters->postFilter(*gval, *hofx, bias, *diags);
+    }));
+    return result;
+  }
+// -----------------------------------------------------------------------------
+  size_t syntheticObsSpaceSize(const ObsPipelineParameters & pipeline) const {
+    if (pipeline.locations.value() != boost::none)
+      return *pipeline.locations.value();
+    if (pipeline.locationsPerTask.value() != boost::none)
+      return *pipeline.locationsPerTask.value() * this->getComm().size();
+    throw eckit::UserError("Synthetic obs spaces require 'locations' or 'locations per task'",
+                           Here());
+  }
+// -----------------------------------------------------------------------------
+  void writeJson(const std::vector<PipelineStatistics> & results, std::ostream & os) const {
+    os << std::setprecision(9) << "{\n  \"tasks\": " << this->getComm().size()
+       << ",\n  \"observations\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+      const PipelineStatistics & result = results[i];
+      os << (i ? "," : "") << "\n    {\"obs space\": " << JsonString(result.obsSpace)
+         << ", \"nlocs\": " << result.nlocs << ", \"stages\": [";
+      for (size_t j = 0; j < result.stages.size(); ++j) {
+        const StageStatistics & s = result.stages[j];
+        os << (j ? "," : "") << "\n      {\"stage\": " << JsonString(s.stage)
+           << ", \"seconds\": " << s.seconds
+           << ", \"bytes received\": " << s.bytesReceived
+           << ", \"max bytes received per task\": " << s.maxBytesReceivedPerTask
+           << ", \"peak memory\": " << s.peakMemory << ", \"bytes received per site\": {";
+        size_t k = 0;
+        for (const auto & siteAndBytes : s.bytesReceivedPerSite)
+          os << (k++ ? ", " : "") << JsonString(siteAndBytes.first) << ": "
+             << siteAndBytes.second;
+        os << "}}";
+      }
+      os << "\n    ]}";
+    }
+    os << "\n  ]\n}\n";
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
+
+#endif  // MAINS_UFOSCALING_H_
@@ -0,0 +1,18 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "./UfoBench.h"
+#include "oops/runs/Run.h"
+#include "ufo/instantiateObsFilterFactory.h"
+#include "ufo/ObsTraits.h"
+
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  ufo::instantiateObsFilterFactory();
+  ufo::UfoBench<ufo::ObsTraits> bench;
+  return run.execute(bench);
+}
@@ -22,6 +22,7 @@
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.interface.h"
+#include "ufo/GeoVaLsIndexMap.h"
 #include "ufo/Locations.h"
 
 namespace ufo {
@@ -275,6 +276,61 @@ void GeoVaLs::merge(const GeoVaLs & other1, const GeoVaLs & other2) {
   return;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Weighted sums of locations of another GeoVaLs */
+void GeoVaLs::interpolateFrom(const GeoVaLs & other, const std::vector<int> & offsets,
+                              const std::vector<int> & sources,
+                              const std::vector<double> & weights) {
+  oops::Log::trace() << "GeoVaLs::interpolateFrom starting" << std::endl;
+  ASSERT(sources.size() == weights.size());
+  ASSERT(!offsets.empty() && offsets.back() == static_cast<int>(weights.size()));
+  const int nlocs = offsets.size() - 1;
+  const int nentries = weights.size();
+  ufo_geovals_interp_from_f90(keyGVL_, other.keyGVL_, nlocs, offsets[0], nentries,
+                              nentries > 0 ? sources[0] : 0, nentries > 0 ? weights[0] : 0.0);
+  oops::Log::trace() << "GeoVaLs::interpolateFrom done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Adjoint of interpolateFrom */
+void GeoVaLs::interpolateFromAD(GeoVaLs & other, size_t otherNlocs,
+                                const std::vector<int> & offsets,
+                                const std::vector<int> & sources,
+                                const std::vector<double> & weights) const {
+  oops::Log::trace() << "GeoVaLs::interpolateFromAD starting" << std::endl;
+  ASSERT(sources.size() == weights.size());
+  ASSERT(!offsets.empty() && offsets.back() == static_cast<int>(weights.size()));
+  const int otherNlocsInt = otherNlocs;
+  const int nlocs = offsets.size() - 1;
+  const int nentries = weights.size();
+  ufo_geovals_interp_from_ad_f90(keyGVL_, other.keyGVL_, otherNlocsInt, nlocs, offsets[0],
+                                 nentries, nentries > 0 ? sources[0] : 0,
+                                 nentries > 0 ? weights[0] : 0.0);
+  oops::Log::trace() << "GeoVaLs::interpolateFromAD done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Copy selected locations of \p other into this object */
+void GeoVaLs::gather(const GeoVaLs & other, const GeoVaLsIndexMap & map) {
+  oops::Log::trace() << "GeoVaLs::gather starting" << std::endl;
+  const int nlocs = map.targetExtent();
+  const int nruns = map.nruns();
+  ufo_geovals_gather_f90(keyGVL_, other.keyGVL_, nlocs, nruns,
+                         nruns > 0 ? map.targetStarts()[0] : 0,
+                         nruns > 0 ? map.sourceStarts()[0] : 0,
+                         nruns > 0 ? map.lengths()[0] : 0);
+  vars_ = other.vars_;
+  oops::Log::trace() << "GeoVaLs::gather done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Copy locations of this object into selected locations of \p other */
+void GeoVaLs::scatter(GeoVaLs & other, const GeoVaLsIndexMap & map) const {
+  oops::Log::trace() << "GeoVaLs::scatter starting" << std::endl;
+  const int nruns = map.nruns();
+  ufo_geovals_scatter_f90(keyGVL_, other.keyGVL_, nruns,
+                          nruns > 0 ? map.targetStarts()[0] : 0,
+                          nruns > 0 ? map.sourceStarts()[0] : 0,
+                          nruns > 0 ? map.lengths()[0] : 0);
+  oops::Log::trace() << "GeoVaLs::scatter done" << std::endl;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Output GeoVaLs to a stream */
 void GeoVaLs::print(std::ostream & os) const {
   int nn;
@@ -358,6 +414,59 @@ void GeoVaLs::getAtLevel(std::vector<int> & vals, const std::string & var, const
   oops::Log::trace() << "GeoVaLs::getAtLevel(int) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Return all values for a specific variable at all levels */
+void GeoVaLs::getAllLevels(std::vector<double> & vals, const std::string & var) const {
+  oops::Log::trace() << "GeoVaLs::getAllLevels(double) starting" << std::endl;
+  vals.resize(this->nlevs(var) * this->nlocs());
+  this->getAllLevels(gsl::make_span(vals), var, false);
+  oops::Log::trace() << "GeoVaLs::getAllLevels(double) done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Return all values for a specific variable at all levels and convert to float */
+void GeoVaLs::getAllLevels(std::vector<float> & vals, const std::string & var) const {
+  oops::Log::trace() << "GeoVaLs::getAllLevels(float) starting" << std::endl;
+  vals.resize(this->nlevs(var) * this->nlocs());
+  this->getAllLevels(gsl::make_span(vals), var, false);
+  oops::Log::trace() << "GeoVaLs::getAllLevels(float) done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Return all values for a specific variable at all levels */
+void GeoVaLs::getAllLevels(gsl::span<double> vals, const std::string & var,
+                           bool reverseLevels) const {
+  size_t nlocs;
+  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  const int nlevs = this->nlevs(var);
+  ASSERT(vals.size() == nlevs * nlocs);
+  if (!vals.empty())
+    ufo_geovals_getall_f90(keyGVL_, var.size(), var.c_str(), nlevs, nlocs, reverseLevels,
+                           vals[0]);
+}
+// -----------------------------------------------------------------------------
+/*! \brief Return all values for a specific variable at all levels and convert to float */
+void GeoVaLs::getAllLevels(gsl::span<float> vals, const std::string & var,
+                           bool reverseLevels) const {
+  size_t nlocs;
+  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  const int nlevs = this->nlevs(var);
+  ASSERT(vals.size() == nlevs * nlocs);
+  // The conversion to float (including that of missing values) is done on the Fortran side.
+  if (!vals.empty())
+    ufo_geovals_getall_float_f90(keyGVL_, var.size(), var.c_str(), nlevs, nlocs, reverseLevels,
+                                 vals[0]);
+}
+// -----------------------------------------------------------------------------
+/*! \brief Put values for a specific variable at all levels */
+void GeoVaLs::putAllLevels(const std::vector<double> & vals, const std::string & var) const {
+  oops::Log::trace() << "GeoVaLs::putAllLevels(double) starting" << std::endl;
+  size_t nlocs;
+  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  const int nlevs = this->nlevs(var);
+  ASSERT(vals.size() == nlevs * nlocs);
+  if (!vals.empty())
+    ufo_geovals_putall_f90(keyGVL_, var.size(), var.c_str(), nlevs, nlocs, vals[0]);
+  oops::Log::trace() << "GeoVaLs::putAllLevels(double) done" << std::endl;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Return all values for a specific 2D variable */
 void GeoVaLs::get(std::vector<double> & vals, const std::string & var) const {
   oops::Log::trace() << "GeoVaLs::get 2D starting" << std::endl;
@@ -486,6 +595,13 @@ void GeoVaLs::putAtLocation(const std::vector<int> & vals,
   oops::Log::trace() << "GeoVaLs::putAtLocation(int) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Free the memory holding the values of a specific variable */
+void GeoVaLs::release(const std::string & var) {
+  oops::Log::trace() << "GeoVaLs::release starting" << std::endl;
+  ufo_geovals_release_f90(keyGVL_, var.size(), var.c_str());
+  oops::Log::trace() << "GeoVaLs::release done" << std::endl;
+}
+// -----------------------------------------------------------------------------
 void GeoVaLs::fill(const std::vector<size_t> & indx,
                    const std::vector<double> & vals,
                    const bool levelsTopDown) {
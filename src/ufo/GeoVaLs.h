@@ -14,6 +14,8 @@
 #include <string>
 #include <vector>
 
+#include "gsl/gsl-lite.hpp"
+
 #include "oops/base/Variables.h"
 #include "oops/util/missingValues.h"
 #include "oops/util/ObjectCounter.h"
@@ -30,6 +32,7 @@ namespace ioda {
 }
 
 namespace ufo {
+  class GeoVaLsIndexMap;
   class Locations;
 
 /// \brief Parameters controlling GeoVaLs read/write
@@ -45,6 +48,10 @@ class GeoVaLsParameters : public oops::Parameters {
   /// a single location in the obs file. There needs to be at least
   /// loc_multiplier * obs_all_nlocs locations in the geovals file.
   oops::Parameter<int> loc_multiplier{"loc_multiplier", 1, this};
+  /// By default each MPI task reads only the parts of the file holding its own locations.
+  /// If true, the file is read on a single task, which sends each other task its locations;
+  /// this may be faster on file systems that handle many concurrent readers badly.
+  oops::Parameter<bool> single_reader{"single_reader", false, this};
 };
 
 // -----------------------------------------------------------------------------
@@ -58,7 +65,14 @@ class GeoVaLs : public util::Printable,
 
   static const std::string classname() {return "ufo::GeoVaLs";}
 
-  GeoVaLs(const Locations &, const oops::Variables &, const std::vector<size_t> &);
+  /// \brief Allocate GeoVaLs for variables \p vars at locations \p locs, with `nlevs[i]` levels
+  /// for variable `vars[i]`.
+  ///
+  /// Every level of every variable is stored for every location: operators and filters index
+  /// profiles from both ends (e.g. the level closest to the surface), so there is no support for
+  /// storing a subset of levels.
+  GeoVaLs(const Locations & locs, const oops::Variables & vars,
+          const std::vector<size_t> & nlevs);
 
 // Deprecated default constructor - Please do not use this constructor in new code.
   GeoVaLs(std::shared_ptr<const ioda::Distribution>, const oops::Variables &);
@@ -81,6 +95,28 @@ class GeoVaLs : public util::Printable,
   double dot_product_with(const GeoVaLs &) const;
   void split(GeoVaLs &, GeoVaLs &) const;
   void merge(const GeoVaLs &, const GeoVaLs &);
+  /// \brief Set each location `iloc` to the weighted sum of locations `sources[k]` of \p other
+  /// (with weights `weights[k]`), where `k` runs from `offsets[iloc]` to `offsets[iloc + 1] - 1`.
+  ///
+  /// Used to interpolate values from GeoVaLs at several copies of each location, e.g. one copy
+  /// per model state bracketing the observation time.
+  void interpolateFrom(const GeoVaLs & other, const std::vector<int> & offsets,
+                       const std::vector<int> & sources, const std::vector<double> & weights);
+  /// \brief Adjoint of interpolateFrom(): set \p other (resized to \p otherNlocs locations) to
+  /// the adjoint of the weighted sums given their adjoint stored in this object.
+  void interpolateFromAD(GeoVaLs & other, size_t otherNlocs, const std::vector<int> & offsets,
+                         const std::vector<int> & sources,
+                         const std::vector<double> & weights) const;
+  /// \brief Set this object to a copy of selected locations of \p other.
+  ///
+  /// On output this object holds the variables of \p other at `map.targetExtent()` locations;
+  /// each target location of \p map is a copy of the corresponding source location of \p other
+  /// and locations not covered by \p map are set to zero.
+  void gather(const GeoVaLs & other, const GeoVaLsIndexMap & map);
+  /// \brief Copy the source locations of \p map into the corresponding target locations of
+  /// \p other, which must already be allocated and hold all variables of this object (matched
+  /// by name) with the same numbers of levels. Other locations of \p other are left unchanged.
+  void scatter(GeoVaLs & other, const GeoVaLsIndexMap & map) const;
 
   /// \brief Deprecated method. Allocates GeoVaLs for \p vars variables with
   /// \p nlev number of levels
@@ -119,6 +155,20 @@ class GeoVaLs : public util::Printable,
   /// Get GeoVaLs at a specified level and convert to int
   void getAtLevel(std::vector<int> &, const std::string &, const int) const;
 
+  /// Get GeoVaLs for variable \p var at all levels and locations. On output the values at level
+  /// `lev` occupy elements `lev * nlocs()` to `(lev + 1) * nlocs() - 1` of \p vals, which is
+  /// resized as necessary.
+  void getAllLevels(std::vector<double> & vals, const std::string & var) const;
+  /// Get GeoVaLs for variable \p var at all levels and locations and convert to float
+  void getAllLevels(std::vector<float> & vals, const std::string & var) const;
+  /// Get GeoVaLs for variable \p var at all levels and locations into \p vals, which must have
+  /// `nlevs(var) * nlocs()` elements, laid out as on output from the other overloads. Levels are
+  /// stored in reverse order if \p reverseLevels is true.
+  void getAllLevels(gsl::span<double> vals, const std::string & var, bool reverseLevels) const;
+  /// Get GeoVaLs for variable \p var at all levels and locations into \p vals and convert to
+  /// float; see the overload taking a span of doubles.
+  void getAllLevels(gsl::span<float> vals, const std::string & var, bool reverseLevels) const;
+
   /// Get GeoVaLs at a specified location
   void getAtLocation(std::vector<double> &, const std::string &, const int) const;
   /// Get GeoVaLs at a specified location and convert to float
@@ -133,6 +183,10 @@ class GeoVaLs : public util::Printable,
   /// Put GeoVaLs for int variable \p var at level \p lev.
   void putAtLevel(const std::vector<int> & vals, const std::string & var, const int lev) const;
 
+  /// Put GeoVaLs for variable \p var at all levels and locations; \p vals is laid out as on output
+  /// from getAllLevels(). Fails if not all levels of \p var are stored.
+  void putAllLevels(const std::vector<double> & vals, const std::string & var) const;
+
   /// Put GeoVaLs for double variable \p var at location \p loc.
   void putAtLocation(const std::vector<double> & vals, const std::string & var,
                      const int loc) const;
@@ -141,6 +195,10 @@ class GeoVaLs : public util::Printable,
   /// Put GeoVaLs for int variable \p var at location \p loc.
   void putAtLocation(const std::vector<int> & vals, const std::string & var, const int loc) const;
 
+  /// Free the memory holding the values of variable \p var. The number of levels of \p var can
+  /// still be queried, but its values must not be accessed until it is allocated again.
+  void release(const std::string & var);
+
   void read(const Parameters_ &, const ioda::ObsSpace &);
   void write(const Parameters_ &) const;
   size_t nlocs() const;
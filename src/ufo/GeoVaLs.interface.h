@@ -73,6 +73,14 @@ extern "C" {
   void ufo_geovals_normalize_f90(const F90goms &, const F90goms &);
   void ufo_geovals_split_f90(const F90goms &, const F90goms &, const F90goms &);
   void ufo_geovals_merge_f90(const F90goms &, const F90goms &, const F90goms &);
+  void ufo_geovals_interp_from_f90(const F90goms &, const F90goms &, const int &, const int &,
+                                   const int &, const int &, const double &);
+  void ufo_geovals_interp_from_ad_f90(const F90goms &, const F90goms &, const int &, const int &,
+                                      const int &, const int &, const int &, const double &);
+  void ufo_geovals_gather_f90(const F90goms &, const F90goms &, const int &, const int &,
+                              const int &, const int &, const int &);
+  void ufo_geovals_scatter_f90(const F90goms &, const F90goms &, const int &, const int &,
+                               const int &, const int &);
   void ufo_geovals_minmaxavg_f90(const F90goms &, int &, int &, double &, double &, double &);
   void ufo_geovals_maxloc_f90(const F90goms &, double &, int &, int &);
   void ufo_geovals_nlocs_f90(const F90goms &, size_t &);
@@ -83,6 +91,13 @@ extern "C" {
                            const int &, float &);
   void ufo_geovals_get_loc_f90(const F90goms &, const int &, const char *, const int &,
                                const int &, double &);
+  void ufo_geovals_getall_f90(const F90goms &, const int &, const char *, const int &,
+                              const int &, const bool &, double &);
+  void ufo_geovals_getall_float_f90(const F90goms &, const int &, const char *, const int &,
+                                    const int &, const bool &, float &);
+  void ufo_geovals_putall_f90(const F90goms &, const int &, const char *, const int &,
+                              const int &, const double &);
+  void ufo_geovals_release_f90(const F90goms &, const int &, const char *);
   void ufo_geovals_getdouble_f90(const F90goms &, const int &, const char *, const int &,
                                  const int &, double &);
   void ufo_geovals_putdouble_f90(const F90goms &, const int &, const char *, const int &,
@@ -0,0 +1,54 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/GeoVaLsIndexMap.h"
+
+#include <algorithm>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+GeoVaLsIndexMap::GeoVaLsIndexMap(const std::vector<size_t> & sources) {
+  for (size_t i = 0; i < sources.size(); ++i)
+    addLocation(i, sources[i]);
+}
+
+// -----------------------------------------------------------------------------
+
+GeoVaLsIndexMap::GeoVaLsIndexMap(const std::vector<size_t> & targets,
+                                 const std::vector<size_t> & sources) {
+  if (targets.size() != sources.size())
+    throw eckit::BadParameter("GeoVaLsIndexMap: the numbers of target and source locations differ",
+                              Here());
+  for (size_t i = 0; i < sources.size(); ++i)
+    addLocation(targets[i], sources[i]);
+}
+
+// -----------------------------------------------------------------------------
+
+void GeoVaLsIndexMap::addLocation(size_t target, size_t source) {
+  ++size_;
+  targetExtent_ = std::max(targetExtent_, target + 1);
+  if (!lengths_.empty()) {
+    const int length = lengths_.back();
+    if (static_cast<size_t>(targetStarts_.back() + length) == target &&
+        static_cast<size_t>(sourceStarts_.back() + length) == source) {
+      ++lengths_.back();
+      return;
+    }
+  }
+  targetStarts_.push_back(target);
+  sourceStarts_.push_back(source);
+  lengths_.push_back(1);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
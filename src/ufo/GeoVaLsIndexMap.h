@@ -0,0 +1,54 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_GEOVALSINDEXMAP_H_
+#define UFO_GEOVALSINDEXMAP_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace ufo {
+
+/// \brief Maps locations of a target GeoVaLs object onto locations of a source GeoVaLs object.
+///
+/// The map is stored as a list of runs of consecutive target locations mapped onto consecutive
+/// source locations, which GeoVaLs::gather() and GeoVaLs::scatter() copy as single blocks.
+/// Build the map once and reuse it if the same locations are copied repeatedly.
+class GeoVaLsIndexMap {
+ public:
+  /// Map target location `i` onto source location `sources[i]` for each `i`.
+  explicit GeoVaLsIndexMap(const std::vector<size_t> & sources);
+  /// Map target location `targets[i]` onto source location `sources[i]` for each `i`.
+  GeoVaLsIndexMap(const std::vector<size_t> & targets, const std::vector<size_t> & sources);
+
+  /// Number of mapped locations.
+  size_t size() const {return size_;}
+  /// Number of runs of consecutive locations.
+  size_t nruns() const {return lengths_.size();}
+  /// Number of locations a GeoVaLs object must have to hold all mapped target locations.
+  size_t targetExtent() const {return targetExtent_;}
+
+  /// Index of the first target location of each run.
+  const std::vector<int> & targetStarts() const {return targetStarts_;}
+  /// Index of the first source location of each run.
+  const std::vector<int> & sourceStarts() const {return sourceStarts_;}
+  /// Number of locations in each run.
+  const std::vector<int> & lengths() const {return lengths_;}
+
+ private:
+  void addLocation(size_t target, size_t source);
+
+  size_t size_ = 0;
+  size_t targetExtent_ = 0;
+  std::vector<int> targetStarts_;
+  std::vector<int> sourceStarts_;
+  std::vector<int> lengths_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_GEOVALSINDEXMAP_H_
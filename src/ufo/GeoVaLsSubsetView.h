@@ -0,0 +1,60 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_GEOVALSSUBSETVIEW_H_
+#define UFO_GEOVALSSUBSETVIEW_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ufo/GeoVaLs.h"
+
+namespace ufo {
+
+/// \brief Read-only view of a subset of the locations of a GeoVaLs object.
+///
+/// Location `i` of the view is location `locations[i]` of the viewed GeoVaLs. Creating a view
+/// copies no values, so it is cheaper than GeoVaLs::gather() when the subset is read only a few
+/// times. Both the GeoVaLs and the vector of locations must outlive the view.
+class GeoVaLsSubsetView {
+ public:
+  GeoVaLsSubsetView(const GeoVaLs & geovals, const std::vector<size_t> & locations)
+    : geovals_(geovals), locations_(locations) {}
+
+  /// Number of locations in the subset.
+  size_t nlocs() const {return locations_.size();}
+  /// Index of location \p iloc of the subset in the viewed GeoVaLs.
+  size_t location(size_t iloc) const {return locations_[iloc];}
+
+  bool has(const std::string & var) const {return geovals_.has(var);}
+  size_t nlevs(const std::string & var) const {return geovals_.nlevs(var);}
+
+  /// Get GeoVaLs for variable \p var at location \p iloc of the subset.
+  template <typename T>
+  void getAtLocation(std::vector<T> & vals, const std::string & var, size_t iloc) const {
+    geovals_.getAtLocation(vals, var, locations_[iloc]);
+  }
+
+  /// Get GeoVaLs for variable \p var at level \p lev at all locations of the subset.
+  template <typename T>
+  void getAtLevel(std::vector<T> & vals, const std::string & var, int lev) const {
+    std::vector<T> allVals(geovals_.nlocs());
+    geovals_.getAtLevel(allVals, var, lev);
+    vals.resize(locations_.size());
+    for (size_t iloc = 0; iloc < locations_.size(); ++iloc)
+      vals[iloc] = allVals[locations_[iloc]];
+  }
+
+ private:
+  const GeoVaLs & geovals_;
+  const std::vector<size_t> & locations_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_GEOVALSSUBSETVIEW_H_
@@ -7,12 +7,18 @@
 
 #include "ufo/ObsDiagnostics.h"
 
+#include <map>
 #include <ostream>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "oops/base/Variables.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+#include "ufo/filters/Variable.h"
 #include "ufo/Locations.h"
+#include "ufo/ObsDiagnosticsStorageParameters.h"
 
 #include "ioda/ObsSpace.h"
 
@@ -20,21 +26,40 @@ namespace ufo {
 
 // -----------------------------------------------------------------------------
 
+ObsDiagnosticsConsumer::ObsDiagnosticsConsumer(const oops::Variables & vars)
+  : allVariables_(false)
+{
+  for (size_t jv = 0; jv < vars.size(); ++jv)
+    vars_.insert(vars[jv]);
+}
+
+// -----------------------------------------------------------------------------
+
+ObsDiagnosticsConsumer::ObsDiagnosticsConsumer()
+  : allVariables_(true)
+{}
+
+// -----------------------------------------------------------------------------
+
 ObsDiagnostics::ObsDiagnostics(const ioda::ObsSpace & os, const Locations & locs,
                                const oops::Variables & vars)
-  : obsdb_(os), gdiags_(locs, vars)
+  : obsdb_(os), gdiags_(locs, vars), nlocs_(gdiags_.nlocs())
 {}
 
 // -----------------------------------------------------------------------------
 
 ObsDiagnostics::ObsDiagnostics(const Parameters_ & params, const ioda::ObsSpace & os,
                                const oops::Variables & vars)
-  : obsdb_(os), gdiags_(params, os, vars)
+  : obsdb_(os), gdiags_(params, os, vars), nlocs_(gdiags_.nlocs())
 {}
 
 // -----------------------------------------------------------------------------
 
 void ObsDiagnostics::allocate(const int nlev, const oops::Variables & vars) {
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    compact_.erase(vars[jv]);
+    released_.erase(vars[jv]);
+  }
   gdiags_.allocate(nlev, vars);
 }
 
@@ -43,17 +68,166 @@ void ObsDiagnostics::allocate(const int nlev, const oops::Variables & vars) {
 void ObsDiagnostics::save(const std::vector<double> & vals,
                           const std::string & var,
                           const int lev) {
+  if (compact_.count(var) || released_.count(var))
+    throw eckit::UserError("ObsDiagnostics::save: diagnostic " + var +
+                           " has been compacted or released", Here());
   gdiags_.putAtLevel(vals, var, lev);
 }
 
 // -----------------------------------------------------------------------------
 
+std::unique_ptr<ObsDiagnostics> ObsDiagnostics::emptyCopy() const {
+  // GeoVaLs only use the number of locations and their distribution.
+  const Locations locs(std::vector<float>(nlocs_, 0.0f), std::vector<float>(nlocs_, 0.0f),
+                       std::vector<util::DateTime>(nlocs_), obsdb_.distribution());
+  return std::unique_ptr<ObsDiagnostics>(new ObsDiagnostics(obsdb_, locs, gdiags_.getVars()));
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnostics::copyAllocated(const ObsDiagnostics & other) {
+  ASSERT(other.nlocs_ == nlocs_);
+  const oops::Variables & vars = other.gdiags_.getVars();
+  std::vector<double> vals;
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    const std::string & var = vars[jv];
+    if (!other.has(var) || other.compact_.count(var)) continue;
+    const size_t nlev = other.gdiags_.nlevs(var);
+    if (nlev == 0) continue;
+    if (gdiags_.nlevs(var) != 0)
+      throw eckit::UserError("ObsDiagnostics::copyAllocated: diagnostic " + var +
+                             " has already been allocated", Here());
+    allocate(nlev, oops::Variables(std::vector<std::string>{var}));
+    for (size_t jlev = 0; jlev < nlev; ++jlev) {
+      other.gdiags_.getAtLevel(vals, var, jlev);
+      save(vals, var, jlev);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnostics::compact(const ObsDiagnosticsStorageParameters & params) {
+  for (const Variable & variable : params.variables.value()) {
+    for (size_t jch = 0; jch < variable.size(); ++jch) {
+      const std::string var = variable.variable(jch);
+      if (!has(var) || compact_.count(var)) continue;
+
+      CompactDiagnostic diag;
+      diag.nlevs = gdiags_.nlevs(var);
+      if (diag.nlevs == 0) continue;
+      const int minLevel = params.minLevel.value().value_or(0);
+      const int maxLevel = params.maxLevel.value().value_or(static_cast<int>(diag.nlevs) - 1);
+      if (minLevel < 0 || minLevel > maxLevel)
+        throw eckit::BadParameter("ObsDiagnostics::compact: invalid level range for " + var,
+                                  Here());
+      diag.minLevel = minLevel;
+      diag.maxLevel = std::min<size_t>(maxLevel, diag.nlevs - 1);
+
+      // GeoVaLs::getAllLevels() converts missing values to the float missing value.
+      std::vector<float> allLevels;
+      gdiags_.getAllLevels(allLevels, var);
+      if (diag.minLevel <= diag.maxLevel)
+        diag.values.assign(allLevels.begin() + diag.minLevel * nlocs_,
+                           allLevels.begin() + (diag.maxLevel + 1) * nlocs_);
+      diag.values.shrink_to_fit();
+
+      gdiags_.release(var);
+      compact_[var] = std::move(diag);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnostics::release(const oops::Variables & vars) {
+  releaseStorage(vars);
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnostics::releaseStorage(const oops::Variables & vars) const {
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    const std::string & var = vars[jv];
+    if (!has(var)) continue;
+    if (compact_.erase(var) == 0)
+      gdiags_.release(var);
+    released_.insert(var);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnostics::addConsumer(const ObsDiagnosticsConsumer & consumer) {
+  std::lock_guard<std::mutex> lock(consumersMutex_);
+  pendingConsumers_[&consumer] = PendingConsumer{consumer.allVariables(), consumer.variables()};
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnostics::finishedWith(const ObsDiagnosticsConsumer & consumer) const {
+  std::lock_guard<std::mutex> lock(consumersMutex_);
+  auto finished = pendingConsumers_.find(&consumer);
+  if (finished == pendingConsumers_.end()) return;
+  const PendingConsumer finishedConsumer = std::move(finished->second);
+  pendingConsumers_.erase(finished);
+
+  // Variables still needed by other consumers.
+  std::set<std::string> stillNeeded;
+  for (const auto & pending : pendingConsumers_) {
+    if (pending.second.allVariables) return;
+    stillNeeded.insert(pending.second.vars.begin(), pending.second.vars.end());
+  }
+
+  // A consumer of all variables (such as ObsDiagnosticsWriter) may be the last to read any of them.
+  std::set<std::string> candidates = finishedConsumer.vars;
+  if (finishedConsumer.allVariables) {
+    const oops::Variables & allVars = gdiags_.getVars();
+    for (size_t jv = 0; jv < allVars.size(); ++jv)
+      candidates.insert(allVars[jv]);
+  }
+
+  oops::Variables toRelease;
+  for (const std::string & var : candidates)
+    if (stillNeeded.count(var) == 0)
+      toRelease.push_back(var);
+  releaseStorage(toRelease);
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnostics::checkNotReleased(const std::string & var) const {
+  if (released_.count(var))
+    throw eckit::UserError("ObsDiagnostics: diagnostic " + var + " has been released", Here());
+}
+
+// -----------------------------------------------------------------------------
+
+bool ObsDiagnostics::has(const std::string & var) const {
+  return gdiags_.has(var) && released_.count(var) == 0;
+}
+
+// -----------------------------------------------------------------------------
+
 size_t ObsDiagnostics::nlevs(const std::string & var) const {
+  checkNotReleased(var);
+  auto it = compact_.find(var);
+  if (it != compact_.end())
+    return it->second.nlevs;
   return gdiags_.nlevs(var);
 }
 
 // -----------------------------------------------------------------------------
 
+void ObsDiagnostics::write(const Parameters_ & params) const {
+  if (!compact_.empty() || !released_.empty())
+    oops::Log::warning() << "ObsDiagnostics::write: diagnostics held in single precision or "
+                         << "released will not be written" << std::endl;
+  gdiags_.write(params);
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsDiagnostics::print(std::ostream & os) const {
   os << "ObsDiagnostics not printing yet.";
 }
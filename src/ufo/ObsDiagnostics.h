@@ -8,12 +8,20 @@
 #ifndef UFO_OBSDIAGNOSTICS_H_
 #define UFO_OBSDIAGNOSTICS_H_
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <set>
 #include <string>
 #include <vector>
 
 #include <boost/noncopyable.hpp>
 
+#include "eckit/exception/Exceptions.h"
+#include "gsl/gsl-lite.hpp"
+#include "oops/util/missingValues.h"
 #include "oops/util/Printable.h"
 #include "ufo/GeoVaLs.h"
 
@@ -28,6 +36,29 @@ namespace ioda {
 
 namespace ufo {
   class Locations;
+  class ObsDiagnosticsStorageParameters;
+
+// -----------------------------------------------------------------------------
+
+/// \brief Identifies an object (typically a filter) reading some or all of the diagnostics
+/// computed by an observation operator.
+///
+/// Consumers registered with ObsDiagnostics::addConsumer() let each diagnostic be freed once all
+/// consumers reading it have called ObsDiagnostics::finishedWith().
+class ObsDiagnosticsConsumer : private boost::noncopyable {
+ public:
+  /// Consumer of the diagnostics \p vars.
+  explicit ObsDiagnosticsConsumer(const oops::Variables & vars);
+  /// Consumer of all diagnostics.
+  ObsDiagnosticsConsumer();
+
+  bool allVariables() const {return allVariables_;}
+  const std::set<std::string> & variables() const {return vars_;}
+
+ private:
+  bool allVariables_;
+  std::set<std::string> vars_;
+};
 
 // -----------------------------------------------------------------------------
 
@@ -51,28 +82,145 @@ class ObsDiagnostics : public util::Printable,
 
   void save(const std::vector<double> &, const std::string &, const int);
 
+  /// \brief Create an object holding the same variables at the same locations, with nothing
+  /// allocated.
+  /// \details Used to give observation operators running concurrently separate diagnostics,
+  ///          which are then gathered with copyAllocated().
+  std::unique_ptr<ObsDiagnostics> emptyCopy() const;
+
+  /// \brief Copy each diagnostic allocated in \p other to this object.
+  /// \details Fails if one of these diagnostics is already allocated in this object.
+  void copyAllocated(const ObsDiagnostics & other);
+
+  /// \brief Move the diagnostics selected by \p params to single-precision storage, keeping only
+  /// the requested range of levels.
+  /// \details Called once the diagnostics have been filled; they can't be saved again afterwards
+  ///          (unless they are reallocated). Variables that haven't been requested are ignored.
+  void compact(const ObsDiagnosticsStorageParameters & params);
+
+  /// \brief Free the memory used by diagnostics \p vars.
+  /// \details Afterwards has() returns false for these variables and get() throws an exception.
+  void release(const oops::Variables & vars);
+
+  /// \brief Register \p consumer as a reader of these diagnostics.
+  /// \details Each diagnostic read by at least one registered consumer is freed as soon as all
+  ///          consumers reading it have called finishedWith(). Diagnostics without any registered
+  ///          consumer are kept. Consumers must be registered once the diagnostics have been
+  ///          filled and must outlive their call to finishedWith().
+  void addConsumer(const ObsDiagnosticsConsumer & consumer);
+
+  /// \brief Record that \p consumer won't read these diagnostics any more.
+  /// \details Does nothing if \p consumer hasn't been registered with addConsumer(). Filters
+  ///          only have const access to the diagnostics, so the storage freed by this function
+  ///          is held in mutable members.
+  void finishedWith(const ObsDiagnosticsConsumer & consumer) const;
+
 // Interfaces
   int & toFortran() {return gdiags_.toFortran();}
   const int & toFortran() const {return gdiags_.toFortran();}
 
-  bool has(const std::string & var) const {return gdiags_.has(var);}
+  bool has(const std::string & var) const;
   size_t nlevs(const std::string &) const;
   template <typename T>
   void get(std::vector<T> & vals, const std::string & var, const int lev) const {
-    gdiags_.getAtLevel(vals, var, lev);
+    checkNotReleased(var);
+    auto it = compact_.find(var);
+    if (it == compact_.end())
+      gdiags_.getAtLevel(vals, var, lev);
+    else
+      getCompact(it->second, lev, vals);
   }
   template <typename T>
   void get(std::vector<T> & vals, const std::string & var) const {
-    gdiags_.get(vals, var);
+    checkNotReleased(var);
+    auto it = compact_.find(var);
+    if (it == compact_.end())
+      gdiags_.get(vals, var);
+    else
+      getCompact(it->second, 0, vals);
+  }
+  /// Get \p var at all levels; see GeoVaLs::getAllLevels() for the layout of \p vals.
+  template <typename T>
+  void getAllLevels(std::vector<T> & vals, const std::string & var) const {
+    vals.resize(nlevs(var) * nlocs_);
+    getAllLevels(gsl::make_span(vals), var, false);
   }
+  /// Get \p var at all levels into \p vals, which must have `nlevs(var) * nlocs` elements; see
+  /// GeoVaLs::getAllLevels() for the layout of \p vals and the meaning of \p reverseLevels.
+  template <typename T>
+  void getAllLevels(gsl::span<T> vals, const std::string & var, bool reverseLevels) const {
+    checkNotReleased(var);
+    auto it = compact_.find(var);
+    if (it == compact_.end()) {
+      gdiags_.getAllLevels(vals, var, reverseLevels);
+    } else {
+      const CompactDiagnostic & diag = it->second;
+      ASSERT(vals.size() == diag.nlevs * nlocs_);
+      for (size_t lev = 0; lev < diag.nlevs; ++lev) {
+        const size_t outLev = reverseLevels ? diag.nlevs - 1 - lev : lev;
+        getCompact(diag, lev, vals.data() + outLev * nlocs_);
+      }
+    }
+  }
+
+  /// Diagnostics moved to compact storage or released are not written.
+  void write(const Parameters_ & params) const;
 
-  void write(const Parameters_ & params) const {
-    gdiags_.write(params);}
  private:
   void print(std::ostream &) const;
+  /// Single-precision copy of a diagnostic whose Fortran storage has been released.
+  struct CompactDiagnostic {
+    size_t nlevs;      ///< number of levels of the diagnostic
+    size_t minLevel;   ///< index of the first level held in `values`
+    size_t maxLevel;   ///< index of the last level held in `values`
+    /// Values at levels minLevel to maxLevel; the values at each level are contiguous.
+    std::vector<float> values;
+  };
+
+  /// Throw an exception if \p var has been released.
+  void checkNotReleased(const std::string & var) const;
+  /// Implementation of release(), also used by finishedWith().
+  void releaseStorage(const oops::Variables & vars) const;
+
+  template <typename T>
+  void getCompact(const CompactDiagnostic & diag, const int lev, std::vector<T> & vals) const {
+    vals.resize(nlocs_);
+    getCompact(diag, lev, vals.data());
+  }
+
+  /// Write the values of \p diag at level \p lev to the nlocs_ elements starting at \p vals.
+  template <typename T>
+  void getCompact(const CompactDiagnostic & diag, const int lev, T * vals) const {
+    ASSERT(lev >= 0 && static_cast<size_t>(lev) < diag.nlevs);
+    const T missingT = util::missingValue(missingT);
+    if (static_cast<size_t>(lev) < diag.minLevel || static_cast<size_t>(lev) > diag.maxLevel) {
+      std::fill(vals, vals + nlocs_, missingT);
+      return;
+    }
+    const float missingFloat = util::missingValue(missingFloat);
+    const float *levelVals = diag.values.data() + (lev - diag.minLevel) * nlocs_;
+    for (size_t jloc = 0; jloc < nlocs_; ++jloc)
+      vals[jloc] = levelVals[jloc] == missingFloat ? missingT : static_cast<T>(levelVals[jloc]);
+  }
+
   const ioda::ObsSpace & obsdb_;
 
-  GeoVaLs gdiags_;
+  // The storage below can be freed by finishedWith().
+  mutable GeoVaLs gdiags_;
+  size_t nlocs_;
+  mutable std::map<std::string, CompactDiagnostic> compact_;
+  mutable std::set<std::string> released_;
+
+  /// Copy of the variables read by a consumer (which may be destroyed after finishing with
+  /// the diagnostics).
+  struct PendingConsumer {
+    bool allVariables;
+    std::set<std::string> vars;
+  };
+  /// Registered consumers that haven't called finishedWith() yet.
+  mutable std::map<const ObsDiagnosticsConsumer *, PendingConsumer> pendingConsumers_;
+  /// Serialises calls to finishedWith() made by filters running concurrently.
+  mutable std::mutex consumersMutex_;
 };
 
 // -----------------------------------------------------------------------------
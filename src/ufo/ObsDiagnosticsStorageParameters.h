@@ -0,0 +1,58 @@
+/*
+ * (C) Crown Copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OBSDIAGNOSTICSSTORAGEPARAMETERS_H_
+#define UFO_OBSDIAGNOSTICSSTORAGEPARAMETERS_H_
+
+#include <vector>
+
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+#include "ufo/filters/Variable.h"
+#include "ufo/utils/parameters/ParameterTraitsVariable.h"
+
+namespace ufo {
+
+/// \brief Options controlling how a group of diagnostics computed by an observation operator is
+/// stored until the filters have used it.
+///
+/// Diagnostics listed in `variables` are converted to single precision as soon as the observation
+/// operator (and bias correction) has filled them. If `min level` and/or `max level` are set,
+/// only the levels in that range are kept; values at the other levels are returned as missing.
+/// Level indices start from 0, as in ObsFilterData::get().
+///
+/// Example:
+///
+///     obs operator:
+///       name: CRTM
+///       ...
+///       diagnostics storage:
+///       - variables:
+///         - name: brightness_temperature_jacobian_air_temperature@ObsDiag
+///           channels: 16-29
+///         min level: 20
+///         max level: 70
+class ObsDiagnosticsStorageParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(ObsDiagnosticsStorageParameters, Parameters)
+
+ public:
+  /// Diagnostics to which these options apply. Diagnostics that haven't been requested by any
+  /// filter are ignored.
+  oops::RequiredParameter<std::vector<Variable>> variables{"variables", this};
+
+  /// Index of the lowest level to keep.
+  oops::OptionalParameter<int> minLevel{"min level", this};
+
+  /// Index of the highest level to keep.
+  oops::OptionalParameter<int> maxLevel{"max level", this};
+};
+
+}  // namespace ufo
+
+#endif  // UFO_OBSDIAGNOSTICSSTORAGEPARAMETERS_H_
@@ -25,7 +25,8 @@ namespace ufo {
 // -----------------------------------------------------------------------------
 
 ObsOperator::ObsOperator(ioda::ObsSpace & os, const Parameters_ & params)
-  : oper_(ObsOperatorFactory::create(os, params.operatorParameters)), odb_(os)
+  : oper_(ObsOperatorFactory::create(os, params.operatorParameters)), odb_(os),
+    diagnosticsStorage_(params.operatorParameters.value().diagnosticsStorage)
 {
   // We use += rather than = to make sure the Variables objects contain no duplicate entries.
   oops::Variables operatorVars;
@@ -52,6 +53,8 @@ void ObsOperator::simulateObs(const GeoVaLs & gvals, ioda::ObsVector & yy,
     // update H(x) with bias correction
     yy += ybias;
   }
+  for (const ObsDiagnosticsStorageParameters & storage : diagnosticsStorage_)
+    ydiags.compact(storage);
 }
 
 // -----------------------------------------------------------------------------
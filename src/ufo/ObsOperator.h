@@ -10,11 +10,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 
 #include "oops/util/Printable.h"
 
+#include "ufo/ObsDiagnosticsStorageParameters.h"
 #include "ufo/ObsOperatorBase.h"
 
 // Forward declarations
@@ -56,6 +58,7 @@ class ObsOperator : public util::Printable,
   void print(std::ostream &) const;
   std::unique_ptr<ObsOperatorBase> oper_;
   ioda::ObsSpace & odb_;
+  std::vector<ObsDiagnosticsStorageParameters> diagnosticsStorage_;
 };
 
 // -----------------------------------------------------------------------------
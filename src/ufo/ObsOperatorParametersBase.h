@@ -9,11 +9,14 @@
 #define UFO_OBSOPERATORPARAMETERSBASE_H_
 
 #include <string>
+#include <vector>
 
 #include "oops/util/parameters/OptionalParameter.h"
 #include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/Parameters.h"
 
+#include "ufo/ObsDiagnosticsStorageParameters.h"
+
 namespace ioda {
   class ObsVector;
 }
@@ -39,6 +42,11 @@ class ObsOperatorParametersBase : public oops::Parameters {
 
   /// \brief Parameter specifying path to yaml file containing Observation to GeoVaL name mapping
   oops::OptionalParameter<std::string> AliasFile{"observation alias file", this};
+
+  /// \brief Options controlling the storage of diagnostics computed by the operator; see
+  /// ObsDiagnosticsStorageParameters. Used only by nonlinear operators.
+  oops::Parameter<std::vector<ObsDiagnosticsStorageParameters>> diagnosticsStorage{
+    "diagnostics storage", {}, this};
 };
 
 // -----------------------------------------------------------------------------
@@ -19,6 +19,7 @@
 #include "oops/util/Logger.h"
 
 #include "ufo/filters/actions/FilterAction.h"
+#include "ufo/filters/FlagMatrix.h"
 #include "ufo/filters/GenericFilterParameters.h"
 #include "ufo/filters/processWhere.h"
 #include "ufo/GeoVaLs.h"
@@ -121,10 +122,13 @@ void FilterBase::doFilter() const {
 // Apply filter
   this->applyFilter(apply, vars, flagged);
 
-// Take actions
+// Take actions. Converting the flags to a FlagMatrix scans them once and lets each action visit
+// only the flagged locations; a single action is cheaper to run on the dense flags directly.
+  const FlagMatrix flaggedMatrix = actionsParameters_.size() > 1 ?
+        FlagMatrix(flagged) : FlagMatrix::viewOf(flagged);
   for (const std::unique_ptr<FilterActionParametersBase> &actionParameters : actionsParameters_) {
     FilterAction action(*actionParameters);
-    action.apply(vars, flagged, data_, this->qcFlag(), *flags_, *obserr_);
+    action.apply(vars, flaggedMatrix, data_, this->qcFlag(), *flags_, *obserr_);
   }
 
 // Done
@@ -0,0 +1,127 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/FlagMatrix.h"
+
+#include <algorithm>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+FlagMatrix::FlagMatrix(size_t nvars, size_t nlocs)
+  : nlocs_(nlocs), rows_(nvars)
+{}
+
+// -----------------------------------------------------------------------------
+
+FlagMatrix::FlagMatrix(const std::vector<std::vector<bool>> & flagged)
+  : nlocs_(flagged.empty() ? 0 : flagged.front().size()), rows_(flagged.size())
+{
+  for (size_t ivar = 0; ivar < flagged.size(); ++ivar) {
+    const std::vector<bool> & flags = flagged[ivar];
+    ASSERT(flags.size() == nlocs_);
+    Row & row = rows_[ivar];
+    // Single pass: collect indices until the row turns out to be dense, then switch to a bitset.
+    size_t iloc = 0;
+    for (; iloc < nlocs_ && row.sparse; ++iloc) {
+      if (flags[iloc]) {
+        row.indices.push_back(iloc);
+        if (isDense(++row.count))
+          makeDense(row);
+      }
+    }
+    for (; iloc < nlocs_; ++iloc) {
+      if (flags[iloc]) {
+        row.words[iloc / bitsPerWord] |= uint64_t(1) << (iloc % bitsPerWord);
+        ++row.count;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+FlagMatrix FlagMatrix::viewOf(const std::vector<std::vector<bool>> & flagged) {
+  FlagMatrix matrix(0, flagged.empty() ? 0 : flagged.front().size());
+  for (const std::vector<bool> & flags : flagged)
+    ASSERT(flags.size() == matrix.nlocs_);
+  matrix.view_ = &flagged;
+  return matrix;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t FlagMatrix::count(size_t ivar) const {
+  if (view_ != nullptr) {
+    const std::vector<bool> & flags = (*view_)[ivar];
+    return std::count(flags.begin(), flags.end(), true);
+  }
+  return rows_[ivar].count;
+}
+
+// -----------------------------------------------------------------------------
+
+bool FlagMatrix::any(size_t ivar) const {
+  if (view_ != nullptr) {
+    const std::vector<bool> & flags = (*view_)[ivar];
+    return std::find(flags.begin(), flags.end(), true) != flags.end();
+  }
+  return rows_[ivar].count != 0;
+}
+
+// -----------------------------------------------------------------------------
+
+bool FlagMatrix::operator()(size_t ivar, size_t iloc) const {
+  if (view_ != nullptr)
+    return (*view_)[ivar][iloc];
+  const Row & row = rows_[ivar];
+  if (row.sparse)
+    return std::binary_search(row.indices.begin(), row.indices.end(), iloc);
+  return (row.words[iloc / bitsPerWord] >> (iloc % bitsPerWord)) & 1;
+}
+
+// -----------------------------------------------------------------------------
+
+void FlagMatrix::set(size_t ivar, size_t iloc) {
+  ASSERT(view_ == nullptr);
+  ASSERT(iloc < nlocs_);
+  Row & row = rows_[ivar];
+  if (row.sparse) {
+    auto it = std::lower_bound(row.indices.begin(), row.indices.end(), iloc);
+    if (it != row.indices.end() && *it == iloc)
+      return;
+    row.indices.insert(it, iloc);
+    ++row.count;
+    if (isDense(row.count))
+      makeDense(row);
+  } else {
+    uint64_t & word = row.words[iloc / bitsPerWord];
+    const uint64_t bit = uint64_t(1) << (iloc % bitsPerWord);
+    if (!(word & bit)) {
+      word |= bit;
+      ++row.count;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void FlagMatrix::makeDense(Row & row) const {
+  row.words.assign((nlocs_ + bitsPerWord - 1) / bitsPerWord, 0);
+  for (size_t iloc : row.indices)
+    row.words[iloc / bitsPerWord] |= uint64_t(1) << (iloc % bitsPerWord);
+  row.indices.clear();
+  row.indices.shrink_to_fit();
+  row.sparse = false;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
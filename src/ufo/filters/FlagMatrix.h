@@ -0,0 +1,121 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_FLAGMATRIX_H_
+#define UFO_FILTERS_FLAGMATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ufo {
+
+/// \brief Locations flagged by a filter, for each filter variable.
+///
+/// Each row (filter variable) is stored either as a word-packed bitset or, if only a small
+/// fraction of locations is flagged, as a sorted list of flagged locations. Code using a
+/// FlagMatrix should visit the flagged locations with forEachFlagged(), whose cost is
+/// proportional to the number of flagged locations (plus nlocs() / 64 word tests for dense rows)
+/// rather than to nlocs().
+///
+/// Filters produce their output as a std::vector<std::vector<bool>>. Converting it to a FlagMatrix
+/// takes one pass over these dense flags, which pays off only if several actions visit the flagged
+/// locations. A FlagMatrix created by viewOf() refers to the dense flags instead; its
+/// forEachFlagged() and count() scan all locations of a row.
+class FlagMatrix {
+ public:
+  /// Create a matrix with \p nvars rows and \p nlocs columns, with no locations flagged.
+  FlagMatrix(size_t nvars, size_t nlocs);
+
+  /// Create a matrix holding the same flags as \p flagged, which must contain vectors of equal
+  /// length.
+  explicit FlagMatrix(const std::vector<std::vector<bool>> & flagged);
+
+  /// Create a matrix referring to the flags held in \p flagged, which must contain vectors of
+  /// equal length and outlive the matrix. set() may not be called on this matrix.
+  static FlagMatrix viewOf(const std::vector<std::vector<bool>> & flagged);
+
+  size_t nvars() const { return view_ != nullptr ? view_->size() : rows_.size(); }
+  size_t nlocs() const { return nlocs_; }
+
+  /// Return true if location \p iloc is flagged for variable \p ivar.
+  bool operator()(size_t ivar, size_t iloc) const;
+
+  /// Flag location \p iloc for variable \p ivar.
+  void set(size_t ivar, size_t iloc);
+
+  /// Number of locations flagged for variable \p ivar.
+  size_t count(size_t ivar) const;
+
+  /// Return true if at least one location is flagged for variable \p ivar.
+  bool any(size_t ivar) const;
+
+  /// Call \p f(iloc) for each location \p iloc flagged for variable \p ivar, in increasing order.
+  template <typename F>
+  void forEachFlagged(size_t ivar, F f) const {
+    if (view_ != nullptr) {
+      const std::vector<bool> & flags = (*view_)[ivar];
+      for (size_t iloc = 0; iloc < nlocs_; ++iloc)
+        if (flags[iloc])
+          f(iloc);
+      return;
+    }
+    const Row & row = rows_[ivar];
+    if (row.sparse) {
+      for (size_t iloc : row.indices)
+        f(iloc);
+    } else {
+      for (size_t iword = 0; iword < row.words.size(); ++iword) {
+        uint64_t word = row.words[iword];
+        while (word != 0) {
+          f(iword * bitsPerWord + countTrailingZeros(word));
+          word &= word - 1;
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t bitsPerWord = 64;
+
+  /// Return the index of the lowest set bit of \p word, which must be nonzero.
+  /// \details Uses a de Bruijn sequence rather than compiler builtins, which not all supported
+  ///          compilers provide.
+  static size_t countTrailingZeros(uint64_t word) {
+    static const unsigned char bitIndex[64] = {
+       0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+      62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+      63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+      46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6};
+    return bitIndex[((word & (~word + 1)) * UINT64_C(0x03f79d71b4cb0a89)) >> 58];
+  }
+
+  struct Row {
+    bool sparse = true;
+    size_t count = 0;
+    /// Flagged locations (sorted); used if `sparse` is true.
+    std::vector<size_t> indices;
+    /// One bit per location; used if `sparse` is false.
+    std::vector<uint64_t> words;
+  };
+
+  /// Return true if a row with \p count flagged locations should be stored as a bitset.
+  bool isDense(size_t count) const {
+    return count * sizeof(size_t) * 8 > nlocs_;
+  }
+  /// Convert \p row from a sorted index list to a bitset.
+  void makeDense(Row & row) const;
+
+  size_t nlocs_;
+  std::vector<Row> rows_;
+  /// Flags referred to by a matrix created by viewOf(); null otherwise (rows_ is then used).
+  const std::vector<std::vector<bool>> * view_ = nullptr;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_FLAGMATRIX_H_
@@ -64,7 +64,8 @@ void Gaussian_Thinning::applyFilter(const std::vector<bool> & apply,
   const RecordHandler recordHandler(obsdb_,
                                     filtervars,
                                     *flags_,
-                                    retainOnlyIfAllFilterVariablesAreValid);
+                                    retainOnlyIfAllFilterVariablesAreValid,
+                                    &data_);
 
   // If records are treated as single obs and a category variable is also used,
   // ensure that there are no records with multiple values of the category variable.
@@ -146,7 +147,7 @@ ObsAccessor Gaussian_Thinning::createObsAccessor() const {
     }
   } else if (options_.categoryVariable.value() != boost::none) {
     return ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
-          obsdb_, *options_.categoryVariable.value());
+          obsdb_, *options_.categoryVariable.value(), options_.redistributeByCategory);
   } else {
     return ObsAccessor::toAllObservations(obsdb_);
   }
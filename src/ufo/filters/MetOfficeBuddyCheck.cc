@@ -30,7 +30,9 @@
 #include "ufo/filters/MetOfficeBuddyCheckParameters.h"
 #include "ufo/filters/MetOfficeBuddyPair.h"
 #include "ufo/filters/MetOfficeBuddyPairFinder.h"
+#include "ufo/utils/CommunicationStatistics.h"
 #include "ufo/utils/PiecewiseLinearInterpolation.h"
+#include "ufo/utils/RecordIndex.h"
 
 
 namespace ufo {
@@ -108,23 +110,19 @@ std::vector<float> localValues(const std::vector<float> & globalValues,
 /// Return a map mapping indices of records held on all MPI ranks to the vectors of global indices
 /// of locations belonging to these records (sorted according to the criteria specified during
 /// ObsSpace construction).
-ioda::ObsSpace::RecIdxMap mapRecordIdsToLocations(const ioda::ObsSpace &obsdb) {
-  const size_t nlocs = obsdb.nlocs();
-
+ioda::ObsSpace::RecIdxMap mapRecordIdsToLocations(const ioda::ObsSpace &obsdb,
+                                                   const RecordIndex &recordIndex) {
   // Identify the index of each location within the record it belongs to
-  std::vector<size_t> locationIndexWithinItsRecord(nlocs);
-  for (ioda::ObsSpace::RecIdxIter irec = obsdb.recidx_begin(); irec != obsdb.recidx_end(); ++irec) {
-    size_t index = 0;
-    for (size_t loc : obsdb.recidx_vector(irec))
-      locationIndexWithinItsRecord[loc] = index++;
-  }
+  std::vector<size_t> locationIndexWithinItsRecord = recordIndex.positionInRecord();
 
   // Identify the record containing each location
   std::vector<size_t> recordIds = obsdb.recnum();
 
   // Collect data from all MPI ranks
   obsdb.distribution()->allGatherv(locationIndexWithinItsRecord);
+  CommunicationStatistics::recordReceived("MetOfficeBuddyCheck", locationIndexWithinItsRecord);
   obsdb.distribution()->allGatherv(recordIds);
+  CommunicationStatistics::recordReceived("MetOfficeBuddyCheck", recordIds);
 
   // Count the number of locations in each record
   std::map<size_t, size_t> numLocsPerRecord;
@@ -153,6 +151,7 @@ ioda::ObsSpace::RecIdxMap mapRecordIdsToLocations(const ioda::ObsSpace &obsdb) {
 /// locations; an exception is thrown if that is not the case.
 ///
 Eigen::ArrayXXi deriveIndices(const ioda::ObsSpace & obsdb,
+                              const RecordIndex & recordIndex,
                               const int numLevels) {
   // Assume ObsSpace contains only the averaged profiles if this variable isn't present.
   boost::optional<std::vector<int>> extended_obs_space;
@@ -160,9 +159,10 @@ Eigen::ArrayXXi deriveIndices(const ioda::ObsSpace & obsdb,
     extended_obs_space = std::vector<int>(obsdb.nlocs());
     obsdb.get_db("MetaData", "extended_obs_space", *extended_obs_space);
     obsdb.distribution()->allGatherv(*extended_obs_space);
+    CommunicationStatistics::recordReceived("MetOfficeBuddyCheck", *extended_obs_space);
   }
 
-  ioda::ObsSpace::RecIdxMap locationsPerRecord = mapRecordIdsToLocations(obsdb);
+  ioda::ObsSpace::RecIdxMap locationsPerRecord = mapRecordIdsToLocations(obsdb, recordIndex);
   Eigen::ArrayXXi profileIndex{locationsPerRecord.size(), numLevels};
 
   int recnum = 0;
@@ -282,7 +282,7 @@ void MetOfficeBuddyCheck::applyFilter(const std::vector<bool> & apply,
 
   boost::optional<Eigen::ArrayXXi> profileIndex;
   if (numLevels)
-    profileIndex = deriveIndices(obsdb_, *numLevels);
+    profileIndex = deriveIndices(obsdb_, *data_.recordIndex(), *numLevels);
 
   const std::vector<size_t> validObsIds = getValidObservationIds(apply, profileIndex);
   MetaData obsData = collectMetaData(profileIndex);
@@ -473,6 +473,7 @@ std::vector<int> MetOfficeBuddyCheck::getStationIds() const {
       stationIds.assign(recordNumbers.begin(), recordNumbers.end());
     }
     obsdb_.distribution()->allGatherv(stationIds);
+    CommunicationStatistics::recordReceived("MetOfficeBuddyCheck", stationIds);
     return stationIds;
   } else {
     switch (obsdb_.dtype(stationIdVariable->group(), stationIdVariable->variable())) {
@@ -499,6 +500,7 @@ std::vector<T> MetOfficeBuddyCheck::getGlobalObsSpaceVariable(const std::string
   std::vector<T> values(obsdb_.nlocs());
   obsdb_.get_db(group, variable, values);
   obsdb_.distribution()->allGatherv(values);
+  CommunicationStatistics::recordReceived("MetOfficeBuddyCheck", values);
   return values;
 }
 
@@ -513,6 +515,7 @@ std::vector<T> MetOfficeBuddyCheck::getGlobalVariable(const Variable &var) const
   std::vector<T> values;
   data_.get(var, values);
   obsdb_.distribution()->allGatherv(values);
+  CommunicationStatistics::recordReceived("MetOfficeBuddyCheck", values);
   return values;
 }
 
@@ -812,6 +815,7 @@ std::vector<size_t> MetOfficeBuddyCheck::getValidObservationIds(
 
   std::vector<int> isValidAsInt(apply.begin(), apply.end());
   obsdb_.distribution()->allGatherv(isValidAsInt);
+  CommunicationStatistics::recordReceived("MetOfficeBuddyCheck", isValidAsInt);
   isValid.assign(isValidAsInt.begin(), isValidAsInt.end());
 
   std::vector<size_t> validObsIds;
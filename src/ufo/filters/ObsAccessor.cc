@@ -7,31 +7,27 @@
 
 #include "ufo/filters/ObsAccessor.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "eckit/mpi/Comm.h"
 #include "ioda/distribution/InefficientDistribution.h"
 #include "ioda/ObsSpace.h"
+#include "oops/util/DateTime.h"
 #include "ufo/filters/FilterUtils.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variables.h"
+#include "ufo/utils/CommunicationStatistics.h"
 #include "ufo/utils/RecursiveSplitter.h"
 
 namespace ufo {
 
 namespace {
 
-template <typename VariableType>
-std::vector<VariableType> getVariableFromObsSpaceImpl(
-    const std::string &group, const std::string &variable,
-    const ioda::ObsSpace &obsdb, const ioda::Distribution &obsDistribution) {
-  std::vector<VariableType> result(obsdb.nlocs());
-  obsdb.get_db(group, variable, result);
-  obsDistribution.allGatherv(result);
-  return result;
-}
-
 /// Return the vector of elements of \p categories with indices \p validObsIds.
 template <typename T>
 std::vector<T> getValidObservationCategories(const std::vector<T> &categories,
@@ -43,28 +39,36 @@ std::vector<T> getValidObservationCategories(const std::vector<T> &categories,
   return validObsCategories;
 }
 
-template <typename VariableType>
-void groupObservationsByVariableImpl(
-    const Variable &variable,
-    const std::vector<size_t> &validObsIds,
-    const ioda::ObsSpace &obsdb,
-    const ioda::Distribution &obsDistribution,
-    RecursiveSplitter &splitter) {
-  std::vector<VariableType> obsCategories(obsdb.nlocs());
-  obsdb.get_db(variable.group(), variable.variable(), obsCategories);
-  obsDistribution.allGatherv(obsCategories);
-
-  const std::vector<VariableType> validObsCategories = getValidObservationCategories(
-        obsCategories, validObsIds);
-
-  splitter.groupBy(validObsCategories);
+/// Return the rank owning the category of each observation held on the current rank.
+template <typename T>
+std::vector<size_t> getCategoryOwners(const Variable &variable, const ioda::ObsSpace &obsdb) {
+  std::vector<T> categories(obsdb.nlocs());
+  obsdb.get_db(variable.group(), variable.variable(), categories);
+  const size_t numRanks = obsdb.comm().size();
+  std::hash<T> hash;
+  std::vector<size_t> owners(categories.size());
+  for (size_t loc = 0; loc < categories.size(); ++loc)
+    owners[loc] = hash(categories[loc]) % numRanks;
+  return owners;
 }
 
 }  // namespace
 
+struct ObsAccessor::Redistribution {
+  /// Locations (held on the current rank) sent to each rank.
+  std::vector<std::vector<size_t>> sentLocations;
+  /// IDs of the observations received from each rank in the list of observations owned by the
+  /// current rank. Locations held by several ranks are received several times, but owned once.
+  std::vector<std::vector<size_t>> receivedObsIds;
+  /// Rank from which each owned observation was first received and its position in the
+  /// message received from that rank.
+  std::vector<std::pair<size_t, size_t>> ownedObsSources;
+};
+
 ObsAccessor::ObsAccessor(const ioda::ObsSpace &obsdb,
                          GroupBy groupBy,
-                         boost::optional<Variable> categoryVariable)
+                         boost::optional<Variable> categoryVariable,
+                         bool redistributeGroups)
   : obsdb_(&obsdb), groupBy_(groupBy), categoryVariable_(categoryVariable)
 {
   // If the observations are to be grouped by a category variable, and that variable was
@@ -83,7 +87,131 @@ ObsAccessor::ObsAccessor(const ioda::ObsSpace &obsdb,
     oops::Log::trace() << "ObservationAccessor: no MPI communication necessary" << std::endl;
   } else {
     obsDistribution_ = obsdb.distribution();
+    if (groupBy_ == GroupBy::VARIABLE && redistributeGroups && obsdb_->comm().size() > 1)
+      setUpRedistribution();
+  }
+}
+
+void ObsAccessor::setUpRedistribution() {
+  std::vector<size_t> owners;
+  switch (obsdb_->dtype(categoryVariable_->group(), categoryVariable_->variable())) {
+  case ioda::ObsDtype::Integer:
+    owners = getCategoryOwners<int>(*categoryVariable_, *obsdb_);
+    break;
+
+  case ioda::ObsDtype::String:
+    owners = getCategoryOwners<std::string>(*categoryVariable_, *obsdb_);
+    break;
+
+  default:
+    throw eckit::UserError(
+          categoryVariable_->variable() + "@" + categoryVariable_->group() +
+          " is neither an integer nor a string variable", Here());
+  }
+
+  const eckit::mpi::Comm &comm = obsdb_->comm();
+  auto redistribution = std::make_shared<Redistribution>();
+  redistribution->sentLocations.resize(comm.size());
+  for (size_t loc = 0; loc < owners.size(); ++loc)
+    redistribution->sentLocations[owners[loc]].push_back(loc);
+
+  std::vector<std::vector<size_t>> sentGlobalIds(comm.size()), receivedGlobalIds;
+  for (size_t rank = 0; rank < comm.size(); ++rank)
+    for (size_t loc : redistribution->sentLocations[rank])
+      sentGlobalIds[rank].push_back(obsDistribution_->globalUniqueConsecutiveLocationIndex(loc));
+  comm.allToAll(sentGlobalIds, receivedGlobalIds);
+  CommunicationStatistics::recordReceived("ObsAccessor", receivedGlobalIds);
+
+  // Order the owned observations by global ID, so that the observations of each group appear in
+  // the same order as if they had been gathered from all ranks.
+  std::vector<std::pair<size_t, std::pair<size_t, size_t>>> received;
+  redistribution->receivedObsIds.resize(comm.size());
+  for (size_t rank = 0; rank < comm.size(); ++rank) {
+    redistribution->receivedObsIds[rank].resize(receivedGlobalIds[rank].size());
+    for (size_t pos = 0; pos < receivedGlobalIds[rank].size(); ++pos)
+      received.emplace_back(receivedGlobalIds[rank][pos], std::make_pair(rank, pos));
+  }
+  std::sort(received.begin(), received.end());
+
+  for (size_t i = 0; i < received.size(); ++i) {
+    if (i == 0 || received[i].first != received[i - 1].first)
+      redistribution->ownedObsSources.push_back(received[i].second);
+    const std::pair<size_t, size_t> &source = received[i].second;
+    redistribution->receivedObsIds[source.first][source.second] =
+        redistribution->ownedObsSources.size() - 1;
   }
+
+  redistribution_ = redistribution;
+  oops::Log::trace() << "ObservationAccessor: " << redistribution_->ownedObsSources.size()
+                     << " observations redistributed to this rank" << std::endl;
+}
+
+template <typename T>
+std::vector<T> ObsAccessor::collect(std::vector<T> localValues) const {
+  if (redistribution_)
+    return redistribute(localValues);
+  obsDistribution_->allGatherv(localValues);
+  CommunicationStatistics::recordReceived("ObsAccessor", localValues);
+  return localValues;
+}
+
+template <typename T>
+std::vector<T> ObsAccessor::redistribute(const std::vector<T> &localValues) const {
+  const std::vector<std::vector<size_t>> &sentLocations = redistribution_->sentLocations;
+  std::vector<std::vector<T>> sentValues(sentLocations.size()), receivedValues;
+  for (size_t rank = 0; rank < sentLocations.size(); ++rank) {
+    sentValues[rank].reserve(sentLocations[rank].size());
+    for (size_t loc : sentLocations[rank])
+      sentValues[rank].push_back(localValues[loc]);
+  }
+  obsdb_->comm().allToAll(sentValues, receivedValues);
+  CommunicationStatistics::recordReceived("ObsAccessor", receivedValues);
+
+  std::vector<T> ownedValues;
+  ownedValues.reserve(redistribution_->ownedObsSources.size());
+  for (const std::pair<size_t, size_t> &source : redistribution_->ownedObsSources)
+    ownedValues.push_back(receivedValues[source.first][source.second]);
+  return ownedValues;
+}
+
+std::vector<std::string> ObsAccessor::redistribute(
+    const std::vector<std::string> &localValues) const {
+  // Exchange the lengths and the concatenated characters of the strings.
+  const std::vector<std::vector<size_t>> &sentLocations = redistribution_->sentLocations;
+  std::vector<std::vector<size_t>> sentLengths(sentLocations.size()), receivedLengths;
+  std::vector<std::vector<char>> sentChars(sentLocations.size()), receivedChars;
+  for (size_t rank = 0; rank < sentLocations.size(); ++rank) {
+    for (size_t loc : sentLocations[rank]) {
+      sentLengths[rank].push_back(localValues[loc].size());
+      sentChars[rank].insert(sentChars[rank].end(),
+                             localValues[loc].begin(), localValues[loc].end());
+    }
+  }
+  obsdb_->comm().allToAll(sentLengths, receivedLengths);
+  obsdb_->comm().allToAll(sentChars, receivedChars);
+  CommunicationStatistics::recordReceived("ObsAccessor", receivedLengths);
+  CommunicationStatistics::recordReceived("ObsAccessor", receivedChars);
+
+  std::vector<std::vector<std::string>> receivedValues(receivedLengths.size());
+  for (size_t rank = 0; rank < receivedLengths.size(); ++rank) {
+    size_t offset = 0;
+    for (size_t length : receivedLengths[rank]) {
+      receivedValues[rank].emplace_back(receivedChars[rank].data() + offset, length);
+      offset += length;
+    }
+  }
+
+  std::vector<std::string> ownedValues;
+  ownedValues.reserve(redistribution_->ownedObsSources.size());
+  for (const std::pair<size_t, size_t> &source : redistribution_->ownedObsSources)
+    ownedValues.push_back(std::move(receivedValues[source.first][source.second]));
+  return ownedValues;
+}
+
+std::vector<util::DateTime> ObsAccessor::redistribute(
+    const std::vector<util::DateTime> &localValues) const {
+  // Date/times are exchanged as integers.
+  return fromEpochSeconds(redistribute(toEpochSeconds(localValues)));
 }
 
 ObsAccessor ObsAccessor::toAllObservations(
@@ -97,8 +225,8 @@ ObsAccessor ObsAccessor::toObservationsSplitIntoIndependentGroupsByRecordId(
 }
 
 ObsAccessor ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
-    const ioda::ObsSpace &obsdb, const Variable &variable) {
-  return ObsAccessor(obsdb, GroupBy::VARIABLE, variable);
+    const ioda::ObsSpace &obsdb, const Variable &variable, bool redistributeGroups) {
+  return ObsAccessor(obsdb, GroupBy::VARIABLE, variable, redistributeGroups);
 }
 
 ObsAccessor ObsAccessor::toSingleObservationsSplitIntoIndependentGroupsByVariable(
@@ -106,10 +234,17 @@ ObsAccessor ObsAccessor::toSingleObservationsSplitIntoIndependentGroupsByVariabl
   return ObsAccessor(obsdb, GroupBy::SINGLE_OBS, variable);
 }
 
+template <typename VariableType>
+std::vector<VariableType> ObsAccessor::getVariableFromObsSpace(
+    const std::string &group, const std::string &variable) const {
+  std::vector<VariableType> result(obsdb_->nlocs());
+  obsdb_->get_db(group, variable, result);
+  return collect(std::move(result));
+}
+
 std::vector<bool> ObsAccessor::getGlobalApply(
     const std::vector<bool> &apply) const {
-  std::vector<int> globalApply(apply.begin(), apply.end());
-  obsDistribution_->allGatherv(globalApply);
+  const std::vector<int> globalApply = collect(std::vector<int>(apply.begin(), apply.end()));
   return std::vector<bool>(globalApply.begin(), globalApply.end());
 }
 
@@ -124,8 +259,7 @@ std::vector<size_t> ObsAccessor::getValidObservationIds(
   unselectRejectedLocations(isValid, filtervars, flags, mode);
 
   // TODO(wsmigaj): use std::vector<unsigned char> to save space
-  std::vector<int> globalIsValid(isValid.begin(), isValid.end());
-  obsDistribution_->allGatherv(globalIsValid);
+  const std::vector<int> globalIsValid = collect(std::vector<int>(isValid.begin(), isValid.end()));
 
   std::vector<size_t> validObsIds;
   for (size_t obsId = 0; obsId < globalIsValid.size(); ++obsId)
@@ -138,8 +272,7 @@ std::vector<size_t> ObsAccessor::getValidObservationIds(
 std::vector<size_t> ObsAccessor::getValidObservationIds(
     const std::vector<bool> &apply) const {
   // TODO(wsmigaj): use std::vector<unsigned char> to save space
-  std::vector<int> globalIsValid(apply.begin(), apply.end());
-  obsDistribution_->allGatherv(globalIsValid);
+  const std::vector<int> globalIsValid = collect(std::vector<int>(apply.begin(), apply.end()));
 
   std::vector<size_t> validObsIds;
   for (size_t obsId = 0; obsId < globalIsValid.size(); ++obsId)
@@ -176,36 +309,45 @@ const std::vector<size_t> ObsAccessor::getValidObsIdsInProfile(const size_t & iP
 
 std::vector<int> ObsAccessor::getIntVariableFromObsSpace(
     const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<int>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpace<int>(group, variable);
 }
 
 std::vector<float> ObsAccessor::getFloatVariableFromObsSpace(
     const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<float>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpace<float>(group, variable);
 }
 
 std::vector<double> ObsAccessor::getDoubleVariableFromObsSpace(
     const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<double>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpace<double>(group, variable);
 }
 
 std::vector<std::string> ObsAccessor::getStringVariableFromObsSpace(
     const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<std::string>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpace<std::string>(group, variable);
 }
 
 std::vector<util::DateTime> ObsAccessor::getDateTimeVariableFromObsSpace(
       const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<util::DateTime>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpace<util::DateTime>(group, variable);
+}
+
+std::vector<EpochSeconds> ObsAccessor::getEpochSecondsVariableFromObsSpace(
+      const std::string &group, const std::string &variable) const {
+  std::vector<util::DateTime> localValues(obsdb_->nlocs());
+  obsdb_->get_db(group, variable, localValues);
+  if (redistribution_)
+    return redistribute(toEpochSeconds(localValues));
+  return toEpochSeconds(collect(std::move(localValues)));
 }
 
 std::vector<size_t> ObsAccessor::getRecordIds() const {
-  std::vector<size_t> recordIds = obsdb_->recnum();
-  obsDistribution_->allGatherv(recordIds);
-  return recordIds;
+  return collect(obsdb_->recnum());
 }
 
 size_t ObsAccessor::totalNumObservations() const {
+  if (redistribution_)
+    return redistribution_->ownedObsSources.size();
   return obsdb_->globalNumLocs();
 }
 
@@ -242,13 +384,16 @@ void ObsAccessor::groupObservationsByCategoryVariable(
     RecursiveSplitter &splitter) const {
   switch (obsdb_->dtype(categoryVariable_->group(), categoryVariable_->variable())) {
   case ioda::ObsDtype::Integer:
-    groupObservationsByVariableImpl<int>(*categoryVariable_, validObsIds,
-                                         *obsdb_, *obsDistribution_, splitter);
+    splitter.groupBy(getValidObservationCategories(
+        getVariableFromObsSpace<int>(categoryVariable_->group(), categoryVariable_->variable()),
+        validObsIds));
     break;
 
   case ioda::ObsDtype::String:
-    groupObservationsByVariableImpl<std::string>(*categoryVariable_, validObsIds,
-                                                 *obsdb_, *obsDistribution_, splitter);
+    splitter.groupBy(getValidObservationCategories(
+        getVariableFromObsSpace<std::string>(categoryVariable_->group(),
+                                             categoryVariable_->variable()),
+        validObsIds));
     break;
 
   default:
@@ -264,6 +409,25 @@ void ObsAccessor::flagRejectedObservations(
   for (const std::vector<bool> & variableFlagged : flagged)
     ASSERT(variableFlagged.size() == localNumObs);
 
+  if (redistribution_) {
+    // Send the decisions back to the ranks holding the observations.
+    const std::vector<std::vector<size_t>> &receivedObsIds = redistribution_->receivedObsIds;
+    std::vector<std::vector<int>> sentIsRejected(receivedObsIds.size()), receivedIsRejected;
+    for (size_t rank = 0; rank < receivedObsIds.size(); ++rank)
+      for (size_t obsId : receivedObsIds[rank])
+        sentIsRejected[rank].push_back(isRejected[obsId]);
+    obsdb_->comm().allToAll(sentIsRejected, receivedIsRejected);
+    CommunicationStatistics::recordReceived("ObsAccessor", receivedIsRejected);
+
+    const std::vector<std::vector<size_t>> &sentLocations = redistribution_->sentLocations;
+    for (size_t rank = 0; rank < sentLocations.size(); ++rank)
+      for (size_t pos = 0; pos < sentLocations[rank].size(); ++pos)
+        if (receivedIsRejected[rank][pos])
+          for (std::vector<bool> & variableFlagged : flagged)
+            variableFlagged[sentLocations[rank][pos]] = true;
+    return;
+  }
+
   for (size_t localObsId = 0; localObsId < localNumObs; ++localObsId) {
     const size_t globalObsId =
         obsDistribution_->globalUniqueConsecutiveLocationIndex(localObsId);
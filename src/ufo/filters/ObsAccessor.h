@@ -16,6 +16,7 @@
 
 #include "ioda/ObsDataVector.h"
 #include "ufo/filters/Variable.h"
+#include "ufo/utils/EpochSeconds.h"
 
 namespace ioda {
 class Distribution;
@@ -59,6 +60,18 @@ class RecursiveSplitter;
 /// Call splitObservationsIntoIndependentGroups() to construct a RecursiveSplitter object whose
 /// groups() method will return groups of observations that can be processed independently from
 /// each other (according to the criterion specified when the ObsAccessor was constructed).
+///
+/// If the groups are defined by a variable that was not used to divide the ObsSpace into records,
+/// toObservationsSplitIntoIndependentGroupsByVariable() can optionally be asked to redistribute
+/// the observations rather than gather them on all ranks. Each group is then assigned to a
+/// single "owner" rank (chosen by hashing the value of the category variable), the observations
+/// of each group are sent to its owner with a single all-to-all exchange, and the vectors returned
+/// by methods such as getValidObservationIds() and getIntVariableFromObsSpace() only cover the
+/// observations owned by the current rank. Their IDs run from 0 to totalNumObservations() - 1 and
+/// follow the order of global IDs, so each group is processed exactly as if all observations had
+/// been gathered. flagRejectedObservations() sends the decisions back to the ranks holding the
+/// observations. Memory use and the volume of exchanged data then scale with the number of
+/// observations per rank rather than the total number of observations.
 class ObsAccessor {
  public:
   ~ObsAccessor() = default;
@@ -80,8 +93,12 @@ class ObsAccessor {
 
   /// \brief Create an accessor to the collection of observations held in \p obsdb, assuming that
   /// observations with different values of the variable \p variable can be processed independently.
+  ///
+  /// If \p redistributeGroups is true and \p variable was not used to divide \p obsdb into
+  /// records, the observations of each group are sent to a single owner rank instead of being
+  /// gathered on all ranks (see the class documentation).
   static ObsAccessor toObservationsSplitIntoIndependentGroupsByVariable(
-      const ioda::ObsSpace &obsdb, const Variable &variable);
+      const ioda::ObsSpace &obsdb, const Variable &variable, bool redistributeGroups = false);
 
   /// \brief Create an accessor to the collection of observations held in \p obsdb, assuming that
   /// each record is treated as a single observation.
@@ -205,6 +222,13 @@ class ObsAccessor {
                                                          const std::string &variable) const;
   std::vector<util::DateTime> getDateTimeVariableFromObsSpace(const std::string &group,
                                                               const std::string &variable) const;
+  /// \brief Return the values of a date/time variable as numbers of seconds since
+  /// 1970-01-01T00:00:00Z.
+  ///
+  /// This is cheaper than getDateTimeVariableFromObsSpace() if the values are only going to be
+  /// sorted, compared or differenced.
+  std::vector<EpochSeconds> getEpochSecondsVariableFromObsSpace(
+      const std::string &group, const std::string &variable) const;
 
   /// \brief Return the vector of IDs of records successive observation locations belong to.
   ///
@@ -214,8 +238,9 @@ class ObsAccessor {
   std::vector<size_t> getRecordIds() const;
 
   /// If each independent group of observations is stored entirely on a single MPI rank, return the
-  /// number of observation locations held on the current rank. Otherwise return the total number
-  /// of observation locations held on all ranks.
+  /// number of observation locations held on the current rank. If the groups have been
+  /// redistributed, return the number of observation locations owned by the current rank.
+  /// Otherwise return the total number of observation locations held on all ranks.
   size_t totalNumObservations() const;
 
   /// Construct a RecursiveSplitter object whose groups() method will return groups of observations
@@ -275,6 +300,10 @@ class ObsAccessor {
   /// the category variable was used to divide the ObsSpace into records.
   enum class GroupBy { NOTHING, RECORD_ID, VARIABLE, SINGLE_OBS };
 
+  /// Describes how observations grouped by the category variable are exchanged with the ranks
+  /// owning each group.
+  struct Redistribution;
+
   /// Private constructor. Construct instances of this class by calling toAllObservations(),
   /// toObservationsSplitIntoIndependentGroupsByRecordId(),
   /// toObservationsSplitIntoIndependentGroupsByVariable() or
@@ -282,10 +311,31 @@ class ObsAccessor {
   /// instead.
   ObsAccessor(const ioda::ObsSpace &obsdb,
               GroupBy groupBy,
-              boost::optional<Variable> categoryVariable);
+              boost::optional<Variable> categoryVariable,
+              bool redistributeGroups = false);
 
   bool wereRecordsGroupedByCategoryVariable() const;
 
+  /// Assign each category to an owner rank and work out which observations each rank must send
+  /// to and will receive from every other rank.
+  void setUpRedistribution();
+
+  /// Return the values of a variable at the observation locations accessible to this object,
+  /// given its values \p localValues at the locations held on the current rank.
+  template <typename T>
+  std::vector<T> collect(std::vector<T> localValues) const;
+
+  template <typename VariableType>
+  std::vector<VariableType> getVariableFromObsSpace(const std::string &group,
+                                                    const std::string &variable) const;
+
+  /// Send the elements of \p localValues to the ranks owning the corresponding observations and
+  /// return the values at the observations owned by the current rank.
+  template <typename T>
+  std::vector<T> redistribute(const std::vector<T> &localValues) const;
+  std::vector<std::string> redistribute(const std::vector<std::string> &localValues) const;
+  std::vector<util::DateTime> redistribute(const std::vector<util::DateTime> &localValues) const;
+
   void groupObservationsByRecordNumber(const std::vector<size_t> &validObsIds,
                                        RecursiveSplitter &splitter) const;
 
@@ -298,6 +348,8 @@ class ObsAccessor {
 
   GroupBy groupBy_;
   boost::optional<Variable> categoryVariable_;
+  /// Set only if the groups have been redistributed to their owner ranks.
+  std::shared_ptr<const Redistribution> redistribution_;
 };
 
 }  // namespace ufo
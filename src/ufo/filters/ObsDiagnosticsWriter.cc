@@ -15,7 +15,7 @@ namespace ufo {
 // -----------------------------------------------------------------------------
 
 ObsDiagnosticsWriter::ObsDiagnosticsWriter(
-                       ioda::ObsSpace &, const Parameters_ & params,
+                       ioda::ObsSpace & os, const Parameters_ & params,
                        std::shared_ptr<ioda::ObsDataVector<int> >,
                        std::shared_ptr<ioda::ObsDataVector<float> >)
   : params_(params), extradiagvars_()
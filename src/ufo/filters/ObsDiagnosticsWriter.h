@@ -56,6 +56,7 @@ class ObsDiagnosticsWriter : public oops::interface::ObsFilterBase<ObsTraits> {
                   const ioda::ObsVector &,
                   const ObsDiagnostics & diags) override {
     diags.write(params_.diags);
+    diags.finishedWith(consumer_);
   }
   void checkFilterData(const oops::FilterStage filterStage) override {}
 
@@ -67,6 +68,8 @@ class ObsDiagnosticsWriter : public oops::interface::ObsFilterBase<ObsTraits> {
   Parameters_ params_;
   const oops::Variables nogeovals_;
   oops::Variables extradiagvars_;
+  /// Keeps all diagnostics available until they have been written.
+  ObsDiagnosticsConsumer consumer_;
 };
 
 }  // namespace ufo
@@ -7,7 +7,10 @@
 
 #include "ufo/filters/ObsFilterData.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "eckit/utils/StringTools.h"
@@ -20,12 +23,17 @@
 #include "ufo/filters/Variable.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/utils/ChannelLevelLocationArray.h"
+#include "ufo/utils/RecordIndex.h"
+#include "ufo/utils/SolarGeometry.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 ObsFilterData::ObsFilterData(ioda::ObsSpace & obsdb)
-  : obsdb_(obsdb), gvals_(NULL), ovecs_(), diags_(NULL), dvecsf_(), dvecsi_() {
+  : obsdb_(obsdb), gvals_(NULL), ovecs_(), diags_(NULL), dvecsf_(), dvecsi_(),
+    recordIndex_(std::make_shared<std::shared_ptr<const RecordIndex>>()),
+    solarGeometry_(std::make_shared<std::shared_ptr<const SolarGeometry>>()) {
   oops::Log::trace() << "ObsFilterData created" << std::endl;
 }
 
@@ -34,6 +42,29 @@ ObsFilterData::~ObsFilterData() {
   oops::Log::trace() << "ObsFilterData destructed" << std::endl;
 }
 
+// -----------------------------------------------------------------------------
+std::shared_ptr<const RecordIndex> ObsFilterData::recordIndex() const {
+  std::shared_ptr<const RecordIndex> &index = *recordIndex_;
+  if (!index || !index->isValidFor(obsdb_))
+    index = std::make_shared<const RecordIndex>(obsdb_);
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<const SolarGeometry> ObsFilterData::solarGeometry() const {
+  std::shared_ptr<const SolarGeometry> &geometry = *solarGeometry_;
+  if (!geometry || geometry->nlocs() != obsdb_.nlocs()) {
+    std::vector<float> lats, lons;
+    std::vector<EpochSeconds> times;
+    get(Variable("latitude@MetaData"), lats);
+    get(Variable("longitude@MetaData"), lons);
+    getEpochSeconds(Variable("dateTime@MetaData"), times);
+    geometry = std::make_shared<const SolarGeometry>(std::move(lats), std::move(lons),
+                                                     std::move(times));
+  }
+  return geometry;
+}
+
 // -----------------------------------------------------------------------------
 /*! Associates GeoVaLs with this ObsFilterData (after this call GeoVaLs are available) */
 void ObsFilterData::associate(const GeoVaLs & gvals) {
@@ -166,6 +197,14 @@ void ObsFilterData::get(const Variable & varname, std::vector<DiagnosticFlag> &
   getVector(varname, values, skipDerived);
 }
 
+// -----------------------------------------------------------------------------
+void ObsFilterData::getEpochSeconds(const Variable & varname, std::vector<EpochSeconds> & values,
+                                    bool skipDerived) const {
+  std::vector<util::DateTime> dateTimes;
+  getVector(varname, dateTimes, skipDerived);
+  values = toEpochSeconds(dateTimes);
+}
+
 // -----------------------------------------------------------------------------
 template <typename T>
 void ObsFilterData::getVector(const Variable & varname, std::vector<T> & values,
@@ -225,6 +264,51 @@ void ObsFilterData::get(const Variable & varname, const int level,
   }
 }
 
+// -----------------------------------------------------------------------------
+// Overloads of get() taking a ChannelLevelLocationArray.
+// -----------------------------------------------------------------------------
+void ObsFilterData::get(const Variable & varname, ChannelLevelLocationArray<float> & values,
+                        bool reverseLevels) const {
+  getAllLevels(varname, values, reverseLevels);
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::get(const Variable & varname, ChannelLevelLocationArray<double> & values,
+                        bool reverseLevels) const {
+  getAllLevels(varname, values, reverseLevels);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void ObsFilterData::getAllLevels(const Variable & varname, ChannelLevelLocationArray<T> & values,
+                                 bool reverseLevels) const {
+  const std::string grp = varname.group();
+  ASSERT(grp == "GeoVaLs" || grp == "ObsDiag" || grp == "ObsBiasTerm");
+  const bool isGeoVaL = grp == "GeoVaLs";
+  // As in the other overloads of get(), ObsDiag and ObsBiasTerm variables are both held in
+  // ObsDiagnostics.
+  ASSERT(isGeoVaL ? gvals_ != nullptr : diags_ != nullptr);
+
+  const size_t nlocs = obsdb_.nlocs();
+  const size_t nchans = varname.size();
+  // Each channel is a separate GeoVaLs/ObsDiagnostics variable, so it is fetched by a separate
+  // call; its values are written (and, if necessary, converted to T) straight into `values`.
+  for (size_t ichan = 0; ichan < nchans; ++ichan) {
+    const std::string var = varname.variable(ichan);
+    const size_t nlevs = isGeoVaL ? gvals_->nlevs(var) : diags_->nlevs(var);
+    if (ichan == 0) {
+      values.resize(nchans, nlevs, nlocs);
+    } else if (nlevs != values.nlevs()) {
+      throw eckit::BadParameter("ObsFilterData::get: channels of " + varname.fullName() +
+                                " have different numbers of levels", Here());
+    }
+    if (isGeoVaL)
+      gvals_->getAllLevels(values.channel(ichan), var, reverseLevels);
+    else
+      diags_->getAllLevels(values.channel(ichan), var, reverseLevels);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // Overloads of get() taking an ioda::ObsDataVector.
 
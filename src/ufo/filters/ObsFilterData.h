@@ -9,6 +9,7 @@
 #define UFO_FILTERS_OBSFILTERDATA_H_
 
 #include <map>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "oops/util/Printable.h"
 
 #include "ufo/filters/DiagnosticFlag.h"
+#include "ufo/utils/EpochSeconds.h"
 
 namespace util {
   class DateTime;
@@ -30,8 +32,11 @@ namespace ioda {
 }
 
 namespace ufo {
+  template <typename T> class ChannelLevelLocationArray;
   class GeoVaLs;
   class ObsDiagnostics;
+  class RecordIndex;
+  class SolarGeometry;
   class Variable;
 
 // -----------------------------------------------------------------------------
@@ -85,6 +90,14 @@ class ObsFilterData : public util::Printable,
   void get(const Variable &varname, std::vector<DiagnosticFlag> &values,
            bool skipDerived = false) const;
 
+  //! \brief Fills a `std::vector` with values of the specified date/time variable expressed as
+  //! numbers of seconds since 1970-01-01T00:00:00Z.
+  //!
+  //! Missing date/times are set to missingEpochSeconds(). Date/times are converted once, so that
+  //! callers can sort, compare and difference them with integer arithmetic.
+  void getEpochSeconds(const Variable &varname, std::vector<EpochSeconds> &values,
+                       bool skipDerived = false) const;
+
   //! \brief Fills a `std::vector` with values of the specified variable at a single level.
   //!
   //! \param varname
@@ -103,6 +116,25 @@ class ObsFilterData : public util::Printable,
   void get(const Variable & varname, const int level,
            std::vector<double> & values) const;
 
+  //! \brief Fills a ChannelLevelLocationArray with values of the specified variable at all
+  //! channels, levels and locations.
+  //!
+  //! \param varname
+  //!   The requested variable, which must belong to one of the following groups: GeoVaLs, ObsDiag
+  //!   and ObsBiasTerm. If it has no channels, \p values will have a single channel.
+  //! \param[out] values
+  //!   Array to be filled with values of the requested variable.
+  //! \param reverseLevels
+  //!   If true, level `ilev` of \p values holds level `nlevs - 1 - ilev` of the variable.
+  //!
+  //! This is equivalent to, but much cheaper than, calling get() for each channel and level: the
+  //! values of each channel are fetched with a single call and written straight into \p values.
+  void get(const Variable & varname, ChannelLevelLocationArray<float> & values,
+           bool reverseLevels = false) const;
+  //! \overload
+  void get(const Variable & varname, ChannelLevelLocationArray<double> & values,
+           bool reverseLevels = false) const;
+
   //! brief Fills a `ioda::ObsDataVector` with values of the specified variable.
   //!
   //! \param varname
@@ -146,12 +178,28 @@ class ObsFilterData : public util::Printable,
   const GeoVaLs * getGeoVaLs() const {return gvals_;}
   //! Returns reference to ObsDiagnostics
   const ObsDiagnostics * getObsDiags() const {return diags_;}
+  //! \brief Returns the record index of the associated ObsSpace.
+  //!
+  //! The index is built on first use and shared by all copies of this ObsFilterData. It is
+  //! rebuilt if the number of locations or records in the ObsSpace has changed since.
+  std::shared_ptr<const RecordIndex> recordIndex() const;
+  //! \brief Returns the position of the Sun at the observation locations and times.
+  //!
+  //! The geometry is computed on first use and shared by all copies of this ObsFilterData, so
+  //! that obsfunctions and where clauses needing it in the same filter chain compute it once.
+  //! Like the record index, it is recomputed if the number of locations in the ObsSpace has
+  //! changed since; filters are not expected to modify the locations or times of observations.
+  std::shared_ptr<const SolarGeometry> solarGeometry() const;
  private:
   void print(std::ostream &) const;
   bool hasVector(const std::string &, const std::string &) const;
   bool hasDataVector(const std::string &, const std::string &) const;
   bool hasDataVectorInt(const std::string &, const std::string &) const;
 
+  template <typename T>
+  void getAllLevels(const Variable &varname, ChannelLevelLocationArray<T> &values,
+                    bool reverseLevels) const;
+
   template <typename T>
   void getVector(const Variable &varname, std::vector<T> &values,
                  bool skipDerived = false) const;
@@ -166,6 +214,10 @@ class ObsFilterData : public util::Printable,
   const ObsDiagnostics mutable * diags_;   //!< pointer to ObsDiagnostics associated with object
   std::map<std::string, const ioda::ObsDataVector<float> *> dvecsf_;  //!< Associated ObsDataVectors
   std::map<std::string, const ioda::ObsDataVector<int> *> dvecsi_;  //!< Associated ObsDataVectors
+  //! Record index of obsdb_, shared by all copies of this object
+  std::shared_ptr<std::shared_ptr<const RecordIndex>> recordIndex_;
+  //! Solar geometry at the locations of obsdb_, shared by all copies of this object
+  std::shared_ptr<std::shared_ptr<const SolarGeometry>> solarGeometry_;
 };
 
 }  // namespace ufo
@@ -55,6 +55,9 @@ void ObsProcessorBase::preProcess() {
   if (allvars_.hasGroup("HofX") || allvars_.hasGroup("ObsDiag") ||
       allvars_.hasGroup("ObsBiasData") || deferToPost_) {
     post_ = true;
+    const oops::Variables diagvars = requiredHdiagnostics();
+    if (diagvars.size() > 0)
+      diagnosticsConsumer_.reset(new ObsDiagnosticsConsumer(diagvars));
   } else {
     if (allvars_.hasGroup("GeoVaLs")) {
       prior_ = true;
@@ -87,6 +90,7 @@ void ObsProcessorBase::postFilter(const GeoVaLs & gv,
     data_.associate(bias, "ObsBiasData");
     data_.associate(diags);
     this->doFilter();
+    if (diagnosticsConsumer_) diags.finishedWith(*diagnosticsConsumer_);
   }
   oops::Log::trace() << "ObsProcessorBase postFilter end" << std::endl;
 }
@@ -25,6 +25,7 @@ namespace ioda {
 namespace ufo {
   class GeoVaLs;
   class ObsDiagnostics;
+  class ObsDiagnosticsConsumer;
 
 /// \brief Base class for UFO observation processors (including QC filters).
 ///
@@ -59,6 +60,8 @@ class ObsProcessorBase : public oops::interface::ObsFilterBase<ObsTraits> {
   ObsFilterData data_;
   bool prior_;
   bool post_;
+  /// Identifies this processor as a consumer of the ObsDiag variables it requires.
+  std::unique_ptr<ObsDiagnosticsConsumer> diagnosticsConsumer_;
 
  private:
   virtual void doFilter() const = 0;
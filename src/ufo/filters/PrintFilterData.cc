@@ -18,6 +18,7 @@
 #include "oops/util/missingValues.h"
 
 #include "ufo/filters/PrintFilterData.h"
+#include "ufo/utils/CommunicationStatistics.h"
 
 namespace ufo {
 
@@ -47,8 +48,10 @@ void PrintFilterData::getData(const Variable & variable, identifier<VariableType
     // If channels are not present use data_.get().
     data_.get(variable, variableData, parameters_.skipDerived.value());
     std::vector<VariableType> globalVariableData = variableData[0];
-    if (!parameters_.printRank0)
+    if (!parameters_.printRank0) {
       obsdb_.distribution()->allGatherv(globalVariableData);
+      CommunicationStatistics::recordReceived("PrintFilterData", globalVariableData);
+    }
     filterData_[getVariableNameWithChannel(variable, 0)] = std::move(globalVariableData);
   } else {
     // If channels are present use obsdb_.get_db().
@@ -64,8 +67,10 @@ void PrintFilterData::getData(const Variable & variable, identifier<VariableType
         continue;
       }
       std::vector<VariableType> globalVariableData = variableData[ich];
-      if (!parameters_.printRank0)
+      if (!parameters_.printRank0) {
         obsdb_.distribution()->allGatherv(globalVariableData);
+        CommunicationStatistics::recordReceived("PrintFilterData", globalVariableData);
+      }
       filterData_[getVariableNameWithChannel(variable, ich)] = std::move(globalVariableData);
     }
   }
@@ -82,8 +87,10 @@ void PrintFilterData::getData(const Variable & variable, identifier<bool>) const
     data_.get(variable, variableData, parameters_.skipDerived.value());
     // Note conversion to int from bool.
     std::vector<int> globalVariableData(variableData[0].begin(), variableData[0].end());
-    if (!parameters_.printRank0)
+    if (!parameters_.printRank0) {
       obsdb_.distribution()->allGatherv(globalVariableData);
+      CommunicationStatistics::recordReceived("PrintFilterData", globalVariableData);
+    }
     filterData_[getVariableNameWithChannel(variable, 0)] = std::move(globalVariableData);
   } else {
     // If channels are present use obsdb_.get_db().
@@ -99,8 +106,10 @@ void PrintFilterData::getData(const Variable & variable, identifier<bool>) const
         continue;
       }
       std::vector<int> globalVariableData(variableData[ich].begin(), variableData[ich].end());
-      if (!parameters_.printRank0)
+      if (!parameters_.printRank0) {
         obsdb_.distribution()->allGatherv(globalVariableData);
+        CommunicationStatistics::recordReceived("PrintFilterData", globalVariableData);
+      }
       filterData_[getVariableNameWithChannel(variable, ich)] = std::move(globalVariableData);
     }
   }
@@ -256,8 +265,10 @@ void PrintFilterData::printAllData() const {
   // Select locations at which the filter will be applied.
   const std::vector<bool> apply = processWhere(parameters_.where, data_, parameters_.whereOperator);
   std::vector<int> globalApply(apply.begin(), apply.end());
-  if (!parameters_.printRank0)
+  if (!parameters_.printRank0) {
     obsdb_.distribution()->allGatherv(globalApply);
+    CommunicationStatistics::recordReceived("PrintFilterData", globalApply);
+  }
 
   // Loop over each group of locations and print the contents of each variable.
   for (int locgroup = locmin; locgroup < locmax; locgroup += nlocsPerRow) {
@@ -9,6 +9,7 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -18,9 +19,11 @@
 
 #include "oops/util/Logger.h"
 
+#include "ufo/filters/FilterUtils.h"
 #include "ufo/filters/getScalarOrFilterData.h"
 #include "ufo/filters/ObsAccessor.h"
 #include "ufo/filters/SpikeAndStepCheck.h"
+#include "ufo/utils/RecordIndex.h"
 
 namespace ufo {
 
@@ -133,18 +136,19 @@ void SpikeAndStepCheck::applyFilter(const std::vector<bool> & apply,
                            "It needs to be set up with the 'Create Diagnostic Flags' filter "
                            "prior to using the 'set' or 'unset' action.");
   }
-  // Get vector of all record numbers:
-  const std::vector<size_t> & record_numbers = obsdb_.recidx_all_recnums();
-  // Loop over record numbers (i.e. profile to profile):
-  for (size_t iProfile : record_numbers) {
+  // Non-missing where-included obs, found once for all profiles
+  // (unselect location if any filter variable fails QC):
+  std::vector<bool> isValid = apply;
+  unselectRejectedLocations(isValid, filtervars, *flags_,
+                            UnselectLocationIf::ANY_FILTER_VARIABLE_REJECTED);
+  const std::shared_ptr<const RecordIndex> recordIndex = data_.recordIndex();
+  // Loop over records (i.e. profile to profile):
+  for (size_t iProfile = 0; iProfile < recordIndex->nrecs(); ++iProfile) {
     // Get non-missing where-included obs indices for this profile
-    // (candidateForRetentionIfAnyFilterVariablesPassedQC false - i.e. unselect location
-    //  if any filter variable fails QC):
-    const std::vector<size_t> obs_indices = obsAccessor.getValidObsIdsInProfile(iProfile,
-                                                                                apply,
-                                                                                *flags_,
-                                                                                filtervars,
-                                                                                false);
+    std::vector<size_t> obs_indices;
+    for (size_t loc : recordIndex->locations(iProfile))
+      if (isValid[loc])
+        obs_indices.push_back(loc);
     // Struct of y, x, dy, dx, dy/dx:
     xyStruct xy;
 
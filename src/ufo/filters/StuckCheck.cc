@@ -48,11 +48,9 @@ StuckCheck::StuckCheck(ioda::ObsSpace &obsdb, const Parameters_ &parameters,
             then both number stuck tolerance and time stuck tolerance must be set.)", Here());
     }
   }
-  obsGroupDateTimes_.reset(new std::vector<util::DateTime>);
   oops::Log::debug() << "StuckCheck: config = " << options_ << '\n';
 }
 
-// Required for the correct destruction of ObsGroupDateTimes_.
 StuckCheck::~StuckCheck()
 {}
 
@@ -67,38 +65,40 @@ void StuckCheck::applyFilter(const std::vector<bool> & apply,
   // 3rd arg: recordsAreSingleObs = false for Stuck Check.
   ObsAccessor obsAccessor = TrackCheckUtils::createObsAccessor(options_.stationIdVariable,
                                                                obsdb_,
-                                                               false);
+                                                               false,
+                                                               options_.redistributeByStationId);
   const std::vector<size_t> validObsIds = obsAccessor.getValidObservationIds(apply);
-  *obsGroupDateTimes_ = obsAccessor.getDateTimeVariableFromObsSpace(
-        "MetaData", "dateTime");
   // Create groups based on record number (assumed station ID) or category variable
   // (stationIdVariable) or otherwise assume observations all taken by the same station (1 group)
   RecursiveSplitter splitter = obsAccessor.splitObservationsIntoIndependentGroups(validObsIds);
   TrackCheckUtils::sortTracksChronologically(validObsIds, obsAccessor, splitter);
-  std::vector<bool> isRejected(validObsIds.size(), false);
+  const TrackCheckUtils::TrackStore store(splitter, validObsIds);
+  const std::vector<util::DateTime> dateTimes = store.gather(
+        obsAccessor.getDateTimeVariableFromObsSpace("MetaData", "dateTime"));
+  std::vector<bool> isRejected(obsAccessor.totalNumObservations(), false);
   std::vector<std::string> filterVariables = filtervars.toOopsVariables().variables();
   // Iterates through observations to see how long each variable is stuck on one observation
   for (std::string const& variable : filterVariables) {
-    size_t stationNumber = 0;
     if (!obsdb_.has("ObsValue", variable)) {
       std::string errorMessage =
           "StuckCheck Error: ObsValue vector for " + variable + " not found.\n";
       throw std::invalid_argument(errorMessage);
     }
-    const std::vector<float> variableValues = obsAccessor.getFloatVariableFromObsSpace(
-          "ObsValue", variable);
+    const std::vector<float> variableValues = store.gather(
+          obsAccessor.getFloatVariableFromObsSpace("ObsValue", variable));
     const float missingFloat = util::missingValue(float());
-    for (auto station : splitter.multiElementGroups()) {
+    for (size_t stationNumber = 0; stationNumber < store.numTracks(); ++stationNumber) {
       std::string stationId = std::to_string(stationNumber);
-      std::vector<float> variableDataStation = collectStationVariableData(
-            station.begin(), station.end(), validObsIds, variableValues);
+      const size_t stationBegin = store.begin(stationNumber);
+      const size_t stationEnd = store.end(stationNumber);
+      const size_t stationLength = stationEnd - stationBegin;
       // the working variable's value associated with the prior observation
       float previousObservationValue;
       float currentObservationValue;
       size_t firstSameValueIndex = 0;  // the first observation in the current streak
-      for (size_t observationIndex = 0; observationIndex < variableDataStation.size();
+      for (size_t observationIndex = 0; observationIndex < stationLength;
            observationIndex++) {
-        currentObservationValue = variableDataStation.at(observationIndex);
+        currentObservationValue = variableValues[stationBegin + observationIndex];
         if (currentObservationValue == missingFloat) {
           continue;
         }
@@ -108,19 +108,21 @@ void StuckCheck::applyFilter(const std::vector<bool> & apply,
           if (currentObservationValue == previousObservationValue) {
             // If the last observation of the track is part of a streak, the full streak will need
             // to be checked at this point.
-            if (observationIndex == variableDataStation.size() - 1) {
-              StuckCheck::potentiallyRejectStreak(station.begin(),
-                                                  station.end(),
-                                                  validObsIds,
+            if (observationIndex == stationLength - 1) {
+              StuckCheck::potentiallyRejectStreak(store,
+                                                  stationBegin,
+                                                  stationEnd,
+                                                  dateTimes,
                                                   firstSameValueIndex,
                                                   observationIndex,
                                                   isRejected,
                                                   stationId);
             }
           } else {  // streak ended in the previous observation
-            StuckCheck::potentiallyRejectStreak(station.begin(),
-                                                station.end(),
-                                                validObsIds,
+            StuckCheck::potentiallyRejectStreak(store,
+                                                stationBegin,
+                                                stationEnd,
+                                                dateTimes,
                                                 firstSameValueIndex,
                                                 observationIndex - 1,
                                                 isRejected,
@@ -131,7 +133,6 @@ void StuckCheck::applyFilter(const std::vector<bool> & apply,
           }
         }
       }
-      stationNumber++;
     }
   }
   obsAccessor.flagRejectedObservations(isRejected, flagged);
@@ -141,48 +142,26 @@ void StuckCheck::print(std::ostream & os) const {
   os << "StuckCheck: config = " << options_ << '\n';
 }
 
-/// \returns a vector containing all of the necessary data to run this filter for each observation,
-/// stored by observation.
-std::vector<float> StuckCheck::collectStationVariableData(
-    std::vector<size_t>::const_iterator stationObsIndicesBegin,
-    std::vector<size_t>::const_iterator stationObsIndicesEnd,
-    const std::vector<size_t> &validObsIds,
-    const std::vector<float> &globalData) const {
-  std::vector<float> stationData;
-  stationData.reserve(stationObsIndicesEnd - stationObsIndicesBegin);
-  size_t observationNumber = 0;
-  for (std::vector<size_t>::const_iterator it = stationObsIndicesBegin;
-       it != stationObsIndicesEnd; ++it) {
-    const size_t obsId = validObsIds.at(*it);
-    stationData.push_back(globalData[obsId]);
-    observationNumber++;
-  }
-  return stationData;
-}
-
 void StuckCheck::potentiallyRejectStreak(
-    std::vector<size_t>::const_iterator stationIndicesBegin,
-    std::vector<size_t>::const_iterator stationIndicesEnd,
-    const std::vector<size_t> &validObsIds,
+    const TrackCheckUtils::TrackStore &store,
+    size_t stationBegin, size_t stationEnd,
+    const std::vector<util::DateTime> &dateTimes,
     size_t startOfStreakIndex,
     size_t endOfStreakIndex,
     std::vector<bool> &isRejected,
     std::string stationId = "") const {
 
-  auto getObservationTime = [this, &stationIndicesBegin, &validObsIds] (
-      size_t offsetFromBeginning)->util::DateTime{
-    const size_t obsIndex = validObsIds.at(*(stationIndicesBegin + offsetFromBeginning));
-    return obsGroupDateTimes_->at(obsIndex);
+  auto getObservationTime = [&dateTimes, stationBegin] (
+      size_t offsetFromBeginning) -> const util::DateTime & {
+    return dateTimes[stationBegin + offsetFromBeginning];
   };
 
-  auto rejectObservation = [&validObsIds, &isRejected, &stationIndicesBegin, &stationId](
-      size_t observationIndex) {
-    const size_t obsIndex = validObsIds.at(*(stationIndicesBegin + observationIndex));
-    isRejected[obsIndex] = true;
+  auto rejectObservation = [&store, &isRejected, stationBegin](size_t observationIndex) {
+    isRejected[store.obsIds()[stationBegin + observationIndex]] = true;
   };
 
   const size_t streakLength = endOfStreakIndex - startOfStreakIndex + 1;
-  const size_t stationLength = stationIndicesEnd - stationIndicesBegin;
+  const size_t stationLength = stationEnd - stationBegin;
   size_t numberStuckTolerance;
   if (options_.core.percentageStuckTolerance.value()) {
     numberStuckTolerance =
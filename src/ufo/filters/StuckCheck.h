@@ -55,21 +55,18 @@ class StuckCheck: public FilterBase,
 
  private:
   Parameters_ options_;
-  // Instantiate object for accessing observations that may be held on multiple MPI ranks.
-  std::unique_ptr<std::vector<util::DateTime>> obsGroupDateTimes_;
 
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::track;}
-  std::vector<float> collectStationVariableData(
-      std::vector<size_t>::const_iterator stationObsIndicesBegin,
-      std::vector<size_t>::const_iterator stationObsIndicesEnd,
-      const std::vector<size_t> &validObsIds,
-      const std::vector<float> &globalData) const;
-  void potentiallyRejectStreak(std::vector<size_t>::const_iterator stationIndicesBegin,
-                               std::vector<size_t>::const_iterator stationIndicesEnd,
-                               const std::vector<size_t> &validObsIds,
+  /// \brief Flag the observations held at positions \p startOfStreakIndex to
+  /// \p endOfStreakIndex of the track store \p store if they form a streak long enough to be
+  /// rejected. \p stationBegin and \p stationEnd delimit the station's observations in the
+  /// store and \p dateTimes is the store's column of observation times.
+  void potentiallyRejectStreak(const TrackCheckUtils::TrackStore &store,
+                               size_t stationBegin, size_t stationEnd,
+                               const std::vector<util::DateTime> &dateTimes,
                                size_t startOfStreakIndex,
                                size_t endOfStreakIndex,
                                std::vector<bool> &isRejected,
@@ -9,7 +9,7 @@
 
 #include <algorithm>
 #include <cmath>
-#include <functional>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -22,6 +22,8 @@
 #include "oops/util/Logger.h"
 #include "ufo/filters/ObsAccessor.h"
 #include "ufo/filters/TemporalThinningParameters.h"
+#include "ufo/filters/TrackCheckUtils.h"
+#include "ufo/utils/EpochSeconds.h"
 #include "ufo/utils/RecordHandler.h"
 #include "ufo/utils/RecursiveSplitter.h"
 
@@ -29,275 +31,181 @@ namespace ufo {
 
 namespace {
 
-struct Observation {
-  size_t id;
-  util::DateTime time;
-  int priority = 0;
-};
+/// Number of seconds elapsed since a reference time.
+typedef std::int64_t TimeKey;
 
 /// \brief Responsible for the selection of observations to retain.
+///
+/// The times and priorities of the observations of each group are stored contiguously, in
+/// chronological order, so that each group is thinned by scanning a span of integers.
 class TemporalThinner {
  public:
-  TemporalThinner(const std::vector<size_t> &validObsIds,
-                  const std::vector<util::DateTime> &times,
+  /// \param store
+  ///   Index of the groups of observations to thin separately.
+  /// \param times
+  ///   Times of all observations (indexed like the arrays returned by the ObsAccessor).
+  /// \param priorities
+  ///   Priorities of all observations, or null if observations have no priorities.
+  /// \param seedTime
+  ///   Seed time (ignored unless the `seed_time` option is set).
+  TemporalThinner(const TrackCheckUtils::TrackStore &store,
+                  const std::vector<TimeKey> &times,
                   const std::vector<int> *priorities,
-                  const RecursiveSplitter &splitter,
+                  TimeKey seedTime,
                   const TemporalThinningParameters &options);
 
   std::vector<bool> identifyThinnedObservations(size_t totalNumObservations) const;
 
  private:
-  typedef std::vector<size_t>::const_iterator ForwardValidObsIndexIterator;
-  typedef std::vector<size_t>::const_reverse_iterator BackwardValidObsIndexIterator;
-
-  Observation getObservation(size_t validObsIndex) const {
-    Observation obs;
-    obs.id = validObsIds_[validObsIndex];
-    obs.time = times_[obs.id];
-    if (priorities_)
-      obs.priority = (*priorities_)[obs.id];
-    return obs;
-  }
-
-  util::DateTime getTime(size_t validObsIndex) const {
-    return times_[validObsIds_[validObsIndex]];
-  }
+  /// Thin the group of observations held at positions [\p begin, \p end) of the store.
+  void thinGroup(size_t begin, size_t end, std::vector<char> &isThinned) const;
 
-  int getPriority(size_t validObsIndex) const {
-    ASSERT(priorities_ != nullptr);
-    return (*priorities_)[validObsIds_[validObsIndex]];
-  }
+  /// Thin the observations held at positions \p first, \p first + \p step, ... (up to but
+  /// excluding \p last) of the store, where \p step is 1 when thinning forwards and -1 when
+  /// thinning backwards. The first observation to retain must be taken at or after (at or before)
+  /// \p deadline when thinning forwards (backwards).
+  void thinRange(std::ptrdiff_t first, std::ptrdiff_t last, std::ptrdiff_t step,
+                 TimeKey deadline, std::vector<char> &isThinned) const;
 
-  bool hasPriorities() const {
-    return priorities_ != nullptr;
-  }
+  /// Return the position of the first observation to be retained.
+  size_t findSeed(size_t begin, size_t end) const;
 
-  /// Thin the valid observations with indices from the specified range. The first observation
-  /// to retain must be taken at or after \p deadline.
-  void thinRangeForwards(ForwardValidObsIndexIterator validIndicesBegin,
-                         ForwardValidObsIndexIterator validIndicesEnd,
-                         util::DateTime deadline,
-                         std::vector<bool> &isThinned) const;
-
-  /// Thin the valid observations with indices from the specified range. The first observation
-  /// to retain must be taken at or before \p deadline.
-  void thinRangeBackwards(BackwardValidObsIndexIterator validIndicesBegin,
-                          BackwardValidObsIndexIterator validIndicesEnd,
-                          util::DateTime deadline,
-                          std::vector<bool> &isThinned) const;
-
-  /// \brief Common implementation shared by thinRangeForwards() and thinRangeBackwards().
-  ///
-  /// \tparam Iterator
-  ///   Iterator visiting indices of observations in chronological (reverse chronological) order
-  ///   when thinning forwards (backwards).
-  /// \tparam IsPast
-  ///   Binary functor taking two parameters of type util::DateTime and returning true if and only
-  ///   if the first argument is later (earlier) than the second when thinning forwards (backwards).
-  /// \tparam IsAtOrPast
-  ///   Binary functor taking two parameters of type util::DateTime and returning true if and only
-  ///   if the first argument is later (earlier) than or equal to the second when thinning forwards
-  ///   (backwards).
-  /// \tparam Advance
-  ///   Binary functor taking two parameters of types util::DateTime and util::Duration and
-  ///   returning the datetime obtained by adding (subtracting) the second argument to (from) the
-  ///   first argument when thinning forwards (backwards).
-  template <typename Iterator, typename IsPast, typename IsAtOrPast, typename Advance>
-  void thinRange(Iterator validIndicesBegin,
-                 Iterator validIndicesEnd,
-                 util::DateTime deadline,
-                 IsPast isPast,
-                 IsAtOrPast isAtOrPast,
-                 Advance advance,
-                 std::vector<bool> &isThinned) const;
-
-  /// Return an iterator to the first observation to be retained.
-  ForwardValidObsIndexIterator findSeed(
-      ForwardValidObsIndexIterator validObsIndicesBegin,
-      ForwardValidObsIndexIterator validObsIndicesEnd,
-      util::DateTime seedTime) const;
-
-  /// Return an iterator to the valid observation taken at a time closest to \p targetTime.
+  /// Return the position of the observation taken at a time closest to \p targetTime.
   /// In case of a tie, the later (more recent) observation is selected.
-  ForwardValidObsIndexIterator findNearest(
-      ForwardValidObsIndexIterator validObsIndicesBegin,
-      ForwardValidObsIndexIterator validObsIndicesEnd,
-      util::DateTime targetTime) const;
-
- private:
-  const std::vector<size_t> &validObsIds_;
-  const std::vector<util::DateTime> &times_;
-  const std::vector<int> *priorities_;
-  const RecursiveSplitter &splitter_;
+  size_t findNearest(size_t begin, size_t end, TimeKey targetTime) const;
+
+  const TrackCheckUtils::TrackStore &store_;
+  /// Times and priorities of the observations held at successive positions of the store.
+  std::vector<TimeKey> times_;
+  std::vector<int> priorities_;
+  bool hasPriorities_;
+  TimeKey seedTime_;
+  TimeKey minSpacing_;
+  TimeKey tolerance_;
   const TemporalThinningParameters &options_;
 };
 
-TemporalThinner::TemporalThinner(const std::vector<size_t> &validObsIds,
-                                 const std::vector<util::DateTime> &times,
+TemporalThinner::TemporalThinner(const TrackCheckUtils::TrackStore &store,
+                                 const std::vector<TimeKey> &times,
                                  const std::vector<int> *priorities,
-                                 const RecursiveSplitter &splitter,
+                                 TimeKey seedTime,
                                  const TemporalThinningParameters &options) :
-  validObsIds_(validObsIds),
-  times_(times),
-  priorities_(priorities),
-  splitter_(splitter),
+  store_(store),
+  times_(store.gather(times)),
+  priorities_(priorities ? store.gather(*priorities) : std::vector<int>(store.size(), 0)),
+  hasPriorities_(priorities != nullptr),
+  seedTime_(seedTime),
+  minSpacing_(options.minSpacing.value().toSeconds()),
+  tolerance_(options.tolerance.value().toSeconds()),
   options_(options)
 {}
 
 std::vector<bool> TemporalThinner::identifyThinnedObservations(size_t totalNumObservations) const {
-  std::vector<bool> isThinned(totalNumObservations, false);
-
-  for (RecursiveSplitter::Group group : splitter_.multiElementGroups()) {
-    if (options_.seedTime.value() == boost::none) {
-      util::DateTime deadline = getTime(*group.begin());
-      thinRangeForwards(group.begin(), group.end(), deadline, isThinned);
-    } else {
-      const ForwardValidObsIndexIterator seedIt = findSeed(
-            group.begin(), group.end(), *options_.seedTime.value());
-      Observation seed = getObservation(*seedIt);
-      {
-        util::DateTime deadline = seed.time + options_.minSpacing;
-        thinRangeForwards(seedIt + 1, group.end(), deadline, isThinned);
-      }
-      {
-        const BackwardValidObsIndexIterator seedRevIt(seedIt + 1);
-        const BackwardValidObsIndexIterator revEnd(group.begin());
-        util::DateTime deadline = seed.time - options_.minSpacing;
-        thinRangeBackwards(seedRevIt, revEnd, seed.time, isThinned);
-      }
-    }
-  }
+  // Groups are thinned concurrently, so decisions are recorded in a byte per position of the
+  // store rather than in a std::vector<bool>.
+  std::vector<char> isThinnedInStore(store_.size(), false);
+  const std::ptrdiff_t numGroups = store_.numTracks();
+#pragma omp parallel for schedule(dynamic)
+  for (std::ptrdiff_t group = 0; group < numGroups; ++group)
+    thinGroup(store_.begin(group), store_.end(group), isThinnedInStore);
 
+  std::vector<bool> isThinned(totalNumObservations, false);
+  for (size_t pos = 0; pos < store_.size(); ++pos)
+    if (isThinnedInStore[pos])
+      isThinned[store_.obsIds()[pos]] = true;
   return isThinned;
 }
 
-void TemporalThinner::thinRangeForwards(ForwardValidObsIndexIterator validIndicesBegin,
-                                        ForwardValidObsIndexIterator validIndicesEnd,
-                                        util::DateTime deadline,
-                                        std::vector<bool> &isThinned) const {
-  thinRange(validIndicesBegin, validIndicesEnd, deadline,
-            std::greater<util::DateTime>(),
-            std::greater_equal<util::DateTime>(),
-            // Unfortunately in C++11 std::plus requires both arguments to be of the same type
-            [](const util::DateTime &time, const util::Duration &offset) { return time + offset; },
-            isThinned);
-}
-
-void TemporalThinner::thinRangeBackwards(
-    BackwardValidObsIndexIterator validIndicesBegin,
-    BackwardValidObsIndexIterator validIndicesEnd,
-    util::DateTime deadline,
-    std::vector<bool> &isThinned) const {
-  thinRange(validIndicesBegin, validIndicesEnd, deadline,
-            std::less<util::DateTime>(),
-            std::less_equal<util::DateTime>(),
-            [](const util::DateTime &time, const util::Duration &offset) { return time - offset; },
-            isThinned);
+void TemporalThinner::thinGroup(size_t begin, size_t end, std::vector<char> &isThinned) const {
+  if (options_.seedTime.value() == boost::none) {
+    thinRange(begin, end, 1, times_[begin], isThinned);
+  } else {
+    const size_t seed = findSeed(begin, end);
+    thinRange(seed + 1, end, 1, times_[seed] + minSpacing_, isThinned);
+    // Thinning backwards starts from the seed itself, which is therefore retained.
+    thinRange(seed, static_cast<std::ptrdiff_t>(begin) - 1, -1, times_[seed], isThinned);
+  }
 }
 
-template <typename Iterator, typename IsPast, typename IsAtOrPast, typename Advance>
-void TemporalThinner::thinRange(Iterator validIndicesBegin,
-                                Iterator validIndicesEnd,
-                                util::DateTime deadline,
-                                IsPast isPast,
-                                IsAtOrPast isAtOrPast,
-                                Advance advance,
-                                std::vector<bool> &isThinned) const {
-  boost::optional<Observation> best;
-  for (Iterator it = validIndicesBegin; it != validIndicesEnd; ++it) {
-    const size_t validObsIndex = *it;
-    Observation current = getObservation(validObsIndex);
-    if (best != boost::none) {
+void TemporalThinner::thinRange(std::ptrdiff_t first, std::ptrdiff_t last, std::ptrdiff_t step,
+                                TimeKey deadline, std::vector<char> &isThinned) const {
+  // Multiplying times by `step` reduces thinning backwards to thinning forwards.
+  deadline *= step;
+  bool haveBest = false;
+  std::ptrdiff_t best = 0;
+  for (std::ptrdiff_t current = first; current != last; current += step) {
+    const TimeKey currentTime = step * times_[current];
+    if (haveBest) {
       // We're looking for a higher-priority observation at or before the deadline
-      if (isPast(current.time, deadline)) {
+      if (currentTime > deadline) {
         // We haven't found one
-        deadline = advance(best->time, options_.minSpacing);
-        best = boost::none;
+        deadline = step * times_[best] + minSpacing_;
+        haveBest = false;
         // The decision whether to thin 'current' will be taken in the next if statement
       } else {
-        if (current.priority > best->priority) {
-          isThinned[best->id] = true;
+        if (priorities_[current] > priorities_[best]) {
+          isThinned[best] = true;
           best = current;
         } else {
-          isThinned[current.id] = true;
+          isThinned[current] = true;
         }
       }
     }
 
-    if (best == boost::none) {
+    if (!haveBest) {
       // We're looking for an observation at or after the deadline
-      if (isAtOrPast(current.time, deadline)) {
+      if (currentTime >= deadline) {
+        haveBest = true;
         best = current;
-        deadline = advance(best->time, options_.tolerance);
+        deadline = currentTime + tolerance_;
       } else {
-        isThinned[current.id] = true;
+        isThinned[current] = true;
       }
     }
   }
 }
 
-typename TemporalThinner::ForwardValidObsIndexIterator TemporalThinner::findSeed(
-    ForwardValidObsIndexIterator validObsIndicesBegin,
-    ForwardValidObsIndexIterator validObsIndicesEnd,
-    util::DateTime seedTime) const {
-  const ForwardValidObsIndexIterator nearestToSeedIt = findNearest(
-        validObsIndicesBegin, validObsIndicesEnd, seedTime);
-  if (!hasPriorities()) {
-    return nearestToSeedIt;
+size_t TemporalThinner::findSeed(size_t begin, size_t end) const {
+  const size_t nearestToSeed = findNearest(begin, end, seedTime_);
+  if (!hasPriorities_) {
+    return nearestToSeed;
   }
 
-  util::DateTime nearestToSeedTime = getObservation(*nearestToSeedIt).time;
-
-  ForwardValidObsIndexIterator acceptableBegin = std::lower_bound(
-        validObsIndicesBegin, nearestToSeedIt,
-        nearestToSeedTime - options_.tolerance,
-        [&](size_t validObsIndexA, const util::DateTime &timeB)
-        { return getTime(validObsIndexA) < timeB; });
-  ForwardValidObsIndexIterator acceptableEnd = std::upper_bound(
-        acceptableBegin, validObsIndicesEnd,
-        nearestToSeedTime + options_.tolerance,
-        [&](const util::DateTime &timeA, size_t validObsIndexB)
-        { return timeA < getTime(validObsIndexB); });
+  const TimeKey nearestToSeedTime = times_[nearestToSeed];
+  const size_t acceptableBegin = std::lower_bound(
+        times_.begin() + begin, times_.begin() + nearestToSeed,
+        nearestToSeedTime - tolerance_) - times_.begin();
+  const size_t acceptableEnd = std::upper_bound(
+        times_.begin() + acceptableBegin, times_.begin() + end,
+        nearestToSeedTime + tolerance_) - times_.begin();
 
   // Find the element with highest priority in the acceptable range.
-  return std::max_element(acceptableBegin, acceptableEnd,
-                          [&](size_t validObsIndexA, size_t validObsIndexB)
-                          { return getPriority(validObsIndexA) < getPriority(validObsIndexB); });
+  return std::max_element(priorities_.begin() + acceptableBegin,
+                          priorities_.begin() + acceptableEnd) - priorities_.begin();
 }
 
-typename TemporalThinner::ForwardValidObsIndexIterator TemporalThinner::findNearest(
-    ForwardValidObsIndexIterator validObsIndicesBegin,
-    ForwardValidObsIndexIterator validObsIndicesEnd,
-    util::DateTime targetTime) const {
-  ASSERT_MSG(validObsIndicesEnd - validObsIndicesBegin != 0,
-             "The range of observation indices must not be empty");
-
-  auto isEarlierThan = [&](size_t validObsIndexA, const util::DateTime &timeB) {
-    return getTime(validObsIndexA) < timeB;
-  };
-  const ForwardValidObsIndexIterator firstGreaterOrEqualToTargetIt =
-      std::lower_bound(validObsIndicesBegin, validObsIndicesEnd, targetTime, isEarlierThan);
-  if (firstGreaterOrEqualToTargetIt == validObsIndicesBegin) {
-    return firstGreaterOrEqualToTargetIt;
+size_t TemporalThinner::findNearest(size_t begin, size_t end, TimeKey targetTime) const {
+  ASSERT_MSG(end != begin, "The range of observation indices must not be empty");
+
+  const size_t firstGreaterOrEqualToTarget = std::lower_bound(
+        times_.begin() + begin, times_.begin() + end, targetTime) - times_.begin();
+  if (firstGreaterOrEqualToTarget == begin) {
+    return firstGreaterOrEqualToTarget;
   }
-  if (firstGreaterOrEqualToTargetIt == validObsIndicesEnd) {
-    // All observations were taken before targetTime. Return the iterator pointing to the
-    // last valid element of the range.
-    return validObsIndicesEnd - 1;
+  if (firstGreaterOrEqualToTarget == end) {
+    // All observations were taken before targetTime. Return the position of the last
+    // observation of the range.
+    return end - 1;
   }
 
-  const ForwardValidObsIndexIterator lastLessThanTargetIt =
-      firstGreaterOrEqualToTargetIt - 1;
-
-  Observation firstGreaterOrEqualToTarget = getObservation(*firstGreaterOrEqualToTargetIt);
-  Observation lastLessThanTarget = getObservation(*lastLessThanTargetIt);
+  const size_t lastLessThanTarget = firstGreaterOrEqualToTarget - 1;
 
   // Prefer the later observation if there's a tie
-  if ((firstGreaterOrEqualToTarget.time - targetTime).toSeconds() <=
-      (targetTime - lastLessThanTarget.time).toSeconds()) {
-    return firstGreaterOrEqualToTargetIt;
+  if (times_[firstGreaterOrEqualToTarget] - targetTime <=
+      targetTime - times_[lastLessThanTarget]) {
+    return firstGreaterOrEqualToTarget;
   } else {
-    return lastLessThanTargetIt;
+    return lastLessThanTarget;
   }
 }
 
@@ -325,7 +233,7 @@ void TemporalThinning::applyFilter(const std::vector<bool> & apply,
   // returns what it has been passed without modification.
   // The value of `retainOnlyIfAllFilterVariablesAreValid`  is set to `false`
   // because that is the default value used in the `ObsAccessor` class.
-  const RecordHandler recordHandler(obsdb_, filtervars, *flags_, false);
+  const RecordHandler recordHandler(obsdb_, filtervars, *flags_, false, &data_);
 
   // If records are treated as single obs and a category variable is also used,
   // ensure that there are no records with multiple values of the category variable.
@@ -361,7 +269,7 @@ ObsAccessor TemporalThinning::createObsAccessor() const {
     }
   } else if (options_.categoryVariable.value() != boost::none) {
     return ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
-          obsdb_, *options_.categoryVariable.value() );
+          obsdb_, *options_.categoryVariable.value(), options_.redistributeByCategory);
   } else if (!obsdb_.obs_group_vars().empty()) {
     // Records exist. Thin each record separately.
     return ObsAccessor::toObservationsSplitIntoIndependentGroupsByRecordId(obsdb_);
@@ -380,14 +288,23 @@ std::vector<bool> TemporalThinning::identifyThinnedObservations(
 
   RecursiveSplitter splitter = obsAccessor.splitObservationsIntoIndependentGroups(validObsIds);
 
-  std::vector<util::DateTime> times = obsAccessor.getDateTimeVariableFromObsSpace(
+  // Convert times to integers once; all subsequent comparisons are made between these integers.
+  const util::DateTime referenceTime = obsdb_.windowStart();
+  const EpochSeconds referenceSeconds = toEpochSeconds(referenceTime);
+  const std::vector<EpochSeconds> times = obsAccessor.getEpochSecondsVariableFromObsSpace(
         "MetaData", "dateTime");
-  splitter.sortGroupsBy([&times, &validObsIds](size_t obsIndex)
-                        { return times[validObsIds[obsIndex]]; });
+  std::vector<TimeKey> timeKeys(times.size());
+  for (size_t i = 0; i < times.size(); ++i)
+    timeKeys[i] = times[i] - referenceSeconds;
+  splitter.sortGroupsBy([&timeKeys, &validObsIds](size_t obsIndex)
+                        { return timeKeys[validObsIds[obsIndex]]; });
+  const TrackCheckUtils::TrackStore store(splitter, validObsIds);
 
   boost::optional<std::vector<int>> priorities = getObservationPriorities(obsAccessor);
 
-  TemporalThinner thinner(validObsIds, times, priorities.get_ptr(), splitter, options_);
+  const TimeKey seedTime = options_.seedTime.value() == boost::none ? 0 :
+      (*options_.seedTime.value() - referenceTime).toSeconds();
+  TemporalThinner thinner(store, timeKeys, priorities.get_ptr(), seedTime, options_);
   return thinner.identifyThinnedObservations(times.size());
 }
 
@@ -57,6 +57,13 @@ class TemporalThinningParameters : public FilterParametersBase {
   /// each record must contain only one value of the category variable.
   oops::OptionalParameter<Variable> categoryVariable{"category_variable", this};
 
+  /// If true and \c category_variable was not used to group observations into records, the
+  /// observations in each category are sent to a single MPI rank (chosen by hashing the value of
+  /// the category variable) and thinned there, instead of being gathered on all ranks.
+  ///
+  /// Ignored if \c category_variable is not set or \c records_are_single_obs is true.
+  oops::Parameter<bool> redistributeByCategory{"redistribute_by_category", false, this};
+
   /// Variable storing observation priorities. Used together with \c tolerance; see the
   /// documentation of that parameter for more information.
   oops::OptionalParameter<Variable> priorityVariable{"priority_variable", this};
@@ -112,7 +112,8 @@ void TrackCheck::applyFilter(const std::vector<bool> & apply,
   // 3rd arg: recordsAreSingleObs = false for Track Check.
   ObsAccessor obsAccessor = TrackCheckUtils::createObsAccessor(options_.stationIdVariable,
                                                                obsdb_,
-                                                               false);
+                                                               false,
+                                                               options_.redistributeByStationId);
 
   const std::vector<size_t> validObsIds
                                    = obsAccessor.getValidObservationIds(apply, *flags_, filtervars);
@@ -14,6 +14,7 @@
 #include <cmath>
 #include <functional>
 #include <map>
+#include <numeric>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -54,16 +55,17 @@ TrackCheckShip::TrackCheckShip(ioda::ObsSpace &obsdb, const Parameters_ &paramet
 
 /// \brief Estimate of speed as calculated in Ops_CheckShipTrack.
 ///
-/// Speed is calculated between \p obs1 and \p obs2, accounting for spatial/temporal
-/// uncertainty using the resolution values stored in \p options.
+/// Speed is calculated between the observations held at positions \p obs1 and \p obs2 of the
+/// track store, accounting for spatial/temporal uncertainty using the resolution values stored
+/// in \p options.
 double TrackCheckShip::speedEstimate(
-    const TrackCheckShip::TrackObservation &obs1,
-    const TrackCheckShip::TrackObservation &obs2,
+    const std::vector<TrackCheckUtils::Point> &locations,
+    const std::vector<util::DateTime> &times,
+    size_t obs1, size_t obs2,
     const TrackCheckShipParameters& options) {
-  util::Duration temporalDistance = abs(obs1.getTime() -
-                                        obs2.getTime());
+  util::Duration temporalDistance = abs(times[obs1] - times[obs2]);
   util::Duration tempRes = options.core.temporalResolution;
-  auto dist = distance(obs1, obs2);
+  auto dist = distance(locations, obs1, obs2);
   auto spatialRes = options.core.spatialResolution;
   double speedEst = 0.0;
   if (dist > spatialRes) {
@@ -78,12 +80,11 @@ double TrackCheckShip::speedEstimate(
 /// \brief Returns the angle in degrees (rounded to the nearest .1 degree)
 /// between displacement vectors going from observations \p a to \p b
 /// and \p b to \p c.
-float TrackCheckShip::angle(const TrackCheckShip::TrackObservation &a,
-                            const TrackCheckShip::TrackObservation &b,
-                            const TrackCheckShip::TrackObservation &c) {
-  auto locA = a.getLocation();
-  auto locB = b.getLocation();
-  auto locC = c.getLocation();
+float TrackCheckShip::angle(const std::vector<TrackCheckUtils::Point> &locations,
+                            size_t a, size_t b, size_t c) {
+  const auto &locA = locations[a];
+  const auto &locB = locations[b];
+  const auto &locC = locations[c];
   Eigen::Vector3f disp1{locB[0]-locA[0], locB[1]-locA[1], locB[2]-locA[2]};
   Eigen::Vector3f disp2{locC[0]-locB[0], locC[1]-locB[1], locC[2]-locB[2]};
   auto CosAngle = disp1.dot(disp2) / (disp1.norm() * disp2.norm());
@@ -98,46 +99,18 @@ const TrackCheckShipDiagnostics* TrackCheckShip::diagnostics() const
   return diagnostics_.get();
 }
 
-TrackCheckShip::TrackObservation::TrackObservation(
-    double latitude, double longitude,
-    const util::DateTime &time,
-    std::shared_ptr<TrackStatistics> const& ts,
-    std::shared_ptr<TrackCheckUtils::CheckCounter> const &checkCounter,
-    size_t observationNumber)
-  : obsLocationTime_(latitude, longitude, time), fullTrackStatistics_(ts),
-    observationNumber_(observationNumber), rejected_(false) {}
-
-size_t TrackCheckShip::TrackObservation::getObservationNumber() const
-{
-  return observationNumber_;
-}
+TrackCheckShip::TrackColumns::TrackColumns(
+    const TrackCheckUtils::TrackStore &store,
+    const TrackCheckUtils::ObsGroupLocationTimes &obsLocTime)
+  : locations(TrackCheckUtils::TrackStore::cartesianLocations(
+                store.gather(obsLocTime.latitudes), store.gather(obsLocTime.longitudes))),
+    times(store.gather(obsLocTime.datetimes)),
+    statistics(store.size()), rejected(store.size(), false) {}
 
 // Required for the correct destruction of options_.
 TrackCheckShip::~TrackCheckShip()
 {}
 
-/// Detects whether each observation in a track has been rejected, and marks
-/// the corresponding space in \p isRejected as true if so.
-/// \param trackObsIndicesBegin the begin iterator of the track
-/// \param trackObsIndicesEnd the end iterator
-/// \param validObsIds the vector marking all of the observations' global
-/// positions
-/// \param trackObservations the full vector of observations within
-/// the single track
-/// \param isRejected the boolean vector whose indices correspond to all of
-/// the rejected observations in the full input dataset
-void TrackCheckShip::flagRejectedTrackObservations(
-    std::vector<size_t>::const_iterator trackObsIndicesBegin,
-    std::vector<size_t>::const_iterator trackObsIndicesEnd,
-    const std::vector<size_t> &validObsIds,
-    const std::vector<TrackObservation> &trackObservations,
-    std::vector<bool> &isRejected) const {
-  auto trackObsIndexIt = trackObsIndicesBegin;
-  auto trackObsIt = trackObservations.begin();
-  for (; trackObsIndexIt != trackObsIndicesEnd; ++trackObsIndexIt, ++trackObsIt)
-    isRejected[validObsIds[*trackObsIndexIt]] = trackObsIt->rejected();
-}
-
 void TrackCheckShip::print(std::ostream & os) const {
   os << "TrackCheckShip: config = " << options_ << std::endl;
 }
@@ -166,14 +139,15 @@ void TrackCheckShip::applyFilter(const std::vector<bool> & apply,
                                  std::vector<std::vector<bool>> & flagged) const {
   ObsAccessor obsAccessor = TrackCheckUtils::createObsAccessor(options_.stationIdVariable,
                                                                obsdb_,
-                                                               options_.recordsAreSingleObs);
+                                                               options_.recordsAreSingleObs,
+                                                               options_.redistributeByStationId);
 
   // The RecordHandler deals with data that have been grouped into records.
   // If the grouping has not been performed then each RecordHandler function simply
   // returns what it has been passed without modification.
   // The value of `retainOnlyIfAllFilterVariablesAreValid` is set to `false`
   // because that is the default value used in the `ObsAccessor` class.
-  const RecordHandler recordHandler(obsdb_, filtervars, *flags_, false);
+  const RecordHandler recordHandler(obsdb_, filtervars, *flags_, false, &data_);
 
   const std::vector<size_t> validObsIds =
     obsAccessor.getValidObservationIds(options_.recordsAreSingleObs ?
@@ -186,95 +160,70 @@ void TrackCheckShip::applyFilter(const std::vector<bool> & apply,
 
   TrackCheckUtils::ObsGroupLocationTimes obsLocTime =
       TrackCheckUtils::collectObservationsLocations(obsAccessor);
+  const TrackCheckUtils::TrackStore store(splitter, validObsIds);
+  TrackColumns columns(store, obsLocTime);
 
   std::vector<bool> isRejected(obsLocTime.latitudes.size(), false);
-  size_t trackNumber = 0;
-  for (auto track : splitter.multiElementGroups()) {
-    trackNumber++;
-    std::string stationId = std::to_string(trackNumber);
-    std::vector<TrackObservation> trackObservations = collectTrackObservations(
-          track.begin(), track.end(), validObsIds, obsLocTime);
-    std::vector<std::reference_wrapper<TrackObservation>> trackObservationsReferences;
-    trackObservationsReferences.reserve(trackObservations.size());
-    std::transform(trackObservations.begin(), trackObservations.end(),
-                   std::back_inserter(trackObservationsReferences),
-                   [](TrackObservation &obs) {
-      return std::ref<TrackObservation>(obs); });
-    calculateTrackSegmentProperties(trackObservationsReferences,
+  // Positions in the track store of the accepted observations of the current track
+  std::vector<size_t> track;
+  for (size_t trackIndex = 0; trackIndex < store.numTracks(); ++trackIndex) {
+    std::string stationId = std::to_string(trackIndex + 1);
+    const size_t trackBegin = store.begin(trackIndex);
+    const size_t trackEnd = store.end(trackIndex);
+    const size_t trackSize = trackEnd - trackBegin;
+    track.resize(trackSize);
+    std::iota(track.begin(), track.end(), trackBegin);
+    TrackStatistics trackStatistics;
+    calculateTrackSegmentProperties(track, columns, trackStatistics,
                                     CalculationMethod::FIRSTITERATION);
-    if (!trackObservationsReferences.empty() &&
+    if (!track.empty() &&
         this->options_.core.earlyBreakCheck &&
-        TrackCheckShip::earlyBreak(trackObservationsReferences, stationId)) {
+        TrackCheckShip::earlyBreak(track.size(), trackStatistics, stationId)) {
       continue;
     }
       bool firstIterativeRemoval = true;
-      while (trackObservationsReferences.size() >= 3) {
+      while (track.size() >= 3) {
         // Initial loop: fastest (as determined by set of comparisons) observation removed
         // until all segments show slower speed than max threshold
-        auto maxSpeedReferenceIterator = std::max_element(
-              trackObservationsReferences.begin(), trackObservationsReferences.end(),
-              [](TrackObservation a, TrackObservation b) {
-            return a.getObservationStatistics().speed <
-            b.getObservationStatistics().speed;});
-        auto maxSpeedValue = maxSpeedReferenceIterator->get().getObservationStatistics().speed;
+        auto maxSpeedIterator = std::max_element(
+              track.begin(), track.end(),
+              [&columns](size_t a, size_t b) {
+            return columns.statistics[a].speed < columns.statistics[b].speed;});
+        auto maxSpeedValue = columns.statistics[*maxSpeedIterator].speed;
         if (maxSpeedValue <= (0.8 * options_.core.maxSpeed.value())) {
           break;
         } else if (maxSpeedValue < options_.core.maxSpeed.value()) {
           auto maxSpeedAngle = std::max(
-                (maxSpeedReferenceIterator - 1)->get().getObservationStatistics().angle,
-                maxSpeedReferenceIterator->get().getObservationStatistics().angle);
+                columns.statistics[*(maxSpeedIterator - 1)].angle,
+                columns.statistics[*maxSpeedIterator].angle);
           if (maxSpeedAngle <= 90.0) {
             break;
           }
         }
         removeFaultyObservation(
-              trackObservationsReferences, maxSpeedReferenceIterator, firstIterativeRemoval,
-              stationId);
+              track, maxSpeedIterator - track.begin(), trackBegin, columns, trackStatistics,
+              firstIterativeRemoval, stationId);
         firstIterativeRemoval = false;
-        calculateTrackSegmentProperties(trackObservationsReferences, CalculationMethod::MAINLOOP);
+        calculateTrackSegmentProperties(track, columns, trackStatistics,
+                                        CalculationMethod::MAINLOOP);
       }
-      auto rejectedCount = std::count_if(trackObservations.begin(), trackObservations.end(),
-                    [](const TrackObservation& a) {return a.rejected();});
-      if (rejectedCount >= options_.core.rejectionThreshold.value() * trackObservations.size()) {
+      auto rejectedCount = std::count(columns.rejected.begin() + trackBegin,
+                                      columns.rejected.begin() + trackEnd, true);
+      if (rejectedCount >= options_.core.rejectionThreshold.value() * trackSize) {
         oops::Log::trace() << "CheckShipTrack: track " << stationId << " NumRej " <<
-                              rejectedCount << " out of " << trackObservations.size() <<
+                              rejectedCount << " out of " << trackSize <<
                               " reports rejected. *** Reject whole track ***\n";
-        for (TrackObservation &obs : trackObservations)
-          obs.setRejected(true);
+        std::fill(columns.rejected.begin() + trackBegin,
+                  columns.rejected.begin() + trackEnd, true);
       }
-      flagRejectedTrackObservations(track.begin(), track.end(),
-                                    validObsIds, trackObservations, isRejected);
+      for (size_t obs = trackBegin; obs < trackEnd; ++obs)
+        isRejected[store.obsIds()[obs]] = columns.rejected[obs];
   }
   obsAccessor.flagRejectedObservations(options_.recordsAreSingleObs ?
     recordHandler.changeThinnedIfRecordsAreSingleObs(isRejected) : isRejected,
     flagged);
 }
 
-/// \returns a \p vector of \p TrackObservations that all hold a \p shared_ptr to an instance
-/// of \p TrackStatistics, which holds all of the track-specific counters.
-std::vector<TrackCheckShip::TrackObservation> TrackCheckShip::collectTrackObservations(
-    std::vector<size_t>::const_iterator trackObsIndicesBegin,
-    std::vector<size_t>::const_iterator trackObsIndicesEnd,
-    const std::vector<size_t> &validObsIds,
-    const TrackCheckUtils::ObsGroupLocationTimes &obsLocTime) const {
-  std::vector<TrackObservation> trackObservations;
-  trackObservations.reserve(trackObsIndicesEnd - trackObsIndicesBegin);
-  std::shared_ptr<TrackStatistics> trackStatistics(new TrackStatistics());
-  std::shared_ptr<TrackCheckUtils::CheckCounter> checkCounter(new TrackCheckUtils::CheckCounter);
-  size_t observationNumber = 0;
-  for (std::vector<size_t>::const_iterator it = trackObsIndicesBegin;
-       it != trackObsIndicesEnd; ++it) {
-    const size_t obsId = validObsIds[*it];
-    trackObservations.push_back(TrackObservation(obsLocTime.latitudes[obsId],
-                                                 obsLocTime.longitudes[obsId],
-                                                 obsLocTime.datetimes[obsId], trackStatistics,
-                                                 checkCounter,
-                                                 observationNumber));
-    observationNumber++;
-  }
-  return trackObservations;
-}
-
 /// \brief \returns true if at least half of the track segments have
 /// incremented the relevant rejection counters
 ///
@@ -285,22 +234,21 @@ std::vector<TrackCheckShip::TrackObservation> TrackCheckShip::collectTrackObserv
 /// Sometimes caused by two ships with same callsign or various reports with wrong time,
 /// the check gives up. This is particularly a problem with WOD01 data - case studies
 /// suggest that most suspect data is reasonable.
-bool TrackCheckShip::earlyBreak(const std::vector<std::reference_wrapper<TrackObservation>>
-                                &trackObs, const std::string trackId) const {
+bool TrackCheckShip::earlyBreak(size_t trackSize, const TrackStatistics &trackStats,
+                                const std::string trackId) const {
   bool breakResult = false;
-  const auto& trackStats = *(trackObs[0].get().getFullTrackStatistics());
   // if at least half of the track segments have a time difference of less than an hour
   // (if non-buoy), are faster than a configured maximum speed, or exhibit at least a 90
   // degree bend
   if ((2 * ((options_.inputCategory.value() != SurfaceObservationSubtype::BUOY &&
              options_.inputCategory.value() != SurfaceObservationSubtype::BUOYPROF)
             * trackStats.numShort_ + trackStats.numFast_) + trackStats.numBends_)
-      >= (trackObs.size() - 1)) {
+      >= (trackSize - 1)) {
     oops::Log::trace() << "ShipTrackCheck: " << trackId << "\n" <<
                           "Time difference < 1 hour: " << trackStats.numShort_ << "\n" <<
                           "Fast: " << trackStats.numFast_ << "\n" <<
                           "Bends: " << trackStats.numBends_ << "\n" <<
-                          "Total observations: " << trackObs.size() << "\n" <<
+                          "Total observations: " << trackSize << "\n" <<
                           "Track was not checked." << std::endl;
 
     breakResult = true;
@@ -310,106 +258,107 @@ bool TrackCheckShip::earlyBreak(const std::vector<std::reference_wrapper<TrackOb
   return breakResult;
 }
 
-/// \brief Chooses which of the observations surrounding the speediest segment to remove,
-/// flagging it accordingly.
 void TrackCheckShip::removeFaultyObservation(
-    std::vector<std::reference_wrapper<TrackObservation>> &track,
-    const std::vector<std::reference_wrapper<TrackObservation>>::iterator
-    &observationAfterFastestSegment,
+    std::vector<size_t> &track, size_t observationAfterFastestSegment,
+    size_t trackBegin, TrackColumns &columns, const TrackStatistics &trackStatistics,
     bool firstIterativeRemoval, const std::string trackId) const {
   int errorCategory = 0;
   util::Duration four_days{"P4D"};
-  auto rejectedObservation = observationAfterFastestSegment;
+  const size_t fastest = observationAfterFastestSegment;
+  size_t rejectedObservation = fastest;
   // lambda function to "fail" an observation that should be rejected
-  auto fail = [&rejectedObservation](
-      const std::vector<std::reference_wrapper<TrackObservation>>::iterator &iter) {
-    iter->get().setRejected(true);
-    rejectedObservation = iter;
+  auto fail = [&track, &columns, &rejectedObservation](size_t index) {
+    columns.rejected[track[index]] = true;
+    rejectedObservation = index;
   };
-  auto neighborObservationStatistics = [&observationAfterFastestSegment](int index) ->
+  auto neighborObservationStatistics = [&track, &columns, fastest](int index) ->
       const ObservationStatistics & {
-    return (observationAfterFastestSegment + index)->get().getObservationStatistics();
+    return columns.statistics[track[fastest + index]];
+  };
+  // the number of an observation within its full track
+  auto observationNumber = [&track, trackBegin](size_t index) {
+    return track[index] - trackBegin;
   };
-  auto meanSpeed = observationAfterFastestSegment->get().getFullTrackStatistics()->meanSpeed_;
-  if (observationAfterFastestSegment == track.begin() + 1) {
+  auto observationTime = [&track, &columns](size_t index) -> const util::DateTime & {
+    return columns.times[track[index]];
+  };
+  auto meanSpeed = trackStatistics.meanSpeed_;
+  if (fastest == 1) {
     // Decide whether ob 0 or 1 agrees best with ob 2
     if (neighborObservationStatistics(0).speedAveraged <=
         options_.core.maxSpeed &&
         (neighborObservationStatistics(1).speed >
          options_.core.maxSpeed ||
          neighborObservationStatistics(1).angle > 45.0)) {
-      fail(observationAfterFastestSegment);
+      fail(fastest);
       errorCategory = 2;
     } else {
-      fail(observationAfterFastestSegment - 1);
+      fail(fastest - 1);
       errorCategory = 1;
     }
-  } else if (observationAfterFastestSegment == track.end() - 1) {
+  } else if (fastest == track.size() - 1) {
     if (neighborObservationStatistics(-1).speedAveraged <=
         options_.core.maxSpeed &&
         (neighborObservationStatistics(-1).speed >
          options_.core.maxSpeed ||
          neighborObservationStatistics(-2).angle > 45.0)) {
-      fail(observationAfterFastestSegment - 1);
+      fail(fastest - 1);
       errorCategory = 2;
     } else {
-      fail(observationAfterFastestSegment);
+      fail(fastest);
       errorCategory = 1;
     }
   } else if (neighborObservationStatistics(-1).speed >
              options_.core.maxSpeed) {
-    fail(observationAfterFastestSegment - 1);
+    fail(fastest - 1);
     errorCategory = 4;
     //  Category 4: both segments surrounding observation have excessive speed
   } else if (neighborObservationStatistics(1).speed >
              options_.core.maxSpeed) {
-    fail(observationAfterFastestSegment);
+    fail(fastest);
     errorCategory = 4;
   } else if (neighborObservationStatistics(0).speedAveraged >
              options_.core.maxSpeed) {
-    fail(observationAfterFastestSegment - 1);
+    fail(fastest - 1);
     errorCategory = 5;
     // Category 5: observation before fastest segment would still begin a fast segment
     // if observation after fastest segment were removed
   } else if (neighborObservationStatistics(-1).speedAveraged >
              options_.core.maxSpeed) {
-    fail(observationAfterFastestSegment);
+    fail(fastest);
     errorCategory = 5;
     // Category 5: observation after fastest segment would still end a fast segment if
     // observation before fastest segment were removed
   } else if (neighborObservationStatistics(-1).angle >
              (45.0 + neighborObservationStatistics(0).angle)) {
-    fail(observationAfterFastestSegment - 1);
+    fail(fastest - 1);
     errorCategory = 6;
   } else if (neighborObservationStatistics(0).angle >
              45.0 + neighborObservationStatistics(-1).angle) {
-    fail(observationAfterFastestSegment);
+    fail(fastest);
     errorCategory = 6;
   } else if (neighborObservationStatistics(-2).angle > 45.0 &&
              neighborObservationStatistics(-2).angle >
              neighborObservationStatistics(1).angle) {
-    fail(observationAfterFastestSegment - 1);
+    fail(fastest - 1);
     errorCategory = 7;
   } else if (neighborObservationStatistics(1).angle > 45.0) {
-    fail(observationAfterFastestSegment);
+    fail(fastest);
     errorCategory = 7;
   } else if (neighborObservationStatistics(-1).speed <
              0.5 * std::min(
                neighborObservationStatistics(1).speed,
                meanSpeed)) {
-    fail(observationAfterFastestSegment - 1);
+    fail(fastest - 1);
     errorCategory = 8;
   } else if (neighborObservationStatistics(1).speed <
              0.5 * std::min(neighborObservationStatistics(-1).speed, meanSpeed)) {
-    fail(observationAfterFastestSegment);
+    fail(fastest);
     errorCategory = 8;
   } else {
     double distanceSum = 0.0;
-    distanceSum = std::accumulate(observationAfterFastestSegment - 1,
-                    observationAfterFastestSegment + 2, distanceSum,
-                    [](double summed, TrackObservation& obs) {
-      return summed + obs.getObservationStatistics().distance;
-    });
+    for (int index = -1; index <= 1; ++index)
+      distanceSum += neighborObservationStatistics(index).distance;
 
     double distancePrevObsOmitted =
           neighborObservationStatistics(-1).distanceAveraged +
@@ -417,8 +366,7 @@ void TrackCheckShip::removeFaultyObservation(
     double distanceCurrentObsOmitted =
           neighborObservationStatistics(-1).distance +
         neighborObservationStatistics(0).distanceAveraged;
-    util::Duration timeSum = (observationAfterFastestSegment + 1)->get().getTime() - (
-          observationAfterFastestSegment - 2)->get().getTime();
+    util::Duration timeSum = observationTime(fastest + 1) - observationTime(fastest - 2);
     if (options_.testingMode.value()) {
       diagnostics_->storeDistanceSum(distanceSum);
       diagnostics_->storeDistancePrevObsOmitted(distancePrevObsOmitted);
@@ -428,12 +376,12 @@ void TrackCheckShip::removeFaultyObservation(
     }
     if (distancePrevObsOmitted < distanceCurrentObsOmitted - std::max(
           options_.core.spatialResolution.value(), 0.1 * distanceSum)) {
-      fail(observationAfterFastestSegment - 1);
+      fail(fastest - 1);
       errorCategory = 9;
     } else if (distanceCurrentObsOmitted < (
                  distancePrevObsOmitted - std::max(
                    options_.core.spatialResolution.value(), 0.1 * distanceSum))) {
-      fail(observationAfterFastestSegment);
+      fail(fastest);
       errorCategory = 9;
     } else if (timeSum <= four_days && timeSum.toSeconds() > 0 &&
                std::min(distancePrevObsOmitted, distanceCurrentObsOmitted) > 0.0) {
@@ -446,12 +394,12 @@ void TrackCheckShip::removeFaultyObservation(
           neighborObservationStatistics(-1).
           distanceAveraged / distancePrevObsOmitted;
       double previousSegmentTimeProportion =
-          static_cast<double>(((observationAfterFastestSegment - 1)->get().getTime() -
-           (observationAfterFastestSegment - 2)->get().getTime()).toSeconds()) /
+          static_cast<double>((observationTime(fastest - 1) -
+                               observationTime(fastest - 2)).toSeconds()) /
           timeSum.toSeconds();
       double previousAndFastestSegmentTimeProportion =
-          static_cast<double>(((observationAfterFastestSegment->get().getTime()) -
-            (observationAfterFastestSegment - 2)->get().getTime()).toSeconds()) /
+          static_cast<double>((observationTime(fastest) -
+                               observationTime(fastest - 2)).toSeconds()) /
           timeSum.toSeconds();
       if (options_.testingMode.value()) {
         diagnostics_->storePreviousSegmentDistanceProportion(previousSegmentDistanceProportion);
@@ -467,17 +415,17 @@ void TrackCheckShip::removeFaultyObservation(
         // previous segment's spatial and temporal lengths are significantly more disproportionate
         // when compared to a larger portion of track
         // than the equivalents for the post-fastest segment
-        fail(observationAfterFastestSegment - 1);
+        fail(fastest - 1);
         errorCategory = 10;
       } else if (std::abs(previousObservationDistanceAveragedProportion -
                           previousAndFastestSegmentTimeProportion) > 0.1 +
                  std::abs(previousSegmentDistanceProportion - previousSegmentTimeProportion)) {
         // next segment after fastest has spatial and temporal lengths that are significantly more
         // disproportionate than the segment before the fastest
-        fail(observationAfterFastestSegment);
+        fail(fastest);
         errorCategory = 10;
       } else {
-        fail(observationAfterFastestSegment);
+        fail(fastest);
       }
       oops::Log::trace() << "CheckShipTrack: proportions " << previousSegmentDistanceProportion <<
                             " " << previousSegmentTimeProportion <<
@@ -500,102 +448,96 @@ void TrackCheckShip::removeFaultyObservation(
                             0.001 << "[km]" << std::endl;
     }
   }
-  if (errorCategory == 0 || ((rejectedObservation->get().getObservationStatistics().
-                              speedAveraged) >
+  if (errorCategory == 0 || (columns.statistics[track[rejectedObservation]].speedAveraged >
                              options_.core.maxSpeed.value())) {
     oops::Log::trace() << "CheckShipTrack: cannot decide between station id " <<
                           trackId << " observations " <<
-                          (observationAfterFastestSegment - 1)->get().getObservationNumber() <<
-                          " " << observationAfterFastestSegment->get().getObservationNumber() <<
+                          observationNumber(fastest - 1) << " " << observationNumber(fastest) <<
                           " rejecting both." << std::endl;
     errorCategory += 100;
     if (options_.testingMode.value() && firstIterativeRemoval) {
       std::vector<size_t> observationNumbersAroundFastest{
-        (observationAfterFastestSegment - 1)->get().getObservationNumber(),
-            observationAfterFastestSegment->get().getObservationNumber()};
+        observationNumber(fastest - 1), observationNumber(fastest)};
       diagnostics_->storeFirstIterativeRemovalInfo(
             std::make_pair(observationNumbersAroundFastest, errorCategory));
     }
-    fail(observationAfterFastestSegment - 1);
-    fail(observationAfterFastestSegment);
-    track.erase(observationAfterFastestSegment - 1, observationAfterFastestSegment + 1);
+    fail(fastest - 1);
+    fail(fastest);
+    track.erase(track.begin() + fastest - 1, track.begin() + fastest + 1);
   } else {
     if (options_.testingMode.value() && firstIterativeRemoval) {
-      std::vector<size_t> rejectedObservationNumber{rejectedObservation->get().
-            getObservationNumber()};
+      std::vector<size_t> rejectedObservationNumber{observationNumber(rejectedObservation)};
       diagnostics_->storeFirstIterativeRemovalInfo(
             std::make_pair(rejectedObservationNumber,
                            errorCategory));
     }
     oops::Log::trace() << "CheckShipTrack: rejecting station " << trackId << " observation " <<
-                          rejectedObservation->get().getObservationNumber() << "\n" <<
+                          observationNumber(rejectedObservation) << "\n" <<
                           "Error category: " << errorCategory << "\n" <<
                           "rejection candidates: " <<
-                          (observationAfterFastestSegment - 1)->get().getObservationNumber() <<
-                          " " << observationAfterFastestSegment->get().getObservationNumber() <<
-                          "\n" << "speeds: " << (observationAfterFastestSegment - 1)->get().
-                          getObservationStatistics().speed << " " <<
-                          observationAfterFastestSegment->get().getObservationStatistics().speed <<
-                          "\n" << (observationAfterFastestSegment - 1)->get().
-                          getObservationStatistics().angle << " " <<
-                          observationAfterFastestSegment->get().
-                          getObservationStatistics().angle << "\n";
-    track.erase(rejectedObservation);
+                          observationNumber(fastest - 1) << " " << observationNumber(fastest) <<
+                          "\n" << "speeds: " << neighborObservationStatistics(-1).speed << " " <<
+                          neighborObservationStatistics(0).speed <<
+                          "\n" << neighborObservationStatistics(-1).angle << " " <<
+                          neighborObservationStatistics(0).angle << "\n";
+    track.erase(track.begin() + rejectedObservation);
   }
 }
 /// \todo Trace output will need to be changed to match that of OPS (indices, LWin)
 
 /// \brief Calculates all of the statistics that require only two
-/// adjacent \p TrackObservations, storing within the righthand observation.
+/// adjacent observations, storing within the righthand observation \p obs.
 ///
 /// This includes
 /// distance between the two observations,
 /// time difference between the observations, speed between the
 /// observations, and if the
-/// observations are recorded for the same time. Calls function to
-/// increment track-wise counters based on
-/// results.
-void TrackCheckShip::TrackObservation::calculateTwoObservationValues(
-    TrackObservation& prevObs, bool firstIteration,
-    const TrackCheckShipParameters &options) {
-  this->setDistance(TrackCheckShip::distance(prevObs, *this));
-  (this->observationStatistics_.distance > options.core.spatialResolution) ?
-        this->setSpeed(TrackCheckShip::speedEstimate(*this, prevObs, options)) :
-        this->setSpeed(0.0);
-  this->setTimeDifference(getTime() - prevObs.getTime());
+/// observations are recorded for the same time. Increments track-wise
+/// counters based on results on the first iteration.
+void TrackCheckShip::calculateTwoObservationValues(
+    size_t obs, size_t prevObs, TrackColumns &columns,
+    TrackStatistics &trackStatistics, bool firstIteration) const {
+  ObservationStatistics &obsStats = columns.statistics[obs];
+  obsStats.distance = distance(columns.locations, prevObs, obs);
+  obsStats.speed = (obsStats.distance > options_.core.spatialResolution) ?
+        speedEstimate(columns.locations, columns.times, obs, prevObs, options_) : 0.0;
+  obsStats.timeDifference = columns.times[obs] - columns.times[prevObs];
   if (firstIteration) {
-    adjustTwoObservationStatistics(options);
+    // Keep track of 0-distanced, short, and fast track segments,
+    // as well as incrementing sumSpeed_ for normal track segments.
+    util::Duration hour{"PT1H"};
+    if (obsStats.timeDifference < hour) {
+      trackStatistics.numShort_++;
+    } else if (obsStats.speed >= options_.core.maxSpeed) {
+      trackStatistics.numFast_++;
+    } else {
+      trackStatistics.sumSpeed_ += obsStats.speed;
+    }
   }
 }
 
-void TrackCheckShip::TrackObservation::resetObservationCalculations() {
-  this->setDistance(0.0);
-  this->setSpeed(0.0);
-  this->setDistanceAveraged(0.0);
-  this->setSpeedAveraged(0.0);
-  this->setAngle(0.0);
-}
-
 /// Calculates all of the statistics that require three
-/// consecutive \p TrackObservations,
-/// storing within the middle observation. This includes
+/// consecutive observations,
+/// storing within the middle observation \p obs. This includes
 /// distance between two alternating observations,
 /// speed between these alternating observations (if the middle
 /// observation was not recorded), and the
 /// angle formed by the three-observation track segment.
-/// Calls function to increment track-wise counters based on results.
-void TrackCheckShip::TrackObservation::calculateThreeObservationValues(
-    const TrackObservation& prevObs, const TrackObservation& nextObs,
-    bool firstIteration, const TrackCheckShipParameters &options) {
-  this->setDistanceAveraged(TrackCheckShip::distance(prevObs, nextObs));
-  this->setSpeedAveraged(speedEstimate(prevObs, nextObs, options));
-  if (std::min(this->observationStatistics_.distance,
-               nextObs.observationStatistics_.distance) >
-      options.core.spatialResolution) {
-    this->observationStatistics_.angle = angle(prevObs, *this, nextObs);
+/// Increments the number of bends on the first iteration if the angle is greater than or equal to
+/// 90 degrees.
+void TrackCheckShip::calculateThreeObservationValues(
+    size_t obs, size_t prevObs, size_t nextObs, TrackColumns &columns,
+    TrackStatistics &trackStatistics, bool firstIteration) const {
+  ObservationStatistics &obsStats = columns.statistics[obs];
+  obsStats.distanceAveraged = distance(columns.locations, prevObs, nextObs);
+  obsStats.speedAveraged = speedEstimate(columns.locations, columns.times,
+                                         prevObs, nextObs, options_);
+  if (std::min(obsStats.distance, columns.statistics[nextObs].distance) >
+      options_.core.spatialResolution) {
+    obsStats.angle = angle(columns.locations, prevObs, obs, nextObs);
   }
-  if (firstIteration) {
-    adjustThreeObservationStatistics();
+  if (firstIteration && obsStats.angle >= 90.0) {
+    trackStatistics.numBends_++;
   }
 }
 
@@ -604,87 +546,42 @@ void TrackCheckShip::TrackObservation::calculateThreeObservationValues(
 /// \p calculateTwoObservationValues and \p calculateThreeObservationValues for the
 /// non-edge-case observations.
 void TrackCheckShip::calculateTrackSegmentProperties(
-    const std::vector<std::reference_wrapper<TrackObservation>> &trackObservations,
+    const std::vector<size_t> &track, TrackColumns &columns,
+    TrackStatistics &trackStatistics,
     CalculationMethod calculationMethod) const {
-  if (trackObservations.size()) {
-    if (calculationMethod == MAINLOOP)
-      trackObservations[0].get().resetObservationCalculations();
-    for (size_t obsIdx = 1; obsIdx < trackObservations.size(); obsIdx++) {
-      TrackObservation &obs = trackObservations[obsIdx].get();
-      TrackObservation &prevObs = trackObservations[obsIdx - 1].get();
-      obs.calculateTwoObservationValues(prevObs, calculationMethod == FIRSTITERATION, options_);
+  if (track.size()) {
+    if (calculationMethod == MAINLOOP) {
+      ObservationStatistics &firstObsStats = columns.statistics[track[0]];
+      firstObsStats.distance = 0.0;
+      firstObsStats.speed = 0.0;
+      firstObsStats.distanceAveraged = 0.0;
+      firstObsStats.speedAveraged = 0.0;
+      firstObsStats.angle = 0.0;
+    }
+    const bool firstIteration = calculationMethod == FIRSTITERATION;
+    for (size_t obsIdx = 1; obsIdx < track.size(); obsIdx++) {
+      calculateTwoObservationValues(track[obsIdx], track[obsIdx - 1], columns,
+                                    trackStatistics, firstIteration);
       if (obsIdx > 1) {
-        const TrackObservation &prevPrevObs = trackObservations[obsIdx - 2].get();
-        prevObs.calculateThreeObservationValues(prevPrevObs, obs,
-                                                calculationMethod == FIRSTITERATION, options_);
+        calculateThreeObservationValues(track[obsIdx - 1], track[obsIdx - 2], track[obsIdx],
+                                        columns, trackStatistics, firstIteration);
       }
-      if (calculationMethod == FIRSTITERATION && (obsIdx == trackObservations.size() - 1)) {
-        int potentialDenominator = trackObservations.size() - 1 -
-            obs.getFullTrackStatistics()->numShort_ - obs.getFullTrackStatistics()->numFast_;
-        (obs.getFullTrackStatistics()->meanSpeed_) = (obs.getFullTrackStatistics()->sumSpeed_) /
+      if (firstIteration && (obsIdx == track.size() - 1)) {
+        int potentialDenominator = track.size() - 1 -
+            trackStatistics.numShort_ - trackStatistics.numFast_;
+        trackStatistics.meanSpeed_ = trackStatistics.sumSpeed_ /
             std::max(1, potentialDenominator);
       }
     }
     if (options_.testingMode.value() && calculationMethod != MAINLOOP) {
       std::vector<TrackCheckShip::ObservationStatistics> obsStats;
-      for (size_t obsIdx = 0; obsIdx < trackObservations.size(); ++obsIdx) {
-        obsStats.push_back(trackObservations[obsIdx].get().getObservationStatistics());
+      for (size_t obsIdx = 0; obsIdx < track.size(); ++obsIdx) {
+        obsStats.push_back(columns.statistics[track[obsIdx]]);
       }
-      auto trackStats = *(trackObservations[0].get().getFullTrackStatistics());
       if (calculationMethod == FIRSTITERATION)
-        diagnostics_->storeInitialCalculationResults(std::make_pair(obsStats, trackStats));
+        diagnostics_->storeInitialCalculationResults(std::make_pair(obsStats, trackStatistics));
     }
   }
 }
 
-/// \brief Keeps track of 0-distanced, short, and fast track segments,
-/// as well as incrementing \p sumSpeed_ for normal track segments.
-void TrackCheckShip::TrackObservation::adjustTwoObservationStatistics
-(const TrackCheckShipParameters &options) const {
-  util::Duration hour{"PT1H"};
-  if (getObservationStatistics().timeDifference < hour) {
-    getFullTrackStatistics()->numShort_++;
-  } else if (getObservationStatistics().speed >= options.core.maxSpeed) {
-    getFullTrackStatistics()->numFast_++;
-  } else {
-    getFullTrackStatistics()->sumSpeed_ += getObservationStatistics().speed;
-  }
-}
-
-/// \brief Increments number of bends if angle is greater than or equal to 90 degrees
-void TrackCheckShip::TrackObservation::adjustThreeObservationStatistics() const {
-  if (getObservationStatistics().angle >= 90.0)
-    getFullTrackStatistics()->numBends_++;
-}
-
-const TrackCheckShip::ObservationStatistics &
-TrackCheckShip::TrackObservation::getObservationStatistics() const
-{
-  return observationStatistics_;
-}
-
-const std::shared_ptr<TrackCheckShip::TrackStatistics>
-TrackCheckShip::TrackObservation::getFullTrackStatistics() const
-{
-  return fullTrackStatistics_;
-}
-
-void TrackCheckShip::TrackObservation::setDistance(double dist) {
-  this->observationStatistics_.distance = dist;
-}
-void TrackCheckShip::TrackObservation::setTimeDifference(util::Duration tDiff) {
-  this->observationStatistics_.timeDifference = tDiff;
-}
-void TrackCheckShip::TrackObservation::setSpeed(double speed) {
-  this->observationStatistics_.speed = speed;
-}
-void TrackCheckShip::TrackObservation::setAngle(double angle) {
-  this->observationStatistics_.angle = angle;
-}
-void TrackCheckShip::TrackObservation::setDistanceAveraged(double distAvg) {
-  this->observationStatistics_.distanceAveraged = distAvg;
-}
-void TrackCheckShip::TrackObservation::setSpeedAveraged(double speedAvg) {
-  this->observationStatistics_.speedAveraged = speedAvg;
-}
 }  // namespace ufo
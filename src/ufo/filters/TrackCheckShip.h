@@ -13,8 +13,6 @@
 #include <array>
 #include <cmath>
 #include <cstdlib>
-#include <functional>
-#include <list>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -116,86 +114,41 @@ class TrackCheckShip: public FilterBase,
     double meanSpeed_{};
   };
 
- private:
-  class TrackObservation {
-   public:
-    TrackObservation(double latitude, double longitude,
-                     const util::DateTime &time,
-                     const std::shared_ptr<TrackStatistics> & trackStatistics,
-                     const std::shared_ptr<TrackCheckUtils::CheckCounter> & checkCounter,
-                     size_t observationNumber);
-    const TrackCheckUtils::Point& getLocation() const {
-      return obsLocationTime_.location();
-    }
-    const util::DateTime& getTime() const {
-      return obsLocationTime_.time();
-    }
-    void setDistance(double dist);
-    void setTimeDifference(util::Duration tDiff);
-    void setSpeed(double speed);
-    void setAngle(double angle);
-    void setDistanceAveraged(double distAvg);
-    void setSpeedAveraged(double speedAvg);
-
-    void calculateTwoObservationValues(
-        TrackObservation& prevObs, bool firstIteration,
-        const TrackCheckShipParameters& options);
-    void resetObservationCalculations();
-    void calculateThreeObservationValues(
-        const TrackObservation& prevObs, const TrackObservation& nextObs,
-        bool firstIteration, const TrackCheckShipParameters& options);
-    void adjustTwoObservationStatistics(const TrackCheckShipParameters& options) const;
-    void adjustThreeObservationStatistics() const;
-
-    const std::shared_ptr<TrackStatistics> getFullTrackStatistics() const;
-
-    const ObservationStatistics &getObservationStatistics() const;
-
-    void setRejected(bool rejectedInSweep) {
-      rejected_ = rejectedInSweep;
-    }
-
-    size_t getObservationNumber() const;
-
-    bool rejected() const {
-      return rejected_;
-    }
-
-   private:
-    std::shared_ptr<TrackStatistics> fullTrackStatistics_;
-    ObservationStatistics observationStatistics_;
-    TrackCheckUtils::ObsLocationTime obsLocationTime_;
-    size_t observationNumber_;
-    bool rejected_;
-  };
-
- public:
-  /// \brief Extends \p distance for \p TrackObservation inputs \p a and \p b.
-  static double distance(const TrackObservation &a, const TrackObservation &b) {
-    return TrackCheckUtils::distance(a.getLocation(), b.getLocation());
+  /// \brief Returns the distance between the observations held at positions \p a and \p b of
+  /// the track store, whose cartesian locations are \p locations.
+  static double distance(const std::vector<TrackCheckUtils::Point> &locations,
+                         size_t a, size_t b) {
+    return TrackCheckUtils::distance(locations[a], locations[b]);
   }
 
   static double speedEstimate(
-      const TrackCheckShip::TrackObservation &obs1,
-      const TrackCheckShip::TrackObservation &obs2,
+      const std::vector<TrackCheckUtils::Point> &locations,
+      const std::vector<util::DateTime> &times,
+      size_t obs1, size_t obs2,
       const TrackCheckShipParameters& options);
 
-  static float angle(const TrackCheckShip::TrackObservation &a,
-                     const TrackCheckShip::TrackObservation &b,
-                     const TrackCheckShip::TrackObservation &c);
+  static float angle(const std::vector<TrackCheckUtils::Point> &locations,
+                     size_t a, size_t b, size_t c);
   const TrackCheckShipDiagnostics* diagnostics() const;
 
  private:
+  /// \brief Data of the observations held in a track store, laid out in the store's order.
+  ///
+  /// Calculated values are stored for every observation, whether accepted or not, so that each
+  /// track is processed in place without allocating per-observation objects.
+  struct TrackColumns {
+    TrackColumns(const TrackCheckUtils::TrackStore &store,
+                 const TrackCheckUtils::ObsGroupLocationTimes &obsLocTime);
+
+    std::vector<TrackCheckUtils::Point> locations;
+    std::vector<util::DateTime> times;
+    std::vector<ObservationStatistics> statistics;
+    std::vector<bool> rejected;
+  };
+
   Parameters_ options_;
   std::unique_ptr<TrackCheckShipDiagnostics> diagnostics_;
 
-  void flagRejectedTrackObservations(
-      std::vector<size_t>::const_iterator trackObsIndicesBegin,
-      std::vector<size_t>::const_iterator trackObsIndicesEnd,
-      const std::vector<size_t> &validObsIds,
-      const std::vector<TrackObservation> &trackObservations,
-      std::vector<bool> &isRejected) const;
-
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
@@ -203,22 +156,31 @@ class TrackCheckShip: public FilterBase,
 
   enum CalculationMethod { FIRSTITERATION, MAINLOOP };
 
+  /// \brief Calculates the statistics of the accepted observations of a track, whose positions
+  /// in the track store are listed in \p track.
   void calculateTrackSegmentProperties(
-      const std::vector<std::reference_wrapper<TrackObservation>> &trackObservations,
+      const std::vector<size_t> &track, TrackColumns &columns,
+      TrackStatistics &trackStatistics,
       CalculationMethod calculationMethod = MAINLOOP) const;
 
-  std::vector<TrackObservation> collectTrackObservations(
-      std::vector<size_t>::const_iterator trackObsIndicesBegin,
-      std::vector<size_t>::const_iterator trackObsIndicesEnd,
-      const std::vector<size_t> &validObsIds,
-      const TrackCheckUtils::ObsGroupLocationTimes &obsLoc) const;
+  void calculateTwoObservationValues(
+      size_t obs, size_t prevObs, TrackColumns &columns,
+      TrackStatistics &trackStatistics, bool firstIteration) const;
+
+  void calculateThreeObservationValues(
+      size_t obs, size_t prevObs, size_t nextObs, TrackColumns &columns,
+      TrackStatistics &trackStatistics, bool firstIteration) const;
 
-  bool earlyBreak(const std::vector<std::reference_wrapper<TrackObservation>> &trackObs,
+  bool earlyBreak(size_t trackSize, const TrackStatistics &trackStatistics,
                   const std::string trackId) const;
 
+  /// \brief Chooses which of the observations surrounding the fastest segment to remove from
+  /// \p track, flagging it accordingly. \p observationAfterFastestSegment is the index in
+  /// \p track of the observation following that segment and \p trackBegin the position of the
+  /// first observation of the track in the track store.
   void removeFaultyObservation(
-      std::vector<std::reference_wrapper<TrackObservation> > &track,
-      const std::vector<std::reference_wrapper<TrackObservation> >::iterator &it,
+      std::vector<size_t> &track, size_t observationAfterFastestSegment,
+      size_t trackBegin, TrackColumns &columns, const TrackStatistics &trackStatistics,
       bool firstIterativeRemoval, const std::string trackId) const;
 };
 
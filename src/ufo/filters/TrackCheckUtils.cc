@@ -9,6 +9,7 @@
 #include <cmath>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/geometry/Point2.h"
@@ -21,6 +22,7 @@
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/TrackCheckUtils.h"
 #include "ufo/utils/Constants.h"
+#include "ufo/utils/EpochSeconds.h"
 #include "ufo/utils/RecursiveSplitter.h"
 
 namespace ufo {
@@ -54,7 +56,8 @@ float TrackCheckUtils::distance(const Point &a, const Point &b) {
 
 ObsAccessor TrackCheckUtils::createObsAccessor(const boost::optional<Variable> &stationIdVariable,
                                                const ioda::ObsSpace &obsdb,
-                                               const bool recordsAreSingleObs) {
+                                               const bool recordsAreSingleObs,
+                                               const bool redistributeByStationId) {
   if (recordsAreSingleObs && (stationIdVariable != boost::none)) {
     return ObsAccessor::toSingleObservationsSplitIntoIndependentGroupsByVariable(obsdb,
                                                       *stationIdVariable);
@@ -64,7 +67,7 @@ ObsAccessor TrackCheckUtils::createObsAccessor(const boost::optional<Variable> &
     return ObsAccessor::toAllObservations(obsdb);
   } else if (stationIdVariable != boost::none) {
     return ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
-          obsdb, *stationIdVariable);
+          obsdb, *stationIdVariable, redistributeByStationId);
   } else if (!obsdb.obs_group_vars().empty()) {
     // Assume observations were grouped into records by station IDs
     return ObsAccessor::toObservationsSplitIntoIndependentGroupsByRecordId(obsdb);
@@ -78,7 +81,7 @@ ObsAccessor TrackCheckUtils::createObsAccessor(const boost::optional<Variable> &
 void TrackCheckUtils::sortTracksChronologically(const std::vector<size_t> &validObsIds,
                                                 const ObsAccessor &obsAccessor,
                                                 RecursiveSplitter &splitter) {
-  const std::vector<util::DateTime> times = obsAccessor.getDateTimeVariableFromObsSpace(
+  const std::vector<EpochSeconds> times = obsAccessor.getEpochSecondsVariableFromObsSpace(
         "MetaData", "dateTime");
   splitter.sortGroupsBy([&times, &validObsIds](size_t obsIndex)
   { return times[validObsIds[obsIndex]]; });
@@ -95,6 +98,25 @@ TrackCheckUtils::ObsGroupLocationTimes
   return locationTimes;
 }
 
+TrackCheckUtils::TrackStore::TrackStore(const RecursiveSplitter &splitter,
+                                         const std::vector<size_t> &validObsIds) {
+  obsIds_.reserve(validObsIds.size());
+  offsets_.push_back(0);
+  for (auto track : splitter.multiElementGroups()) {
+    for (size_t index : track)
+      obsIds_.push_back(validObsIds[index]);
+    offsets_.push_back(obsIds_.size());
+  }
+}
+
+std::vector<TrackCheckUtils::Point> TrackCheckUtils::TrackStore::cartesianLocations(
+    const std::vector<float> &latitudes, const std::vector<float> &longitudes) {
+  std::vector<Point> locations(latitudes.size());
+  for (size_t i = 0; i < latitudes.size(); ++i)
+    locations[i] = pointFromLatLon(latitudes[i], longitudes[i]);
+  return locations;
+}
+
 TrackCheckUtils::ObsLocationTime::ObsLocationTime(float latitude, float longitude,
                                                                   const util::DateTime &time)
   :  location_(pointFromLatLon(latitude, longitude)), time_(time)
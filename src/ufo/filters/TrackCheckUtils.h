@@ -64,6 +64,50 @@ class ObsLocationTime {
   util::DateTime time_;
 };
 
+/// \brief Index of the observations of a set of tracks, stored track by track in one contiguous
+/// array.
+///
+/// Positions `begin(track)` to `end(track) - 1` of the store hold the observations of track
+/// `track` in chronological order. Per-observation data are gathered into "columns" laid out
+/// in the same order (see gather()), so that filters can process each track as a contiguous
+/// span of these columns without building per-track containers.
+class TrackStore {
+ public:
+  /// \brief Build the index of the tracks formed by the multi-element groups of \p splitter,
+  /// whose elements are indices of \p validObsIds.
+  TrackStore(const RecursiveSplitter &splitter, const std::vector<size_t> &validObsIds);
+
+  size_t numTracks() const { return offsets_.size() - 1; }
+  /// \brief Total number of observations in all tracks.
+  size_t size() const { return obsIds_.size(); }
+  size_t begin(size_t track) const { return offsets_[track]; }
+  size_t end(size_t track) const { return offsets_[track + 1]; }
+
+  /// \brief Index of the observation held at each position of the store in the arrays
+  /// returned by the ObsAccessor.
+  const std::vector<size_t> &obsIds() const { return obsIds_; }
+
+  /// \brief Return the elements of \p globalData (indexed like the arrays returned by the
+  /// ObsAccessor) corresponding to successive positions of the store.
+  template <typename T>
+  std::vector<T> gather(const std::vector<T> &globalData) const {
+    std::vector<T> column;
+    column.reserve(obsIds_.size());
+    for (size_t obsId : obsIds_)
+      column.push_back(globalData[obsId]);
+    return column;
+  }
+
+  /// \brief Return the cartesian locations of observations with latitudes \p latitudes and
+  /// longitudes \p longitudes (columns gathered from the store).
+  static std::vector<Point> cartesianLocations(const std::vector<float> &latitudes,
+                                               const std::vector<float> &longitudes);
+
+ private:
+  std::vector<size_t> obsIds_;
+  std::vector<size_t> offsets_;
+};
+
 class CheckCounter {
  public:
   CheckCounter();
@@ -95,9 +139,14 @@ class CheckCounter {
 /// i.e. by *stationIdVariable, but also allow access to observations on all MPI ranks.
 /// This is necessary because each track (defined by *stationIdVariable) may contain multiple
 /// records and thus be split over multiple ranks.
+///
+/// If \p redistributeByStationId is true, tracks spread over multiple ranks are sent to a single
+/// owner rank each rather than gathered on all ranks (see
+/// ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable()).
 ObsAccessor createObsAccessor(const boost::optional<Variable> &stationIdVariable,
                               const ioda::ObsSpace &obsdb,
-                              const bool recordsAreSingleObs);
+                              const bool recordsAreSingleObs,
+                              const bool redistributeByStationId = false);
 
 void sortTracksChronologically(const std::vector<size_t> &validObsIds,
                                const ObsAccessor &obsAccessor,
@@ -8,6 +8,7 @@
 #define UFO_FILTERS_TRACKCHECKUTILSPARAMETERS_H_
 
 #include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/Parameters.h"
 #include "ufo/filters/FilterParametersBase.h"
 #include "ufo/utils/parameters/ParameterTraitsVariable.h"
@@ -64,6 +65,14 @@ class TrackCheckUtilsParameters : public FilterParametersBase {
   /// \c obs space.obsdatain.obsgrouping.groupvariable YAML option.
   oops::OptionalParameter<Variable> stationIdVariable{
     "station_id_variable", this};
+
+  /// If true and \c station_id_variable was not used to group observations into records, the
+  /// observations taken by each station are sent to a single MPI rank (chosen by hashing the
+  /// station ID) and checked there, instead of being gathered on all ranks. The results are the
+  /// same, but memory use and communication scale with the number of observations per rank.
+  ///
+  /// Ignored if records are treated as single observations.
+  oops::Parameter<bool> redistributeByStationId{"redistribute_by_station_id", false, this};
 };
 
 }  // namespace ufo
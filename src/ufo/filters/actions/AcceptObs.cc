@@ -8,6 +8,7 @@
 #include "ufo/filters/actions/AcceptObs.h"
 
 #include "ioda/ObsDataVector.h"
+#include "ufo/filters/FlagMatrix.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 
@@ -26,22 +27,20 @@ AcceptObs::AcceptObs(const Parameters_ &)
 // -----------------------------------------------------------------------------
 
 void AcceptObs::apply(const Variables & vars,
-                      const std::vector<std::vector<bool>> & flagged,
+                      const FlagMatrix & flagged,
                       const ObsFilterData &,
                       int /*filterQCflag*/,
                       ioda::ObsDataVector<int> & flags,
                       ioda::ObsDataVector<float> &) const {
   for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
     const size_t iallvar = flags.varnames().find(vars.variable(ifiltervar).variable());
-    for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs) {
-      if (flagged[ifiltervar][jobs]) {
-        int &currentFlag = flags[iallvar][jobs];
-        if (currentFlag != QCflags::missing &&
-            currentFlag != QCflags::preQC &&
-            currentFlag != QCflags::Hfailed)
-          currentFlag = QCflags::pass;
-      }
-    }
+    flagged.forEachFlagged(ifiltervar, [&](size_t jobs) {
+      int &currentFlag = flags[iallvar][jobs];
+      if (currentFlag != QCflags::missing &&
+          currentFlag != QCflags::preQC &&
+          currentFlag != QCflags::Hfailed)
+        currentFlag = QCflags::pass;
+    });
   }
 }
 
@@ -34,7 +34,7 @@ class AcceptObs : public FilterActionBase {
 
   explicit AcceptObs(const Parameters_ &);
 
-  void apply(const Variables &, const std::vector<std::vector<bool>> &,
+  void apply(const Variables &, const FlagMatrix &,
              const ObsFilterData &, int,
              ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
 
@@ -13,6 +13,7 @@
 #include "ioda/ObsDataVector.h"
 #include "oops/base/Variables.h"
 #include "oops/util/missingValues.h"
+#include "ufo/filters/FlagMatrix.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 
@@ -51,7 +52,7 @@ AssignError::AssignError(const Parameters_ & parameters)
 // -----------------------------------------------------------------------------
 
 void AssignError::apply(const Variables & vars,
-                        const std::vector<std::vector<bool>> &mask,
+                        const FlagMatrix &mask,
                         const ObsFilterData & data,
                         int /*filterQCflag*/,
                         ioda::ObsDataVector<int> & qcFlags,
@@ -64,9 +65,9 @@ void AssignError::apply(const Variables & vars,
     for (size_t jv = 0; jv < vars.nvars(); ++jv) {
       size_t iv = obserr.varnames().find(vars.variable(jv).variable());
       size_t kv = qcFlags.varnames().find(vars.variable(jv).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (mask[jv][jobs] && qcFlags[kv][jobs] == QCflags::pass) obserr[iv][jobs] = error;
-      }
+      mask.forEachFlagged(jv, [&](size_t jobs) {
+        if (qcFlags[kv][jobs] == QCflags::pass) obserr[iv][jobs] = error;
+      });
     }
     // If variable is specified
   } else if (parameters_.errorParameterVector.value() != boost::none) {
@@ -74,11 +75,11 @@ void AssignError::apply(const Variables & vars,
     for (size_t jv = 0; jv < vars.nvars(); ++jv) {
       size_t iv = obserr.varnames().find(vars.variable(jv).variable());
       size_t kv = qcFlags.varnames().find(vars.variable(jv).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (mask[jv][jobs] && qcFlags[kv][jobs] == QCflags::pass) {
+      mask.forEachFlagged(jv, [&](size_t jobs) {
+        if (qcFlags[kv][jobs] == QCflags::pass) {
           obserr[iv][jobs] = errorvector[iv];
         }
-      }
+      });
     }
     // If variable is specified
   } else if (parameters_.errorFunction.value() != boost::none) {
@@ -103,11 +104,10 @@ void AssignError::apply(const Variables & vars,
       // find current variable index in obserr
       size_t iv = obserr.varnames().find(vars.variable(jv).variable());
       size_t kv = qcFlags.varnames().find(vars.variable(jv).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (mask[jv][jobs] && qcFlags[kv][jobs] == QCflags::pass
-                              && errors[error_jv[jv]][jobs] != missing)
+      mask.forEachFlagged(jv, [&](size_t jobs) {
+        if (qcFlags[kv][jobs] == QCflags::pass && errors[error_jv[jv]][jobs] != missing)
           obserr[iv][jobs] = errors[error_jv[jv]][jobs];
-      }
+      });
     }
   }
   oops::Log::debug() << " AssignError output obserr: " << obserr << std::endl;
@@ -46,7 +46,7 @@ class AssignError : public FilterActionBase {
   explicit AssignError(const Parameters_ &);
   ~AssignError() {}
 
-  void apply(const Variables &, const std::vector<std::vector<bool>> &,
+  void apply(const Variables &, const FlagMatrix &,
              const ObsFilterData &, int,
              ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
   const ufo::Variables & requiredVariables() const override {return allvars_;}
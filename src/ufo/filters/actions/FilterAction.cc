@@ -23,7 +23,7 @@ FilterAction::~FilterAction() {}
 
 // -----------------------------------------------------------------------------
 
-void FilterAction::apply(const Variables & vars, const std::vector<std::vector<bool>> & mask,
+void FilterAction::apply(const Variables & vars, const FlagMatrix & mask,
                          const ObsFilterData & data, int filterQCflag,
                          ioda::ObsDataVector<int> & flags, ioda::ObsDataVector<float> & err) const {
   action_->apply(vars, mask, data, filterQCflag, flags, err);
@@ -20,6 +20,7 @@ namespace ioda {
 namespace ufo {
   class FilterActionBase;
   class FilterActionParametersBase;
+  class FlagMatrix;
   class ObsFilterData;
   class Variables;
 
@@ -33,8 +34,9 @@ class FilterAction : private boost::noncopyable {
   /// \param vars
   ///   The list of filter variables.
   /// \param flagged
-  ///   If flagged[i][j] is true, it means that the action should be performed on jth observation
-  ///   of ith filter variable.
+  ///   If flagged(i, j) is true, it means that the action should be performed on jth observation
+  ///   of ith filter variable. Implementations should visit the flagged observations with
+  ///   FlagMatrix::forEachFlagged().
   /// \param data
   ///   Accessor to obs filter data.
   /// \param filterQCflag
@@ -44,7 +46,7 @@ class FilterAction : private boost::noncopyable {
   ///   QC flags of all "simulated variables".
   /// \param obserr
   ///   Obs error estimates of all "simulated variables".
-  void apply(const ufo::Variables &vars, const std::vector<std::vector<bool>> &flagged,
+  void apply(const ufo::Variables &vars, const FlagMatrix &flagged,
              const ObsFilterData &data, int filterQCflag,
              ioda::ObsDataVector<int> &flags, ioda::ObsDataVector<float> &obserr) const;
   const ufo::Variables & requiredVariables() const;
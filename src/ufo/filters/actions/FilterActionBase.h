@@ -26,6 +26,7 @@ template <typename T> class ObsDataVector;
 namespace ufo {
 
 class FilterActionFactory;
+class FlagMatrix;
 class ObsFilterData;
 class Variables;
 
@@ -62,8 +63,9 @@ class FilterActionBase : private boost::noncopyable {
   /// \param vars
   ///   The list of filter variables.
   /// \param flagged
-  ///   If flagged[i][j] is true, it means that the action should be performed on jth observation
-  ///   of ith filter variable.
+  ///   If flagged(i, j) is true, it means that the action should be performed on jth observation
+  ///   of ith filter variable. Implementations should visit the flagged observations with
+  ///   FlagMatrix::forEachFlagged().
   /// \param data
   ///   Accessor to obs filter data.
   /// \param filterQCflag
@@ -73,7 +75,7 @@ class FilterActionBase : private boost::noncopyable {
   ///   QC flags of all "simulated variables".
   /// \param obserr
   ///   Obs error estimates of all "simulated variables".
-  virtual void apply(const ufo::Variables &vars, const std::vector<std::vector<bool>> &flagged,
+  virtual void apply(const ufo::Variables &vars, const FlagMatrix &flagged,
                      const ObsFilterData &data, int filterQCflag,
                      ioda::ObsDataVector<int> &flags, ioda::ObsDataVector<float> &obserr) const = 0;
 
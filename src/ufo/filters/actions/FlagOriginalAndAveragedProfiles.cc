@@ -8,6 +8,7 @@
 #include "ufo/filters/actions/FlagOriginalAndAveragedProfiles.h"
 
 #include "ioda/ObsDataVector.h"
+#include "ufo/filters/FlagMatrix.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 
@@ -29,7 +30,7 @@ FlagOriginalAndAveragedProfiles::FlagOriginalAndAveragedProfiles
 // -----------------------------------------------------------------------------
 
 void FlagOriginalAndAveragedProfiles::apply(const Variables & vars,
-                                            const std::vector<std::vector<bool>> & flagged,
+                                            const FlagMatrix & flagged,
                                             const ObsFilterData & data,
                                             int filterQCflag,
                                             ioda::ObsDataVector<int> & flags,
@@ -72,7 +73,7 @@ void FlagOriginalAndAveragedProfiles::apply(const Variables & vars,
       bool flagAveraged = false;
       // Flag the orginal profile in the same way as is done by the Reject action.
       for (size_t jloc : locsOriginal) {
-        if (flagged[jv][jloc] && flags[iv][jloc] == QCflags::pass) {
+        if (flagged(jv, jloc) && flags[iv][jloc] == QCflags::pass) {
           flags[iv][jloc] = filterQCflag;
           flagAveraged = true;
         }
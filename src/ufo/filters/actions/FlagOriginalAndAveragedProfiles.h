@@ -58,7 +58,7 @@ class FlagOriginalAndAveragedProfiles : public FilterActionBase {
   explicit FlagOriginalAndAveragedProfiles(const Parameters_ &);
   ~FlagOriginalAndAveragedProfiles() {}
 
-  void apply(const Variables &, const std::vector<std::vector<bool>> &,
+  void apply(const Variables &, const FlagMatrix &,
              const ObsFilterData &, int,
              ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
   const ufo::Variables & requiredVariables() const override {return allvars_;}
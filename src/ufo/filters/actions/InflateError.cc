@@ -11,6 +11,7 @@
 
 #include "ioda/ObsDataVector.h"
 #include "oops/base/Variables.h"
+#include "ufo/filters/FlagMatrix.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variables.h"
@@ -56,7 +57,7 @@ InflateError::InflateError(const Parameters_ & parameters)
 /// \param flags QC flags (for all "simulated variables")
 /// \param obserr ObsError (for all "simulated variables")
 void InflateError::apply(const Variables & vars,
-                         const std::vector<std::vector<bool>> & flagged,
+                         const FlagMatrix & flagged,
                          const ObsFilterData & data,
                          int /*filterQCflag*/,
                          ioda::ObsDataVector<int> & flags,
@@ -67,11 +68,11 @@ void InflateError::apply(const Variables & vars,
     float factor = *parameters_.inflationFactor.value();
     for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
       size_t iallvar = obserr.varnames().find(vars.variable(ifiltervar).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (flagged[ifiltervar][jobs] && flags[iallvar][jobs] == QCflags::pass) {
+      flagged.forEachFlagged(ifiltervar, [&](size_t jobs) {
+        if (flags[iallvar][jobs] == QCflags::pass) {
           obserr[iallvar][jobs] *= factor;
         }
-      }
+      });
     }
   // If variable is specified
   } else if (parameters_.inflationVariable.value() != boost::none) {
@@ -95,11 +96,11 @@ void InflateError::apply(const Variables & vars,
     for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
       // find current variable index in obserr
       size_t iallvar = obserr.varnames().find(vars.variable(ifiltervar).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (flagged[ifiltervar][jobs] && flags[iallvar][jobs] == QCflags::pass) {
+      flagged.forEachFlagged(ifiltervar, [&](size_t jobs) {
+        if (flags[iallvar][jobs] == QCflags::pass) {
           obserr[iallvar][jobs] *= factors[factor_indices[ifiltervar]][jobs];
         }
-      }
+      });
     }
   }
   oops::Log::debug() << " InflateError output obserr: " << obserr << std::endl;
@@ -56,7 +56,7 @@ class InflateError : public FilterActionBase {
 
   explicit InflateError(const Parameters_ &);
 
-  void apply(const Variables &, const std::vector<std::vector<bool>> &,
+  void apply(const Variables &, const FlagMatrix &,
              const ObsFilterData &, int,
              ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
 
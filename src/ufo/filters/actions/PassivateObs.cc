@@ -8,6 +8,7 @@
 #include "ufo/filters/actions/PassivateObs.h"
 
 #include "ioda/ObsDataVector.h"
+#include "ufo/filters/FlagMatrix.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 
@@ -26,17 +27,17 @@ static FilterActionMaker<PassivateObs> makerPassivateObs_("passivate");
 // -----------------------------------------------------------------------------
 
 void PassivateObs::apply(const Variables & vars,
-                      const std::vector<std::vector<bool>> & flagged,
+                      const FlagMatrix & flagged,
                       const ObsFilterData &,
                       int,
                       ioda::ObsDataVector<int> & flags,
                       ioda::ObsDataVector<float> &) const {
   for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
     size_t iallvar = flags.varnames().find(vars.variable(ifiltervar).variable());
-    for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs) {
-      if (flagged[ifiltervar][jobs] && flags[iallvar][jobs] == QCflags::pass)
+    flagged.forEachFlagged(ifiltervar, [&](size_t jobs) {
+      if (flags[iallvar][jobs] == QCflags::pass)
         flags[iallvar][jobs] = QCflags::passive;
-    }
+    });
   }
 }
 
@@ -35,7 +35,7 @@ class PassivateObs : public FilterActionBase {
   explicit PassivateObs(const Parameters_ &);
   ~PassivateObs() {}
 
-  void apply(const Variables &, const std::vector<std::vector<bool>> &,
+  void apply(const Variables &, const FlagMatrix &,
              const ObsFilterData &, int,
              ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
   const ufo::Variables & requiredVariables() const override {return allvars_;}
@@ -8,6 +8,7 @@
 #include "ufo/filters/actions/RejectObs.h"
 
 #include "ioda/ObsDataVector.h"
+#include "ufo/filters/FlagMatrix.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 
@@ -26,17 +27,17 @@ RejectObs::RejectObs(const RejectObsParameters &parameters)
 // -----------------------------------------------------------------------------
 
 void RejectObs::apply(const Variables & vars,
-                      const std::vector<std::vector<bool>> & flagged,
+                      const FlagMatrix & flagged,
                       const ObsFilterData &,
                       int filterQCflag,
                       ioda::ObsDataVector<int> & flags,
                       ioda::ObsDataVector<float> &) const {
   for (size_t jv = 0; jv < vars.nvars(); ++jv) {
     size_t iv = flags.varnames().find(vars.variable(jv).variable());
-    for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs) {
-      if (flagged[jv][jobs] && flags[iv][jobs] == QCflags::pass)
+    flagged.forEachFlagged(jv, [&](size_t jobs) {
+      if (flags[iv][jobs] == QCflags::pass)
         flags[iv][jobs] = filterQCflag;
-    }
+    });
   }
 }
 
@@ -37,7 +37,7 @@ class RejectObs : public FilterActionBase {
   explicit RejectObs(const Parameters_ &);
   ~RejectObs() {}
 
-  void apply(const Variables &, const std::vector<std::vector<bool>> &,
+  void apply(const Variables &, const FlagMatrix &,
              const ObsFilterData &, int,
              ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
   const ufo::Variables & requiredVariables() const override {return allvars_;}
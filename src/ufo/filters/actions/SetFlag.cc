@@ -9,6 +9,7 @@
 
 #include "ioda/ObsDataVector.h"
 #include "ufo/filters/DiagnosticFlag.h"
+#include "ufo/filters/FlagMatrix.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 
@@ -46,7 +47,7 @@ SetFlag<value>::SetFlag(const SetFlagParameters &parameters)
 
 template <bool value>
 void SetFlag<value>::apply(const Variables &vars,
-                           const std::vector<std::vector<bool>> &flagged,
+                           const FlagMatrix &flagged,
                            const ObsFilterData &data,
                            int,
                            ioda::ObsDataVector<int> &qcFlags,
@@ -81,17 +82,19 @@ void SetFlag<value>::apply(const Variables &vars,
       throw eckit::UserError("Variable '" + group + '/' + variableName + "' does not exist yet. "
                              "It needs to be set up with the 'Create Diagnostic Flags' filter "
                              "prior to using the 'set' or 'unset' action.");
+    if (!flagged.any(ifiltervar))
+      continue;
     // Retrieve the current values of the diagnostic flag attached to the current filter variable
     data.get(ufo::Variable(group + "/" + variableName), diagnosticFlags);
     // QC flags of the current filter variable
     const ioda::ObsDataRow<int> &filterVarQcFlags = qcFlags[variableName];
-    for (size_t iobs = 0; iobs < nlocs; ++iobs) {
-      // Set/unset the diagnostic flag if the filter has flagged this observation and
-      // the action hasn't been told to skip it
-      if (flagged[ifiltervar][iobs] && !isIgnored(filterVarQcFlags[iobs])) {
+    // Set/unset the diagnostic flag if the filter has flagged this observation and
+    // the action hasn't been told to skip it
+    flagged.forEachFlagged(ifiltervar, [&](size_t iobs) {
+      if (!isIgnored(filterVarQcFlags[iobs])) {
         diagnosticFlags[iobs] = value;
       }
-    }
+    });
     // Save the modified values of the diagnostic flag to the ObsSpace
     data.obsspace().put_db(group, variableName, diagnosticFlags);
   }
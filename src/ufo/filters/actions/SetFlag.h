@@ -97,7 +97,7 @@ class SetFlag : public FilterActionBase {
   explicit SetFlag(const Parameters_ &);
 
   void apply(const Variables & vars,
-             const std::vector<std::vector<bool>> & flagged,
+             const FlagMatrix &flagged,
              const ObsFilterData & data,
              int /*filterQCflag*/,
              ioda::ObsDataVector<int> & flags,
@@ -84,10 +84,14 @@ void CloudCostFunction::compute(const ObsFilterData & in,
   bMatrixConf.set("BMatrix", options_.bmatrix_filepath.value());
   bMatrixConf.set("background fields", options_.field_names.value());
   bMatrixConf.set("qtotal", options_.qtotal_lnq_gkg.value());
+  if (options_.bmatrix_cache.value() != boost::none)
+    bMatrixConf.set("BMatrix cache", *options_.bmatrix_cache.value());
   MetOfficeBMatrixStatic staticB(bMatrixConf);
 
   eckit::LocalConfiguration rMatrixConf;
   rMatrixConf.set("RMatrix", options_.rmatrix_filepath.value());
+  if (options_.rmatrix_cache.value() != boost::none)
+    rMatrixConf.set("RMatrix cache", *options_.rmatrix_cache.value());
   MetOfficeRMatrixRadiance staticR(rMatrixConf);
 
   const std::string clw_name = "mass_content_of_cloud_liquid_water_in_atmosphere_layer";
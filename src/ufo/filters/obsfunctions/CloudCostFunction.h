@@ -40,6 +40,14 @@ class CloudCostFunctionParameters : public oops::Parameters {
   /// Path to location of file describing the B-matrix
   oops::RequiredParameter<std::string> bmatrix_filepath{"BMatrix", this};
 
+  /// Path to a binary cache of the R-matrix written by ufo_metoffice_matrix_cache.x; if set,
+  /// it is used instead of the file given by "RMatrix"
+  oops::OptionalParameter<std::string> rmatrix_cache{"RMatrix cache", this};
+
+  /// Path to a binary cache of the B-matrix written by ufo_metoffice_matrix_cache.x; if set,
+  /// it is used instead of the file given by "BMatrix"
+  oops::OptionalParameter<std::string> bmatrix_cache{"BMatrix cache", this};
+
   /// List of geovals describing fields required from the B-matrix
   oops::RequiredParameter<std::vector<std::string>>
                                  field_names{"background fields", this};
@@ -21,6 +21,7 @@
 #include "oops/util/IntSetParser.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/Variable.h"
+#include "ufo/utils/ChannelLevelLocationArray.h"
 #include "ufo/utils/Constants.h"
 
 namespace ufo {
@@ -96,48 +97,33 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
 
   // Get variables from ObsDiag
   // Load surface temperature jacobian
-  std::vector<std::vector<float>> dbtdts(nchans, std::vector<float>(nlocs));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag",
-                     channels_)[ichan], dbtdts[ichan]);
-  }
+  ChannelLevelLocationArray<float> dbtdts;
+  in.get(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag", channels_),
+         dbtdts);
 
   // Get temperature jacobian
-  std::vector<std::vector<std::vector<float>>>
-       dbtdt(nchans, std::vector<std::vector<float>>(nlevs, std::vector<float>(nlocs)));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
-      const int level = nlevs - ilev - 1;
-      in.get(Variable("brightness_temperature_jacobian_air_temperature@ObsDiag",
-                       channels_)[ichan], level, dbtdt[ichan][ilev]);
-    }
-  }
+  ChannelLevelLocationArray<float> dbtdt;
+  in.get(Variable("brightness_temperature_jacobian_air_temperature@ObsDiag", channels_),
+         dbtdt, true);
 
   // Get layer-to-space transmittance
-  std::vector<std::vector<std::vector<float>>>
-       tao(nchans, std::vector<std::vector<float>>(nlevs, std::vector<float>(nlocs)));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
-      const int level = nlevs - ilev - 1;
-      in.get(Variable("transmittances_of_atmosphere_layer@ObsDiag",
-             channels_)[ichan], level,  tao[ichan][ilev]);
-    }
-  }
+  ChannelLevelLocationArray<float> tao;
+  in.get(Variable("transmittances_of_atmosphere_layer@ObsDiag", channels_), tao, true);
 
   // Get pressure level at the peak of the weighting function
-  std::vector<float> values(nlocs, 0.0);
+  ChannelLevelLocationArray<float> wfunc_peak;
+  in.get(Variable("pressure_level_at_peak_of_weightingfunction@ObsDiag", channels_), wfunc_peak);
   std::vector<std::vector<float>> wfunc_pmaxlev(nchans, std::vector<float>(nlocs));
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("pressure_level_at_peak_of_weightingfunction@ObsDiag",
-                     channels_)[ichan], values);
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      wfunc_pmaxlev[ichan][iloc] = nlevs - values[iloc] + 1;
+      wfunc_pmaxlev[ichan][iloc] = nlevs - wfunc_peak(ichan, 0, iloc) + 1;
     }
   }
 
   // Get variables from ObsSpace
   // Get effective observation error and convert it to inverse of the error variance
   const float missing = util::missingValue(missing);
+  std::vector<float> values(nlocs, 0.0);
   std::vector<int> qcflag(nlocs, 0);
   std::vector<std::vector<float>> varinv_use(nchans, std::vector<float>(nlocs, 0.0));
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
@@ -270,11 +256,11 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
       // Perform cloud detection within troposphere
       if (prsl[k][iloc] * 0.01 > tropprs[iloc] * 0.01) {
         for (size_t ichan = 0; ichan < nchans; ++ichan) {
-          dbt[ichan] = (tair[k][iloc] - tsavg[iloc]) * dbtdts[ichan][iloc];
+          dbt[ichan] = (tair[k][iloc] - tsavg[iloc]) * dbtdts(ichan, 0, iloc);
         }
         for (size_t kk = 0; kk < k; ++kk) {
           for (size_t ichan = 0; ichan < nchans; ++ichan) {
-            dbt[ichan] = dbt[ichan] + (tair[k][iloc] - tair[kk][iloc]) * dbtdt[ichan][kk][iloc];
+            dbt[ichan] = dbt[ichan] + (tair[k][iloc] - tair[kk][iloc]) * dbtdt(ichan, kk, iloc);
           }
         }
         sum = 0.0;
@@ -310,7 +296,7 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
     if (lcloud > 0) {
       for (size_t ichan = 0; ichan < nchans; ++ichan) {
         // Get cloud top transmittance
-        tao_cld = tao[ichan][lcloud-1][iloc];
+        tao_cld = tao(ichan, lcloud-1, iloc);
         // Passive channels
         if (use_flag[ichan] < 0 && lcloud  >= wfunc_pmaxlev[ichan][iloc]) out[ichan][iloc] = 1;
         // Active channels
@@ -329,8 +315,8 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
       const float dts_threshold = 3.0;
       for (size_t ichan=0; ichan < nchans; ++ichan) {
         delta = 0.0;
-        sum = sum + innovation[ichan][iloc] * dbtdts[ichan][iloc] * varinv_use[ichan][iloc];
-        sum2 = sum2 + dbtdts[ichan][iloc] * dbtdts[ichan][iloc] * varinv_use[ichan][iloc];
+        sum = sum + innovation[ichan][iloc] * dbtdts(ichan, 0, iloc) * varinv_use[ichan][iloc];
+        sum2 = sum2 + dbtdts(ichan, 0, iloc) * dbtdts(ichan, 0, iloc) * varinv_use[ichan][iloc];
       }
       if (fabs(sum2) < FLT_MIN) sum2 = copysign(1.0e-12, sum2);
       dts = std::fabs(sum / sum2);
@@ -342,7 +328,7 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
         }
         for (size_t ichan=0; ichan < nchans; ++ichan) {
           delta = std::max(0.05 * obserr[ichan][iloc], 0.02);
-          if (std::abs(dts * dbtdts[ichan][iloc]) > delta) out[ichan][iloc] = 2;
+          if (std::abs(dts * dbtdts(ichan, 0, iloc)) > delta) out[ichan][iloc] = 2;
         }
       }
     }
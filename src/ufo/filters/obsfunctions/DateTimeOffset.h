@@ -14,6 +14,7 @@
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
 
+#include "oops/util/DateTime.h"
 #include "oops/util/Duration.h"
 #include "oops/util/missingValues.h"
 #include "oops/util/parameters/Parameters.h"
@@ -107,8 +108,8 @@ class DateTimeOffset : public ObsFunctionBase<util::DateTime> {
     const util::DateTime window_end = in.obsspace().windowEnd();
     const util::Duration one_second = util::Duration(1);
 
-    // Get datetime.
-    std::vector <util::DateTime> datetimes(nlocs);
+    // Get datetime. Values at locations whose offset is missing are left unchanged.
+    ioda::ObsDataRow<util::DateTime> & datetimes = out[0];
     in.get(Variable("MetaData/dateTime"), datetimes);
 
     // Get offset variable.
@@ -124,18 +125,16 @@ class DateTimeOffset : public ObsFunctionBase<util::DateTime> {
     for (size_t jloc = 0; jloc < nlocs; ++jloc) {
       const T offset = offsets[jloc];
       // If the offset is missing do not modify the datetime.
-      if (offset == missing) {
-        out[0][jloc] = datetimes[jloc];
-      } else {
-        out[0][jloc] = datetimes[jloc] +
-          util::Duration(static_cast<int64_t>(offset * offsetmult));
-        // Check for the observation remaining within the window
-        if (options_.keep_in_window.value()) {
-          if (out[0][jloc] <= window_start)
-            out[0][jloc] = window_start + one_second;
-          if (out[0][jloc] > window_end)
-            out[0][jloc] = window_end;
-        }
+      if (offset == missing)
+        continue;
+      util::DateTime & datetime = datetimes[jloc];
+      datetime += util::Duration(static_cast<int64_t>(offset * offsetmult));
+      // Check for the observation remaining within the window
+      if (options_.keep_in_window.value()) {
+        if (datetime <= window_start)
+          datetime = window_start + one_second;
+        if (datetime > window_end)
+          datetime = window_end;
       }
     }
   }
@@ -5,6 +5,7 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <exception>
 #include <ostream>
 
 #include "eckit/exception/Exceptions.h"
@@ -140,7 +141,7 @@ DrawValueFromFile<T>::DrawValueFromFile(const eckit::LocalConfiguration &config)
 template <typename ExtractedValue>
 class ExtractVisitor : public boost::static_visitor<void> {
  public:
-  ExtractVisitor(DataExtractor<ExtractedValue> &interpolator, size_t iloc) :
+  ExtractVisitor(typename DataExtractor<ExtractedValue>::Query &interpolator, size_t iloc) :
     interpolator(interpolator), iloc(iloc) {}
 
   template <typename T>
@@ -153,7 +154,7 @@ class ExtractVisitor : public boost::static_visitor<void> {
     interpolator.extract(obDat1[iloc], obDat2[iloc]);
   }
 
-  DataExtractor<ExtractedValue> &interpolator;
+  typename DataExtractor<ExtractedValue>::Query &interpolator;
   size_t iloc;
 };
 
@@ -197,33 +198,56 @@ void DrawValueFromFile<T>::compute(const ObsFilterData & in,
   // Finalise (apply) sort by calling with no arguments.
   interpolator.sort();
 
+  // Locations are processed in parallel, each thread using its own query of the sorted data.
+  const std::ptrdiff_t nlocs = in.nlocs();
   for (size_t jvar = 0; jvar < out.nvars(); ++jvar) {
-    for (size_t iloc = 0; iloc < in.nlocs(); ++iloc) {
-      try {
-        if (options_.chlist.value() != boost::none)
-          interpolator.extract(channels_[jvar]);
-
-        // Perform any extraction methods.
-        ExtractVisitor<T> visitor(interpolator, iloc);
-        for (size_t ind=0; ind < obData.size(); ind++) {
-          // 'interpolationMethod' is a copy to avoid a MetOffice CRAY icpc compile failure.
-          // See https://github.com/JCSDA-internal/ufo/pull/1419
-          ufo::InterpMethod interpolationMethod = interpMethod_.at(obData[ind].first);
-          if ((interpolationMethod == InterpMethod::BILINEAR) && (ind == (obData.size()-2))) {
-            boost::apply_visitor(visitor, obData[ind].second, obData[ind+1].second);
-            break;
-          } else {
-            boost::apply_visitor(visitor, obData[ind].second);
+    std::ptrdiff_t failedLoc = nlocs;
+    std::exception_ptr error;
+#pragma omp parallel
+    {
+      typename DataExtractor<T>::Query query = interpolator.newQuery();
+#pragma omp for schedule(static)
+      for (std::ptrdiff_t iloc = 0; iloc < nlocs; ++iloc) {
+        try {
+          if (options_.chlist.value() != boost::none)
+            query.extract(channels_[jvar]);
+
+          // Perform any extraction methods.
+          ExtractVisitor<T> visitor(query, iloc);
+          for (size_t ind=0; ind < obData.size(); ind++) {
+            // 'interpolationMethod' is a copy to avoid a MetOffice CRAY icpc compile failure.
+            // See https://github.com/JCSDA-internal/ufo/pull/1419
+            ufo::InterpMethod interpolationMethod = interpMethod_.at(obData[ind].first);
+            if ((interpolationMethod == InterpMethod::BILINEAR) && (ind == (obData.size()-2))) {
+              boost::apply_visitor(visitor, obData[ind].second, obData[ind+1].second);
+              break;
+            } else {
+              boost::apply_visitor(visitor, obData[ind].second);
+            }
+          }
+          out[jvar][iloc] = query.getResult();
+        } catch (...) {
+          // Keep the exception thrown at the first failing location (as in a serial run).
+#pragma omp critical(ufo_DrawValueFromFile_compute)
+          if (iloc < failedLoc) {
+            failedLoc = iloc;
+            error = std::current_exception();
           }
+          query = interpolator.newQuery();
         }
-        out[jvar][iloc] = interpolator.getResult();
+      }
+    }
+
+    if (error) {
+      try {
+        std::rethrow_exception(error);
       } catch (const std::exception &ex) {
         // Print extra information that should help the user debug the problem.
         oops::Log::error() << "ERROR: Value extraction failed.\n";
-        oops::Log::error() << "  ObsSpace location: " << iloc << "\n";
+        oops::Log::error() << "  ObsSpace location: " << failedLoc << "\n";
         oops::Log::error() << "  Interpolation variables:\n";
         // Print values of the interpolation variables at this location
-        PrintVisitor visitor(oops::Log::error(), iloc);
+        PrintVisitor visitor(oops::Log::error(), failedLoc);
         for (size_t ind = 0; ind < obData.size(); ++ind) {
           // Variable name
           oops::Log::error() << "    - " << obData[ind].first << ": ";
@@ -0,0 +1,255 @@
+/*
+ * (C) Copyright 2021 NOAA NWS NCEP EMC
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/obsfunctions/LAMDomainCheck/ESGDomainLookup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ufo/filters/obsfunctions/LAMDomainCheck/LAMDomainCheck.interface.h"
+#include "ufo/utils/Constants.h"
+
+namespace ufo {
+
+namespace {
+
+/// Number of lookup cells along each axis of the latitude-longitude grid covering the domain.
+const std::size_t numLookupCells = 128;
+
+/// Relative tolerance used to make cell classification robust to rounding errors.
+const double relativeTolerance = 1e-9;
+
+/// Map a map-space coordinate \p zm >= 0 of the ESG grid with parameter \p a onto the
+/// corresponding "transformed" coordinate (inverse of zttozm in esg_grid_mod.F90). The result
+/// is infinite if all transformed coordinates map onto map-space coordinates smaller than \p zm.
+double zmToZt(double a, double zm) {
+  if (a > 0) {
+    const double ra = std::sqrt(a);
+    if (ra * zm >= 0.5 * M_PI)
+      return std::numeric_limits<double>::infinity();
+    return std::tan(ra * zm) / ra;
+  } else if (a < 0) {
+    const double ra = std::sqrt(-a);
+    return std::tanh(ra * zm) / ra;
+  } else {
+    return zm;
+  }
+}
+
+/// Return the longitude offset \p lon - \p centreLon (in degrees) wrapped to [-180, 180).
+double wrappedLonOffset(double lon, double centreLon) {
+  const double offset = lon - centreLon;
+  return offset - 360.0 * std::floor((offset + 180.0) / 360.0);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+ESGDomainLookup::ESGDomainLookup(float a, float k, float plat, float plon, float pazi,
+                                 float dx, float dy, int npx, int npy)
+  : a_(a), k_(k), plat_(plat), plon_(plon), pazi_(pazi), dx_(dx), dy_(dy), npx_(npx), npy_(npy)
+{
+  // Bounds on the map-space coordinates (in radians) of points inside the domain. As in
+  // lam_domaincheck_esg_c, dx and dy are on the supergrid.
+  const double xmBound[2] = {std::max(npx_ / 2, 0) * (dx_ * Constants::deg2rad * 2),
+                             std::max(npy_ / 2, 0) * (dy_ * Constants::deg2rad * 2)};
+  for (std::size_t i = 0; i < 2; ++i)
+    xtBound_[i] = zmToZt(a_, std::abs(xmBound[i]));
+
+  // The domain lies within the disc of radius r circumscribing the rectangle defined by
+  // xtBound_. Transformed coordinates xt are related to stereographic coordinates xs by
+  // xt = 2 xs / (1 - k |xs|^2), and |xs| = tan(theta / 2), theta being the angular distance from
+  // the grid centre. Find the largest |xs| such that |xt| < r (points with |k| |xs|^2 >= 1
+  // cannot be mapped).
+  const double r = std::hypot(xtBound_[0], xtBound_[1]);
+  double xsMax;
+  if (k_ > 0)
+    xsMax = std::isinf(r) ? 1 / std::sqrt(k_) : r / (std::sqrt(1 + k_ * r * r) + 1);
+  else if (k_ < 0)
+    xsMax = -k_ * r * r >= 1 ? 1 / std::sqrt(-k_) : r / (std::sqrt(1 + k_ * r * r) + 1);
+  else
+    xsMax = 0.5 * r;
+  capRadius_ = std::isinf(xsMax) ? M_PI
+                                 : std::min(M_PI, 2 * std::atan(xsMax) * (1 + 1e-6) + 1e-6);
+
+  const double centreLat = plat_ * Constants::deg2rad;
+  const double centreLon = plon_ * Constants::deg2rad;
+  centre_ = {std::cos(centreLat) * std::cos(centreLon),
+             std::cos(centreLat) * std::sin(centreLon),
+             std::sin(centreLat)};
+
+  classifyCells();
+}
+
+// -----------------------------------------------------------------------------
+
+void ESGDomainLookup::classifyCells() {
+  // Find a latitude-longitude box enclosing the cap
+  const double capRadiusDeg = capRadius_ * Constants::rad2deg;
+  minLat_ = std::max(-90.0, plat_ - capRadiusDeg);
+  maxLat_ = std::min(90.0, plat_ + capRadiusDeg);
+  double maxLonOffset = 180.0;
+  if (plat_ + capRadiusDeg < 90.0 && plat_ - capRadiusDeg > -90.0)
+    maxLonOffset = std::min(180.0, Constants::rad2deg * std::asin(std::min(
+                     1.0, std::sin(capRadius_) / std::cos(plat_ * Constants::deg2rad))));
+  minLonOffset_ = -maxLonOffset;
+  nLat_ = numLookupCells;
+  nLon_ = numLookupCells;
+  dLat_ = (maxLat_ - minLat_) / nLat_;
+  dLon_ = 2 * maxLonOffset / nLon_;
+  cells_.assign(nLat_ * nLon_, CellType::BOUNDARY);
+  if (!(dLat_ > 0 && dLon_ > 0)) {
+    nLat_ = nLon_ = 0;
+    return;
+  }
+
+  // Bound the rate of change of each transformed coordinate with the angular distance travelled
+  // within the cap. Stereographic coordinates change at most (1 + |xs|^2) / 2 times as fast as
+  // the distance travelled; the norm of the Jacobian of the map from xs to xt is at most
+  // 2 / d + 4 |k| |xs|^2 / d^2, where d = 1 - k |xs|^2.
+  const double xsMax = std::tan(0.5 * capRadius_);
+  const double d = k_ > 0 ? 1 - k_ * xsMax * xsMax : 1.0;
+  double lipschitz = std::numeric_limits<double>::infinity();
+  if (d > 0 && std::isfinite(xsMax))
+    lipschitz = 0.5 * (1 + xsMax * xsMax) *
+                (2 / d + 4 * std::abs(k_) * xsMax * xsMax / (d * d));
+
+  // Cells lying wholly within the cap; each is classified by projecting its centre onto the map.
+  std::vector<std::size_t> candidates;
+  std::vector<float> candidateLats, candidateLons;
+  std::vector<double> candidateRadii;
+  for (std::size_t i = 0; i < nLat_; ++i) {
+    const double lat0 = minLat_ + i * dLat_;
+    const double lat1 = lat0 + dLat_;
+    const double maxCosLat = lat0 <= 0 && lat1 >= 0 ? 1.0 :
+      std::cos(std::min(std::abs(lat0), std::abs(lat1)) * Constants::deg2rad);
+    for (std::size_t j = 0; j < nLon_; ++j) {
+      const double lat = lat0 + 0.5 * dLat_;
+      const double lon = plon_ + minLonOffset_ + (j + 0.5) * dLon_;
+      const float latF = static_cast<float>(lat);
+      const float lonF = static_cast<float>(lon);
+      // Upper bound on the angular distance between (latF, lonF) and any point of the cell:
+      // the length of a path along a meridian and then along a parallel.
+      const double cellRadius =
+          (0.5 * dLat_ + std::abs(latF - lat)) * Constants::deg2rad +
+          maxCosLat * (0.5 * dLon_ + std::abs(lonF - lon)) * Constants::deg2rad + 1e-9;
+      const double distance = std::acos(std::max(-1.0, std::min(1.0,
+                                          cosDistanceFromCentre(latF, lonF))));
+      CellType & type = cells_[i * nLon_ + j];
+      if (distance - cellRadius > capRadius_) {
+        type = CellType::OUTSIDE;
+      } else if (distance + cellRadius <= capRadius_) {
+        candidates.push_back(i * nLon_ + j);
+        candidateLats.push_back(latF);
+        candidateLons.push_back(lonF);
+        candidateRadii.push_back(cellRadius);
+      }
+    }
+  }
+  if (candidates.empty() || !std::isfinite(lipschitz))
+    return;
+
+  std::vector<double> xm;
+  std::vector<int> failure, mask;
+  project(candidateLats, candidateLons, xm, failure, mask);
+  const double xmScale[2] = {dx_ * Constants::deg2rad * 2, dy_ * Constants::deg2rad * 2};
+  for (std::size_t c = 0; c < candidates.size(); ++c) {
+    if (failure[c])
+      continue;
+    const double maxChange = lipschitz * candidateRadii[c];
+    bool inside = true, outside = false;
+    for (std::size_t i = 0; i < 2; ++i) {
+      const double xt = zmToZt(a_, std::abs(xm[2 * c + i] * xmScale[i]));
+      inside = inside && xt + maxChange < xtBound_[i] * (1 - relativeTolerance);
+      outside = outside || xt - maxChange > xtBound_[i] * (1 + relativeTolerance);
+    }
+    if (inside)
+      cells_[candidates[c]] = CellType::INSIDE;
+    else if (outside)
+      cells_[candidates[c]] = CellType::OUTSIDE;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ESGDomainLookup::inDomain(const std::vector<float> & lat, const std::vector<float> & lon,
+                               std::vector<int> & mask) const {
+  const std::size_t nlocs = lat.size();
+  mask.assign(nlocs, 0);
+
+  std::vector<std::size_t> boundaryLocs;
+  std::vector<float> boundaryLats, boundaryLons;
+  for (std::size_t jj = 0; jj < nlocs; ++jj) {
+    // Points with invalid coordinates (e.g. missing values) are left to the exact projection.
+    const bool valid = std::abs(lat[jj]) <= 90.0f && std::abs(lon[jj]) <= 720.0f;
+    switch (valid ? cellType(lat[jj], lon[jj]) : CellType::BOUNDARY) {
+    case CellType::INSIDE:
+      mask[jj] = 1;
+      break;
+    case CellType::OUTSIDE:
+      break;
+    case CellType::BOUNDARY:
+      boundaryLocs.push_back(jj);
+      boundaryLats.push_back(lat[jj]);
+      boundaryLons.push_back(lon[jj]);
+      break;
+    }
+  }
+
+  std::vector<double> xm;
+  std::vector<int> failure, boundaryMask;
+  project(boundaryLats, boundaryLons, xm, failure, boundaryMask);
+  for (std::size_t b = 0; b < boundaryLocs.size(); ++b)
+    mask[boundaryLocs[b]] = boundaryMask[b];
+}
+
+// -----------------------------------------------------------------------------
+
+void ESGDomainLookup::project(const std::vector<float> & lat, const std::vector<float> & lon,
+                              std::vector<double> & xm, std::vector<int> & failure,
+                              std::vector<int> & mask) const {
+  const int n = lat.size();
+  xm.assign(2 * n, 0.0);
+  failure.assign(n, 0);
+  mask.assign(n, 0);
+  if (n == 0)
+    return;
+  lam_domaincheck_esg_batch_f90(a_, k_, plat_, plon_, pazi_, npx_, npy_, dx_, dy_,
+                                n, lat[0], lon[0], xm[0], failure[0], mask[0]);
+}
+
+// -----------------------------------------------------------------------------
+
+double ESGDomainLookup::cosDistanceFromCentre(double lat, double lon) const {
+  const double latRad = lat * Constants::deg2rad;
+  const double lonRad = lon * Constants::deg2rad;
+  return centre_[0] * std::cos(latRad) * std::cos(lonRad) +
+         centre_[1] * std::cos(latRad) * std::sin(lonRad) +
+         centre_[2] * std::sin(latRad);
+}
+
+// -----------------------------------------------------------------------------
+
+ESGDomainLookup::CellType ESGDomainLookup::cellType(double lat, double lon) const {
+  if (nLat_ == 0)
+    return CellType::BOUNDARY;
+  // The lookup grid encloses the cap, which encloses the domain
+  const double lonOffset = wrappedLonOffset(lon, plon_);
+  if (lat < minLat_ || lat > maxLat_ || lonOffset < minLonOffset_ || lonOffset > -minLonOffset_)
+    return CellType::OUTSIDE;
+  const std::size_t i = std::min(nLat_ - 1,
+                                 static_cast<std::size_t>((lat - minLat_) / dLat_));
+  const std::size_t j = std::min(nLon_ - 1,
+                                 static_cast<std::size_t>((lonOffset - minLonOffset_) / dLon_));
+  return cells_[i * nLon_ + j];
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
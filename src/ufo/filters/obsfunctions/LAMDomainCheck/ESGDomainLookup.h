@@ -0,0 +1,90 @@
+/*
+ * (C) Copyright 2021 NOAA NWS NCEP EMC
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_OBSFUNCTIONS_LAMDOMAINCHECK_ESGDOMAINLOOKUP_H_
+#define UFO_FILTERS_OBSFUNCTIONS_LAMDOMAINCHECK_ESGDOMAINLOOKUP_H_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace ufo {
+
+/// \brief Determines which points lie inside a limited area domain defined on an Extended
+/// Schmidt Gnomonic (ESG) grid.
+///
+/// The result is identical to that of calling lam_domaincheck_esg_f90() for each point, but
+/// most points are classified without evaluating the ESG projection:
+///
+/// * points further from the grid centre than the radius of a spherical cap enclosing the
+///   domain are rejected straight away;
+/// * the remaining points are looked up in a coarse latitude-longitude grid covering the cap,
+///   whose cells have been classified, when the object was constructed, as lying entirely inside
+///   the domain, entirely outside it, or on its boundary;
+/// * only points falling into boundary cells are projected exactly, in a single batch.
+///
+/// Cells are classified conservatively: a cell is only deemed inside (outside) if a bound on the
+/// variation of the map coordinates across the cell shows that all its points are inside
+/// (outside) the domain.
+class ESGDomainLookup {
+ public:
+  /// Arguments have the same meaning as the parameters of the LAMDomainCheck obs function.
+  ESGDomainLookup(float a, float k, float plat, float plon, float pazi, float dx, float dy,
+                  int npx, int npy);
+
+  /// Set \p mask[i] to 1 if the point (\p lat[i], \p lon[i]) (in degrees) lies inside the domain
+  /// and to 0 otherwise.
+  void inDomain(const std::vector<float> & lat, const std::vector<float> & lon,
+                std::vector<int> & mask) const;
+
+ private:
+  enum class CellType : char { OUTSIDE, INSIDE, BOUNDARY };
+
+  /// Project points onto the map exactly, returning their images \p xm (in grid units,
+  /// two per point), failure flags and domain membership flags.
+  void project(const std::vector<float> & lat, const std::vector<float> & lon,
+               std::vector<double> & xm, std::vector<int> & failure,
+               std::vector<int> & mask) const;
+
+  /// Return the cosine of the angular distance between the grid centre and the point
+  /// (\p lat, \p lon) (in degrees).
+  double cosDistanceFromCentre(double lat, double lon) const;
+
+  /// Return the type of the lookup cell containing the point (\p lat, \p lon) (in degrees).
+  CellType cellType(double lat, double lon) const;
+
+  void classifyCells();
+
+  float a_, k_, plat_, plon_, pazi_, dx_, dy_;
+  int npx_, npy_;
+
+  /// Bounds on the absolute values of the two "transformed" map coordinates (obtained from
+  /// stereographic coordinates before the final, monotonic, stretching along each axis) of
+  /// points inside the domain. May be infinite.
+  std::array<double, 2> xtBound_;
+  /// Angular radius of a spherical cap centred on the grid centre enclosing the domain.
+  double capRadius_;
+  /// Cartesian coordinates of the grid centre.
+  std::array<double, 3> centre_;
+
+  /// Lookup grid covering the cap: cell (i, j) spans latitudes from minLat_ + i * dLat_ to
+  /// minLat_ + (i + 1) * dLat_ and longitude offsets from the grid centre (wrapped to
+  /// [-180, 180)) from minLonOffset_ + j * dLon_ to minLonOffset_ + (j + 1) * dLon_. The grid
+  /// spans latitudes up to maxLat_ and longitude offsets up to -minLonOffset_.
+  double minLat_ = 0.0;
+  double maxLat_ = 0.0;
+  double dLat_ = 1.0;
+  double minLonOffset_ = 0.0;
+  double dLon_ = 1.0;
+  std::size_t nLat_ = 0;
+  std::size_t nLon_ = 0;
+  std::vector<CellType> cells_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_OBSFUNCTIONS_LAMDOMAINCHECK_ESGDOMAINLOOKUP_H_
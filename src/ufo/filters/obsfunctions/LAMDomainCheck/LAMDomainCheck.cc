@@ -11,6 +11,7 @@
 
 #include "oops/util/missingValues.h"
 
+#include "ufo/filters/obsfunctions/LAMDomainCheck/ESGDomainLookup.h"
 #include "ufo/filters/Variable.h"
 
 namespace ufo {
@@ -29,6 +30,15 @@ LAMDomainCheck::LAMDomainCheck(const eckit::LocalConfiguration & conf)
   invars_ += Variable("latitude@MetaData");
   // We must know the longitude of each observation
   invars_ += Variable("longitude@MetaData");
+
+  if (options_.mapproj.value() == "gnomonic_ed") {
+    // Classify the cells of a coarse latitude-longitude grid once; see ESGDomainLookup
+    esgLookup_.reset(new ESGDomainLookup(options_.esg_a.value(), options_.esg_k.value(),
+                                         options_.esg_plat.value(), options_.esg_plon.value(),
+                                         options_.esg_pazi.value(), options_.esg_dx.value(),
+                                         options_.esg_dy.value(), options_.esg_npx.value(),
+                                         options_.esg_npy.value()));
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -90,19 +100,10 @@ void LAMDomainCheck::compute(const ObsFilterData & in,
 
   // get options based off the name of the map projection
   if (options_.mapproj.value() == "gnomonic_ed") {
-    // ESG used in FV3-LAM
-    const float a = options_.esg_a.value();
-    const float k = options_.esg_k.value();
-    const float plat = options_.esg_plat.value();
-    const float plon = options_.esg_plon.value();
-    const float pazi = options_.esg_pazi.value();
-    const float dx = options_.esg_dx.value();
-    const float dy = options_.esg_dy.value();
-    const int npx = options_.esg_npx.value();
-    const int npy = options_.esg_npy.value();
+    // ESG used in FV3-LAM. Most locations are classified with a lookup table; only those
+    // close to the domain boundary are projected onto the grid.
+    esgLookup_->inDomain(latitude, longitude, iidx);
     for (size_t jj = 0; jj < nlocs; ++jj) {
-      lam_domaincheck_esg_f90(a, k, plat, plon, pazi, npx, npy,
-                         dx, dy, latitude[jj], longitude[jj], iidx[jj]);
       out[0][jj] = static_cast<float>(iidx[jj]);
     }
   } else if (options_.mapproj.value() == "circle") {
@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_OBSFUNCTIONS_LAMDOMAINCHECK_LAMDOMAINCHECK_H_
 #define UFO_FILTERS_OBSFUNCTIONS_LAMDOMAINCHECK_LAMDOMAINCHECK_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -24,6 +25,8 @@
 
 namespace ufo {
 
+class ESGDomainLookup;
+
 class LAMDomainCheckParameters : public oops::Parameters {
   OOPS_CONCRETE_PARAMETERS(LAMDomainCheckParameters, Parameters)
 
@@ -62,6 +65,8 @@ class LAMDomainCheck : public ObsFunctionBase<float> {
  private:
   ufo::Variables invars_;
   LAMDomainCheckParameters options_;
+  /// Set up on construction if the map projection is "gnomonic_ed".
+  std::unique_ptr<ESGDomainLookup> esgLookup_;
 };
 
 // -----------------------------------------------------------------------------
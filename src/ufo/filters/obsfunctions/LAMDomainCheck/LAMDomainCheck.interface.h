@@ -22,6 +22,12 @@ extern "C" {
                                const float &, const float &, const float &, const float &,
                                int &);
 
+  void lam_domaincheck_esg_batch_f90(const float &, const float &, const float &, const float &,
+                                     const float &, const int &, const int &,
+                                     const float &, const float &, const int &,
+                                     const float &, const float &,
+                                     double &, int &, int &);
+
   void lam_domaincheck_circle_f90(const float &, const float &, const float &,
                                   const float &, const float &, int &);
 
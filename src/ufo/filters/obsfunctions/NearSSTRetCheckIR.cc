@@ -20,6 +20,7 @@
 #include "oops/util/IntSetParser.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/Variable.h"
+#include "ufo/utils/ChannelLevelLocationArray.h"
 #include "ufo/utils/Constants.h"
 
 namespace ufo {
@@ -88,33 +89,19 @@ void NearSSTRetCheckIR::compute(const ObsFilterData & in,
 
   // Get variables from ObsDiag
   // Get surface temperature jacobian
-  std::vector<std::vector<float>> dbtdts(nchans, std::vector<float>(nlocs));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag",
-                     channels_)[ichan], dbtdts[ichan]);
-  }
+  ChannelLevelLocationArray<float> dbtdts;
+  in.get(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag", channels_),
+         dbtdts);
 
   // Get temperature jacobian
-  std::vector<std::vector<std::vector<float>>>
-       dbtdt(nchans, std::vector<std::vector<float>>(nlevs, std::vector<float>(nlocs)));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
-      const int level = nlevs - ilev - 1;
-      in.get(Variable("brightness_temperature_jacobian_air_temperature@ObsDiag",
-                       channels_)[ichan], level, dbtdt[ichan][ilev]);
-    }
-  }
+  ChannelLevelLocationArray<float> dbtdt;
+  in.get(Variable("brightness_temperature_jacobian_air_temperature@ObsDiag", channels_),
+         dbtdt, true);
 
   // Get moisture jacobian
-  std::vector<std::vector<std::vector<float>>>
-       dbtdq(nchans, std::vector<std::vector<float>>(nlevs, std::vector<float>(nlocs)));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
-      const int level = nlevs - ilev - 1;
-      in.get(Variable("brightness_temperature_jacobian_humidity_mixing_ratio@ObsDiag",
-                       channels_)[ichan], level, dbtdq[ichan][ilev]);
-    }
-  }
+  ChannelLevelLocationArray<float> dbtdq;
+  in.get(Variable("brightness_temperature_jacobian_humidity_mixing_ratio@ObsDiag", channels_),
+         dbtdq, true);
 
   // Get variables from ObsSpace
   // Get sensor band central radiation wavenumber
@@ -195,12 +182,12 @@ void NearSSTRetCheckIR::compute(const ObsFilterData & in,
     if (sea) {
       for (size_t ichan = 0; ichan < nchans; ++ichan) {
         if (use_flag[ichan] >= 1 && varinv[ichan][iloc] > 0.0 && irday[ichan] == 1
-                                 && dbtdts[ichan][iloc] >= tschk) {
-          tb_ta[ichan] = dbtdt[ichan][nlevs-1][iloc];
-          tb_qa[ichan] = dbtdq[ichan][nlevs-1][iloc];
+                                 && dbtdts(ichan, 0, iloc) >= tschk) {
+          tb_ta[ichan] = dbtdt(ichan, nlevs-1, iloc);
+          tb_qa[ichan] = dbtdq(ichan, nlevs-1, iloc);
           for (size_t ilev = 0; ilev < nlevs-1; ++ilev) {
-            tb_ta[ichan] = tb_ta[ichan] + dbtdt[ichan][ilev][iloc];
-            tb_qa[ichan] = tb_qa[ichan] + dbtdq[ichan][ilev][iloc];
+            tb_ta[ichan] = tb_ta[ichan] + dbtdt(ichan, ilev, iloc);
+            tb_qa[ichan] = tb_qa[ichan] + dbtdq(ichan, ilev, iloc);
           }
         }
       }
@@ -215,18 +202,18 @@ void NearSSTRetCheckIR::compute(const ObsFilterData & in,
       // Get coefficients for linear equations
       for (size_t ichan = 0; ichan < nchans; ++ichan) {
         if (use_flag[ichan] >= 1 && varinv[ichan][iloc] > 0.0 && irday[ichan] == 1
-                                 && dbtdts[ichan][iloc] >= tschk) {
+                                 && dbtdts(ichan, 0, iloc) >= tschk) {
           icount = icount + 1;
-          ts_ave = ts_ave + dbtdts[ichan][iloc];
+          ts_ave = ts_ave + dbtdts(ichan, 0, iloc);
           float w_rad = pow((1.0 / obserr[ichan][iloc]), 2);
-          a11 = a11 + w_rad * dbtdts[ichan][iloc] * dbtdts[ichan][iloc];
-          a12 = a12 + w_rad * dbtdts[ichan][iloc] * tb_ta[ichan];
-          a13 = a13 + w_rad * dbtdts[ichan][iloc] * tb_qa[ichan];
+          a11 = a11 + w_rad * dbtdts(ichan, 0, iloc) * dbtdts(ichan, 0, iloc);
+          a12 = a12 + w_rad * dbtdts(ichan, 0, iloc) * tb_ta[ichan];
+          a13 = a13 + w_rad * dbtdts(ichan, 0, iloc) * tb_qa[ichan];
           a22 = a22 + w_rad * tb_ta[ichan] * tb_ta[ichan];
           a23 = a23 + w_rad * tb_ta[ichan] * tb_qa[ichan];
           a33 = a33 + w_rad * tb_qa[ichan] * tb_qa[ichan];
           float varrad = w_rad * innovation[ichan][iloc];
-          c1x = c1x + varrad * dbtdts[ichan][iloc];
+          c1x = c1x + varrad * dbtdts(ichan, 0, iloc);
           c2x = c2x + varrad * tb_ta[ichan];
           c3x = c3x + varrad * tb_qa[ichan];
         }
@@ -250,8 +237,8 @@ void NearSSTRetCheckIR::compute(const ObsFilterData & in,
 
     if (dtz != -999.0) {
       for (size_t ichan = 0; ichan < nchans; ++ichan) {
-        if (use_flag[ichan] >= 1 && varinv[ichan][iloc] > 0.0 && dbtdts[ichan][iloc] > tschk) {
-          float xindx = pow((dbtdts[ichan][iloc] - ts_ave) / (1.0 - ts_ave), 3);
+        if (use_flag[ichan] >= 1 && varinv[ichan][iloc] > 0.0 && dbtdts(ichan, 0, iloc) > tschk) {
+          float xindx = pow((dbtdts(ichan, 0, iloc) - ts_ave) / (1.0 - ts_ave), 3);
           float tzchks = tzchk * pow(0.5, xindx);
           if (std::fabs(dtz) > tzchks) out[ichan][iloc] = 1;
         }
@@ -19,6 +19,7 @@
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/Variable.h"
+#include "ufo/utils/ChannelLevelLocationArray.h"
 #include "ufo/utils/Constants.h"
 #include "ufo/utils/StringUtils.h"
 
@@ -143,8 +144,12 @@ void ObsErrorFactorSurfJacobianRad::compute(const ObsFilterData & in,
   // Calculate error factors for each channel
   std::vector<int> qcflagdata;
   std::vector<float> obserrdata;
-  std::vector<float> dbtdts(nlocs);
-  std::vector<float> dbtdes(nlocs);
+  ChannelLevelLocationArray<float> dbtdts;
+  ChannelLevelLocationArray<float> dbtdes;
+  in.get(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag", channels_),
+         dbtdts);
+  in.get(Variable("brightness_temperature_jacobian_surface_emissivity@ObsDiag", channels_),
+         dbtdes);
   float varinv = 0.0;
   const std::string &errgrp = options_.testObserr.value();
   const std::string &flaggrp = options_.testQCflag.value();
@@ -155,10 +160,6 @@ void ObsErrorFactorSurfJacobianRad::compute(const ObsFilterData & in,
     usebiasterm = options_.useBiasTerm.value().get();
   }
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag",
-                     channels_)[ichan], dbtdts);
-    in.get(Variable("brightness_temperature_jacobian_surface_emissivity@ObsDiag",
-                     channels_)[ichan], dbtdes);
     in.get(Variable("brightness_temperature@"+errgrp, channels_)[ichan], obserrdata);
     in.get(Variable("brightness_temperature@"+flaggrp, channels_)[ichan], qcflagdata);
 
@@ -174,8 +175,8 @@ void ObsErrorFactorSurfJacobianRad::compute(const ObsFilterData & in,
       out[ichan][iloc] = 1.0;
 
       if (varinv > 0.0) {
-        float vaux = demisf[iloc] * std::fabs(dbtdes[iloc]) +
-               dtempf[iloc] * std::fabs(dbtdts[iloc]);
+        float vaux = demisf[iloc] * std::fabs(dbtdes(ichan, 0, iloc)) +
+               dtempf[iloc] * std::fabs(dbtdts(ichan, 0, iloc));
         float term = pow(vaux, 2);
         if (inst == "amsua" || inst == "atms") {
           if (ichan <= ich536 - 1 || ichan == ich890 - 1) term += 0.2 * pow(clwbias[iloc], 2);
@@ -20,8 +20,12 @@ class SolarZenithParameters : public oops::Parameters {
   OOPS_CONCRETE_PARAMETERS(SolarZenithParameters, Parameters)
 
  public:
-  /// Set this option to `true` to skip calculations and produce missing values at locations
-  /// where all simulated variables have been rejected. Default: `false`.
+  /// Set this option to `true` to produce missing values at locations where all simulated
+  /// variables have been rejected. Default: `false`.
+  ///
+  /// Note: the solar geometry is shared with other users (see ObsFilterData::solarGeometry())
+  /// and is therefore computed at all locations, so unlike in earlier versions this option no
+  /// longer saves any computation; it only masks the output.
   oops::Parameter<bool> skipRejected{"skip rejected", false, this};
 };
 
@@ -33,6 +37,9 @@ class SolarZenithParameters : public oops::Parameters {
 /// * Air Almanac: useful for checking GHA and DECL
 /// * Norton's Star Atlas: for equation of time
 /// * Robinson N., Solar Radiation, Ch. 2: for useful introduction to theory/terminology.
+///
+/// The angles are taken from the SolarGeometry shared through ObsFilterData, so that they are
+/// computed once however many filters and where clauses of a filter chain use this function.
 class SolarZenith : public ObsFunctionBase<float> {
  public:
   explicit SolarZenith(const eckit::LocalConfiguration &conf);
@@ -18,6 +18,7 @@
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/Variable.h"
+#include "ufo/utils/ChannelLevelLocationArray.h"
 #include "ufo/utils/Constants.h"
 
 namespace ufo {
@@ -54,7 +55,8 @@ void SymmCldImpactIR::compute(const ObsFilterData & in,
   size_t nlocs = in.nlocs();
 
   // Allocate vectors common across channels
-  std::vector<float> clr(nlocs);
+  ChannelLevelLocationArray<float> clrAll;
+  in.get(Variable("brightness_temperature_assuming_clear_sky@ObsDiag", channels_), clrAll);
   std::vector<float> bak(nlocs);
   std::vector<float> obs(nlocs);
   std::vector<float> bias(nlocs);
@@ -63,7 +65,7 @@ void SymmCldImpactIR::compute(const ObsFilterData & in,
 
   for (size_t ich = 0; ich < SCI.nvars(); ++ich) {
     // Get channel-specific clr, bak, obs, and bias
-    in.get(Variable("brightness_temperature_assuming_clear_sky@ObsDiag", channels_)[ich], clr);
+    const gsl::span<const float> clr = clrAll.level(ich, 0);
     in.get(Variable("brightness_temperature@HofX", channels_)[ich], bak);
     in.get(Variable("brightness_temperature@ObsValue", channels_)[ich], obs);
     if (in.has(Variable("brightness_temperature@ObsBiasData", channels_)[ich])) {
@@ -76,11 +78,11 @@ void SymmCldImpactIR::compute(const ObsFilterData & in,
           obs[iloc] != missing && bias[iloc] != missing) {
         // Temporarily account for ZERO clear-sky BT output from CRTM
         // TODO(JJG): change CRTM clear-sky behavior
-        if (clr[iloc] > -1.0f && clr[iloc] < 1.0f) clr[iloc] = bak[iloc];
+        const float clrValue = (clr[iloc] > -1.0f && clr[iloc] < 1.0f) ? bak[iloc] : clr[iloc];
 
         // HofX contains bias correction; subtracting it here
-        Cmod = std::abs(clr[iloc] - bak[iloc] + bias[iloc]);
-        Cobs = std::abs(clr[iloc] - obs[iloc] + bias[iloc]);
+        Cmod = std::abs(clrValue - bak[iloc] + bias[iloc]);
+        Cobs = std::abs(clrValue - obs[iloc] + bias[iloc]);
         SCI[ich][iloc] = 0.5f * (Cmod + Cobs);
       } else {
         SCI[ich][iloc] = missing;
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "eckit/config/LocalConfiguration.h"
 #include "eckit/types/FloatCompare.h"
 #include "ioda/ObsSpace.h"
 #include "oops/util/IntSetParser.h"
@@ -22,6 +23,7 @@
 #include "ufo/filters/DiagnosticFlag.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/Variables.h"
+#include "ufo/utils/EpochSeconds.h"
 
 namespace ufo {
 
@@ -71,6 +73,36 @@ void processWhereMinMax(const std::vector<util::DateTime> & data,
 }
 
 
+// -----------------------------------------------------------------------------
+/// Equivalent to the overload above, with date/times expressed as epoch seconds and bounds
+/// compiled into integer arithmetic.
+void processWhereMinMax(const std::vector<EpochSeconds> & data,
+                        const boost::optional<PartialDateTimeBound> & vmin,
+                        const boost::optional<PartialDateTimeBound> & vmax,
+                        std::vector<bool> & mask) {
+  const EpochSeconds missing = missingEpochSeconds();
+  for (size_t jj = 0; jj < data.size(); ++jj) {
+    if (data[jj] == missing) continue;
+    if (vmin && vmin->compare(data[jj]) < 0) mask[jj] = false;
+    if (vmax && vmax->compare(data[jj]) > 0) mask[jj] = false;
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+/// Compile the date/time bound stored in option \p key of \p conf (if any) into \p bound.
+/// Return false if the bound is not a string that PartialDateTimeBound can compile.
+bool compileDateTimeBound(const eckit::LocalConfiguration & conf, const std::string & key,
+                          boost::optional<PartialDateTimeBound> & bound) {
+  if (!conf.has(key))
+    return true;
+  if (!conf.isString(key))
+    return false;
+  bound = PartialDateTimeBound::parse(conf.getString(key));
+  return bound != boost::none;
+}
+
+
 // -----------------------------------------------------------------------------
 template<typename T>
 void processWhereIsDefined(const ObsFilterData & filterdata,
@@ -231,9 +263,19 @@ void applyMinMax<util::DateTime>(std::vector<bool> & where, WhereParameters cons
 
   // Apply mask min/max
   if (vmin != not_set_value || vmax != not_set_value) {
-    std::vector<util::DateTime> data;
-    filterdata.get(varname, data);
-    processWhereMinMax(data, vmin, vmax, where);
+    // Compare epoch seconds with compiled bounds if possible, date/time objects otherwise.
+    const eckit::LocalConfiguration conf = parameters.toConfiguration();
+    boost::optional<PartialDateTimeBound> compiledMin, compiledMax;
+    if (compileDateTimeBound(conf, "minvalue", compiledMin) &&
+        compileDateTimeBound(conf, "maxvalue", compiledMax)) {
+      std::vector<EpochSeconds> data;
+      filterdata.getEpochSeconds(varname, data);
+      processWhereMinMax(data, compiledMin, compiledMax, where);
+    } else {
+      std::vector<util::DateTime> data;
+      filterdata.get(varname, data);
+      processWhereMinMax(data, vmin, vmax, where);
+    }
   }
 }
 
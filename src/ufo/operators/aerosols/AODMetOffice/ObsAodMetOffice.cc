@@ -8,6 +8,7 @@
 
 #include "ufo/operators/aerosols/AODMetOffice/ObsAodMetOffice.h"
 
+#include <algorithm>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/utils/Constants.h"
+#include "ufo/utils/LocationChunks.h"
 
 namespace ufo {
 
@@ -84,40 +86,53 @@ void ObsAodMetOffice::simulateObs(const GeoVaLs & geovals, ioda::ObsVector & hof
   std::vector<double> ps(nprofiles);  // surface pressure (Pa)
   geovals.get(ps, "surface_pressure");
 
-  // Get 3-D air pressure on rho levels (Pa), one level at a time
-  std::vector<std::vector<double>> plev(nlevels, std::vector<double>(nprofiles));
-  for (std::size_t i = 0; i < nlevels; ++i) {
-        geovals.getAtLevel(plev[i], "air_pressure_levels", i);
-        }
+  // Get 3-D air pressure on rho levels (Pa); level k starts at element k * nprofiles
+  std::vector<double> plev;
+  geovals.getAllLevels(plev, "air_pressure_levels");
 
   // check model fields are from top-down, fail if not
-  if (plev.front() > plev.back()) {
+  const double *plevTop = plev.data();
+  const double *plevBottom = plev.data() + (nlevels - 1) * nprofiles;
+  if (std::lexicographical_compare(plevBottom, plevBottom + nprofiles,
+                                   plevTop, plevTop + nprofiles)) {
     throw eckit::BadValue("model fields must be ordered from the top down", Here());
   }
 
-  double alpha;
-  std::vector<double> mass(nlevels - 1);  // mass concentration on half (theta) levels
+  std::vector<double> aod(nprofiles, 0.0);
+  std::vector<double> mass;  // mass concentration on half (theta) levels, laid out as plev
   std::string dust_var_name;  // dust variable name in geovals
 
-  // loop over profiles
-  for (size_t p = 0; p < nprofiles; p++) {
-    // loop over dust bins
-    for (size_t d = 0; d < NDustBins_; d++) {
-      // get mass concentration for dust bin d
-      dust_var_name = "mass_fraction_of_dust00" + std::to_string(d+1) + "_in_air";
-      geovals.getAtLocation(mass, dust_var_name, p);
+  // loop over dust bins
+  for (size_t d = 0; d < NDustBins_; d++) {
+    // get mass concentration for dust bin d
+    dust_var_name = "mass_fraction_of_dust00" + std::to_string(d+1) + "_in_air";
+    ASSERT(geovals.nlevs(dust_var_name) >= nlevels - 1);
+    geovals.getAllLevels(mass, dust_var_name);
+    forEachLocationChunk(nprofiles, [&](std::size_t begin, std::size_t end) {
       // start with lowest model layer, using surface pressure
       // NB this assumes the first mass layer is the lowest layer just above the surface
-      alpha = (1.0 / Constants::grav) * (ps[p] - plev[nlevels - 2][p]) * AodKExt_[d];
-      hofx[p] += mass[nlevels - 2] * alpha;
+      const double *pBottom = &plev[(nlevels - 2) * nprofiles];
+      const double *mBottom = &mass[(nlevels - 2) * nprofiles];
+      for (size_t p = begin; p < end; p++) {
+        const double alpha = (1.0 / Constants::grav) * (ps[p] - pBottom[p]) * AodKExt_[d];
+        aod[p] += mBottom[p] * alpha;
+      }
       // loop over the rest of the model layers
       for (size_t k = 0; k < (nlevels - 2); k++) {
-        alpha = (1.0 / Constants::grav) * (plev[k+1][p] - plev[k][p]) * AodKExt_[d];
-        hofx[p] += mass[k]*alpha;
+        const double *pUpper = &plev[k * nprofiles];
+        const double *pLower = &plev[(k+1) * nprofiles];
+        const double *mLayer = &mass[k * nprofiles];
+        for (size_t p = begin; p < end; p++) {
+          const double alpha = (1.0 / Constants::grav) * (pLower[p] - pUpper[p]) * AodKExt_[d];
+          aod[p] += mLayer[p] * alpha;
+        }
       }
-    }
+    });
   }
 
+  for (size_t p = 0; p < nprofiles; p++)
+    hofx[p] = aod[p];
+
   oops::Log::trace() << "ObsAodMetOffice: observation operator run" << std::endl;
 }
 
@@ -8,6 +8,7 @@
 
 #include "ufo/operators/aerosols/AODMetOffice/ObsAodMetOfficeTLAD.h"
 
+#include <algorithm>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/utils/Constants.h"
+#include "ufo/utils/LocationChunks.h"
 
 namespace ufo {
 
@@ -78,45 +80,41 @@ void ObsAodMetOfficeTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics
     std::vector<double> ps(nprofiles);  // surface pressure (Pa)
     geovals.get(ps, "surface_pressure");
 
-    // Get 3-D air pressure on rho levels (Pa), one level at a time
-    std::vector<std::vector<double>> plev(nlevels, std::vector<double>(nprofiles));
-    for (std::size_t i = 0; i < nlevels; ++i) {
-          geovals.getAtLevel(plev[i], "air_pressure_levels", i);
-          }
+    // Get 3-D air pressure on rho levels (Pa); level k starts at element k * nprofiles
+    std::vector<double> plev;
+    geovals.getAllLevels(plev, "air_pressure_levels");
 
     // check model fields are ordered from top down, fail if not
-    if (plev.front() > plev.back()) {
+    const double *plevTop = plev.data();
+    const double *plevBottom = plev.data() + (nlevels - 1) * nprofiles;
+    if (std::lexicographical_compare(plevBottom, plevBottom + nprofiles,
+                                     plevTop, plevTop + nprofiles)) {
       throw eckit::BadValue("model fields must be ordered from top down", Here());
     }
 
     // calculate dAOD/dmass for each bin, level and profile
 
     // (Re)initialise the Jacobian matrix
-    if (!kMatrix_.empty()) kMatrix_.clear();
-
-    kMatrix_.resize(NDustBins_);
-    for (size_t d = 0; d < NDustBins_; d++)
-    {
-        kMatrix_[d].resize(nlevels - 1);
-        for (size_t k = 0; k < (nlevels - 1); k++)
-        {
-           kMatrix_[d][k].resize(nprofiles);
-        }
-    }
+    kMatrix_.assign(NDustBins_ * (nlevels - 1) * nprofiles, 0.0);
 
-    // loop over profiles
-    for (size_t p = 0; p < nprofiles; p++) {
-      // loop over dust bins and calculate gradient w.r.t mass concentration per bin:
-      for (size_t d = 0; d < NDustBins_; d++) {
+    // loop over dust bins and calculate gradient w.r.t mass concentration per bin:
+    for (size_t d = 0; d < NDustBins_; d++) {
+      double *kBin = &kMatrix_[d * (nlevels - 1) * nprofiles];
+      forEachLocationChunk(nprofiles, [&](std::size_t begin, std::size_t end) {
         // lowest model layer:
-        kMatrix_[d][nlevels - 2][p] = (1.0 / Constants::grav) * (ps[p] - plev[nlevels - 2][p]) *
-                AodKExt_[d];
+        double *kBottom = kBin + (nlevels - 2) * nprofiles;
+        const double *pBottom = &plev[(nlevels - 2) * nprofiles];
+        for (size_t p = begin; p < end; p++)
+          kBottom[p] = (1.0 / Constants::grav) * (ps[p] - pBottom[p]) * AodKExt_[d];
         // loop over the rest of the model layers
         for (size_t k = 0; k < (nlevels - 2); k++) {
-          kMatrix_[d][k][p] = (1.0 / Constants::grav) * (plev[k+1][p] - plev[k][p]) *
-                  AodKExt_[d];
+          double *kLayer = kBin + k * nprofiles;
+          const double *pUpper = &plev[k * nprofiles];
+          const double *pLower = &plev[(k+1) * nprofiles];
+          for (size_t p = begin; p < end; p++)
+            kLayer[p] = (1.0 / Constants::grav) * (pLower[p] - pUpper[p]) * AodKExt_[d];
         }
-      }
+      });
     }
     trajInit_ = true;
 }
@@ -133,23 +131,34 @@ void ObsAodMetOfficeTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector
     ASSERT(geovals.nlocs() == hofx.nlocs());
     hofx.zero();
 
+    // Check dimensions against trajectory
+    ASSERT(kMatrix_.size() == NDustBins_ * (nlevels - 1) * nprofiles);
+
     // calculate tangent linear
 
-    std::vector<double> mass_d(nlevels - 1);  // mass concentration increments
+    std::vector<double> aod_d(nprofiles, 0.0);
+    std::vector<double> mass_d;  // mass concentration increments, laid out as each bin of kMatrix_
     std::string dust_var_name;  // dust variable name in geovals
-    // loop over profiles
-    for (size_t p = 0; p < nprofiles; p++) {
-      // loop over dust bins and calculate gradient w.r.t mass concentration per bin:
-      for (size_t d = 0; d < NDustBins_; d++) {
-        dust_var_name = "mass_fraction_of_dust00" + std::to_string(d+1) + "_in_air";
-        geovals.getAtLocation(mass_d, dust_var_name, p);
+    // loop over dust bins and accumulate the contribution of each bin:
+    for (size_t d = 0; d < NDustBins_; d++) {
+      dust_var_name = "mass_fraction_of_dust00" + std::to_string(d+1) + "_in_air";
+      ASSERT(geovals.nlevs(dust_var_name) >= nlevels - 1);
+      geovals.getAllLevels(mass_d, dust_var_name);
+      const double *kBin = &kMatrix_[d * (nlevels - 1) * nprofiles];
+      forEachLocationChunk(nprofiles, [&](std::size_t begin, std::size_t end) {
         // loop over model layers
-        for (size_t k=0; k < (nlevels - 1); k++) {
-          hofx[p] += kMatrix_[d][k][p] * mass_d[k];
+        for (size_t k = 0; k < (nlevels - 1); k++) {
+          const double *kLayer = kBin + k * nprofiles;
+          const double *mLayer = &mass_d[k * nprofiles];
+          for (size_t p = begin; p < end; p++)
+            aod_d[p] += kLayer[p] * mLayer[p];
         }
-      }
+      });
     }
 
+    for (size_t p = 0; p < nprofiles; p++)
+      hofx[p] = aod_d[p];
+
   oops::Log::trace() << "ObsAodMetOfficeTLAD: TL observation operator run" << std::endl;
 }
 
@@ -169,25 +178,35 @@ void ObsAodMetOfficeTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector
   // Get the missing value indicator
   const double missing = util::missingValue(missing);
 
-  // Loop through the obs, adding the increment to the model state
+  // Check dimensions against trajectory
+  ASSERT(kMatrix_.size() == NDustBins_ * (nlevels - 1) * nprofiles);
+
+  // Zero the observation increments that are missing
+  std::vector<double> aod_d(nprofiles);
+  for (size_t p = 0; p < nprofiles; p++)
+    aod_d[p] = hofx[p] != missing ? hofx[p] : 0.0;
+
+  // Add the increment to the model state
 
-  std::vector<double> mass_d(nlevels - 1);  // mass concentration increments on half (theta) levels
+  std::vector<double> mass_d;  // mass concentration increments, laid out as each bin of kMatrix_
   std::string dust_var_name;  // dust variable name in geovals
-  // loop over profiles
-  for (size_t p = 0; p < nprofiles; p++) {
-    if (hofx[p] != missing) {
-      // loop over dust bins and calculate gradient w.r.t mass concentration per bin:
-      for (size_t d = 0; d < NDustBins_; d++) {
-        dust_var_name = "mass_fraction_of_dust00" + std::to_string(d+1) + "_in_air";
-        geovals.getAtLocation(mass_d, dust_var_name, p);
-        // loop over the model layers
-        for (size_t k=0; k < (nlevels - 1); k++) {
-          mass_d[k] += kMatrix_[d][k][p] * hofx[p];
-        }
-        // Store the updated model state increments
-        geovals.putAtLocation(mass_d, dust_var_name, p);
+  // loop over dust bins and calculate gradient w.r.t mass concentration per bin:
+  for (size_t d = 0; d < NDustBins_; d++) {
+    dust_var_name = "mass_fraction_of_dust00" + std::to_string(d+1) + "_in_air";
+    ASSERT(geovals.nlevs(dust_var_name) >= nlevels - 1);
+    geovals.getAllLevels(mass_d, dust_var_name);
+    const double *kBin = &kMatrix_[d * (nlevels - 1) * nprofiles];
+    forEachLocationChunk(nprofiles, [&](std::size_t begin, std::size_t end) {
+      // loop over the model layers
+      for (size_t k = 0; k < (nlevels - 1); k++) {
+        const double *kLayer = kBin + k * nprofiles;
+        double *mLayer = &mass_d[k * nprofiles];
+        for (size_t p = begin; p < end; p++)
+          mLayer[p] += kLayer[p] * aod_d[p];
       }
-    }
+    });
+    // Store the updated model state increments
+    geovals.putAllLevels(mass_d, dust_var_name);
   }
 
   oops::Log::trace() << "ObsAodMetOfficeTLAD: adjoint observation operator run" << std::endl;
@@ -83,7 +83,8 @@ class ObsAodMetOfficeTLAD : public LinearObsOperatorBase,
  private:
   void print(std::ostream &) const override;
   oops::Variables varin_;
-  std::vector<std::vector<std::vector<double>>> kMatrix_;
+  /// dAOD/dmass; level k of bin d starts at element (d * (nlevels - 1) + k) * nprofiles
+  std::vector<double> kMatrix_;
   bool trajInit_;
   std::size_t NDustBins_;  // Number of dust bins
   std::vector<double> AodKExt_;  // Extinction coefficients per bin, independent of humidity
@@ -49,20 +49,12 @@ void ObsCategorical::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                                  ObsDiagnostics & ydiags) const {
   oops::Log::trace() << "ObsCategorical: simulateObs entered" << std::endl;
 
-  oops::Log::debug() << "Running operators" << std::endl;
+  oops::Log::debug() << "Running operators and producing final ObsVector" << std::endl;
 
-  // Container of ObsVectors produced by each operator.
-  std::map <std::string, ioda::ObsVector> ovecs;
-  // Run each operator and store output in ovecs.
-  for (const auto& component : data_.components()) {
-    ioda::ObsVector ovecTemp(ovec);
-    component.second->simulateObs(gv, ovecTemp, ydiags);
-    ovecs.insert({component.first, ovecTemp});
-  }
-
-  oops::Log::debug() << "Producing final ObsVector" << std::endl;
-
-  data_.fillHofX(ovecs, ovec);
+  // Run each operator used at one or more locations and insert its output into ovec.
+  data_.simulate(ovec, [&](const ObsOperatorBase & oper, ioda::ObsVector & ovecOper) {
+                   oper.simulateObs(gv, ovecOper, ydiags);
+                 });
 
   oops::Log::trace() << "ObsCategorical: simulateObs finished" <<  std::endl;
 }
@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "ioda/distribution/Accumulator.h"
 #include "ioda/ObsVector.h"
 
 #include "oops/base/Variables.h"
@@ -108,6 +109,7 @@ class ObsCategoricalData  {
                               it_operName->second :
                               fallbackOperatorName_);
       locOperNames_.emplace_back(operName);
+      operatorLocations_[operName].push_back(jloc);
     }
 
     // Create list of component operators.
@@ -152,6 +154,27 @@ class ObsCategoricalData  {
                              "the 'operator labels' configuration option to differentiate between "
                              "them", Here());
     }
+
+    // Find the operators assigned to at least one location on any MPI task, the one with most
+    // locations first. Components may perform collective MPI operations, so all tasks must run
+    // the same components in the same order.
+    std::vector<std::string> operNames;
+    for (const auto &component : components_)
+      operNames.push_back(component.first);
+    std::unique_ptr<ioda::Accumulator<std::vector<size_t>>> countAccumulator =
+      odb.distribution()->createAccumulator<size_t>(operNames.size());
+    for (size_t jop = 0; jop < operNames.size(); ++jop)
+      for (size_t jloc : operatorLocations_[operNames[jop]])
+        countAccumulator->addTerm(jloc, jop, 1);
+    const std::vector<size_t> counts = countAccumulator->computeResult();
+    std::vector<size_t> activeOperators;
+    for (size_t jop = 0; jop < operNames.size(); ++jop)
+      if (counts[jop] > 0)
+        activeOperators.push_back(jop);
+    std::stable_sort(activeOperators.begin(), activeOperators.end(),
+                     [&counts](size_t a, size_t b) {return counts[a] > counts[b];});
+    for (size_t jop : activeOperators)
+      activeOperatorNames_.push_back(operNames[jop]);
   }
 
   /// Return required variables for the operator.
@@ -163,18 +186,48 @@ class ObsCategoricalData  {
   /// Return list of operator names to use at each location.
   const std::vector<std::string> & locOperNames() const {return locOperNames_;}
 
-  /// Fill final H(x) vector from a list of components.
-  void fillHofX(const std::map <std::string, ioda::ObsVector> & ovecs,
+  /// Return names of the operators used at one or more locations on any MPI task, in decreasing
+  /// order of the total number of these locations. The list is the same on all tasks.
+  const std::vector<std::string> & activeOperatorNames() const {return activeOperatorNames_;}
+
+  /// Return the locations on this MPI task at which operator \p operName is used.
+  const std::vector<size_t> & operatorLocations(const std::string & operName) const {
+    return operatorLocations_.at(operName);
+  }
+
+  /// Fill final H(x) vector \p ovec with the values of \p ovecOper at the locations at which
+  /// operator \p operName is used.
+  void fillHofX(const std::string & operName, const ioda::ObsVector & ovecOper,
                 ioda::ObsVector & ovec) const {
-    // Insert values into ovec according to the categorical variable.
-    // Use the fallback operator when necessary.
-    for (size_t jloc = 0; jloc < ovec.nlocs(); ++jloc) {
-      const auto &ovecloc = ovecs.at(locOperNames_[jloc]);
-      // Loop over each variable at this location.
-      for (size_t jvar = 0; jvar < ovec.nvars(); ++jvar) {
-        const size_t idx = jloc * ovec.nvars() + jvar;
-        ovec[idx] = ovecloc[idx];
-      }
+    const size_t nvars = ovec.nvars();
+    for (size_t jloc : operatorLocations_.at(operName))
+      for (size_t jvar = 0; jvar < nvars; ++jvar)
+        ovec[jloc * nvars + jvar] = ovecOper[jloc * nvars + jvar];
+  }
+
+  /// Produce the final H(x) vector \p ovec by calling \p simulate(op, ovecOper) for each operator
+  /// used at one or more locations.
+  ///
+  /// Operators used at no location are not run. The operator used at most locations writes its
+  /// output directly to \p ovec; the others write to a single scratch vector (reset to the
+  /// input value of \p ovec before each call), whose values at the locations at which they are
+  /// used are then copied to \p ovec.
+  template <typename SimulateFunction>
+  void simulate(ioda::ObsVector & ovec, const SimulateFunction & simulate) const {
+    if (activeOperatorNames_.size() <= 1) {
+      for (const std::string & operName : activeOperatorNames_)
+        simulate(*components_.at(operName), ovec);
+      return;
+    }
+    const ioda::ObsVector ovecInput(ovec);
+    ioda::ObsVector ovecOper(ovec);
+    simulate(*components_.at(activeOperatorNames_.front()), ovec);
+    for (size_t jop = 1; jop < activeOperatorNames_.size(); ++jop) {
+      const std::string & operName = activeOperatorNames_[jop];
+      if (jop > 1)
+        ovecOper = ovecInput;
+      simulate(*components_.at(operName), ovecOper);
+      fillHofX(operName, ovecOper, ovec);
     }
   }
 
@@ -202,6 +255,13 @@ class ObsCategoricalData  {
 
   /// Operator name at each location.
   std::vector<std::string> locOperNames_;
+
+  /// Locations on this MPI task at which each component operator is used.
+  std::map<std::string, std::vector<size_t>> operatorLocations_;
+
+  /// Names of the operators used at one or more locations on any MPI task, the one used at most
+  /// locations first.
+  std::vector<std::string> activeOperatorNames_;
 };
 
 }  // namespace ufo
@@ -9,14 +9,18 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <ostream>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "ioda/ObsVector.h"
 
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.h"
+#include "ufo/GeoVaLsIndexMap.h"
 #include "ufo/operators/categoricaloper/ObsCategoricalParameters.h"
 
 namespace ufo {
@@ -48,9 +52,9 @@ void ObsCategoricalTLAD::setTrajectory(const GeoVaLs & geovals,
                                        ObsDiagnostics & ydiags) {
   oops::Log::trace() << "ObsCategoricalTLAD: setTrajectory entered" << std::endl;
 
-  // Set trajectory for each operator.
-  for (const auto& component : data_.components())
-    component.second->setTrajectory(geovals, ydiags);
+  // Set trajectory for each operator used at one or more locations.
+  for (const std::string & operName : data_.activeOperatorNames())
+    data_.components().at(operName)->setTrajectory(geovals, ydiags);
 
   oops::Log::trace() << "ObsCategoricalTLAD: setTrajectory finished" <<  std::endl;
 }
@@ -60,20 +64,12 @@ void ObsCategoricalTLAD::setTrajectory(const GeoVaLs & geovals,
 void ObsCategoricalTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec) const {
   oops::Log::trace() << "ObsCategoricalTLAD: simulateObsTL entered" << std::endl;
 
-  oops::Log::debug() << "Running TL operators" << std::endl;
+  oops::Log::debug() << "Running TL operators and producing final TL" << std::endl;
 
-  // Container of ObsVectors produced by each TL operator.
-  std::map <std::string, ioda::ObsVector> ovecs;
-  // Run each TL operator and store output in ovecs.
-  for (const auto& component : data_.components()) {
-    ioda::ObsVector ovecTemp(ovec);
-    component.second->simulateObsTL(geovals, ovecTemp);
-    ovecs.insert({component.first, ovecTemp});
-  }
-
-  oops::Log::debug() << "Producing final TL" << std::endl;
-
-  data_.fillHofX(ovecs, ovec);
+  // Run each TL operator used at one or more locations and insert its output into ovec.
+  data_.simulate(ovec, [&](const LinearObsOperatorBase & oper, ioda::ObsVector & ovecOper) {
+                   oper.simulateObsTL(geovals, ovecOper);
+                 });
 
   oops::Log::trace() << "ObsCategoricalTLAD: simulateObsTL finished" <<  std::endl;
 }
@@ -85,30 +81,20 @@ void ObsCategoricalTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector
 
   oops::Log::debug() << "Running AD operators" << std::endl;
 
-  // Container of GeoVaLs produced by each AD operator.
-  std::map <std::string, GeoVaLs> gvals;
-  // Run each AD operator and store output in gvals.
-  for (const auto& component : data_.components()) {
-    GeoVaLs gvalTemp(geovals);
-    component.second->simulateObsAD(gvalTemp, ovec);
-    gvals.insert({component.first, gvalTemp});
-  }
-
-  oops::Log::debug() << "Producing final AD" << std::endl;
-
-  // Insert values into geovals according to the categorical variable.
-  // Use the fallback operator when necessary.
-  const std::vector<std::string> &varnames = ovec.varnames().variables();
-  std::vector <double> vecgv;
-  for (size_t jloc = 0; jloc < ovec.nlocs(); ++jloc) {
-    const auto &operName = data_.locOperNames()[jloc];
-    const auto &gvaloper = gvals.at(operName);
-    // Loop over each variable at this location.
-    for (const auto& varname : varnames) {
-      vecgv.resize(gvaloper.nlevs(varname));
-      gvaloper.getAtLocation(vecgv, varname, jloc);
-      geovals.putAtLocation(vecgv, varname, jloc);
-    }
+  // The AD operator used at most locations accumulates directly into geovals. Each of the
+  // others is run on a copy of the input geovals, whose values at the locations at which it
+  // is used are then copied into geovals.
+  const std::vector<std::string> & operNames = data_.activeOperatorNames();
+  std::unique_ptr<const GeoVaLs> geovalsInput;
+  if (operNames.size() > 1)
+    geovalsInput.reset(new GeoVaLs(geovals));
+  if (!operNames.empty())
+    data_.components().at(operNames.front())->simulateObsAD(geovals, ovec);
+  for (size_t jop = 1; jop < operNames.size(); ++jop) {
+    GeoVaLs gvalOper(*geovalsInput);
+    data_.components().at(operNames[jop])->simulateObsAD(gvalOper, ovec);
+    const std::vector<size_t> & locs = data_.operatorLocations(operNames[jop]);
+    gvalOper.scatter(geovals, GeoVaLsIndexMap(locs, locs));
   }
 
   oops::Log::trace() << "ObsCategoricalTLAD: simulateObsAD finished" <<  std::endl;
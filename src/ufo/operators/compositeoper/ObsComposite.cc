@@ -21,6 +21,7 @@
 #include "ufo/Locations.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/operators/compositeoper/ObsCompositeParameters.h"
+#include "ufo/operators/compositeoper/ObsCompositeUtils.h"
 
 namespace ufo {
 
@@ -29,7 +30,7 @@ static ObsOperatorMaker<ObsComposite> obsCompositeMaker_("Composite");
 // -----------------------------------------------------------------------------
 
 ObsComposite::ObsComposite(const ioda::ObsSpace & odb, const Parameters_ & parameters)
-  : ObsOperatorBase(odb), odb_(odb)
+  : ObsOperatorBase(odb), odb_(odb), concurrent_(parameters.concurrent)
 {
   oops::Log::trace() << "ObsComposite constructor starting" << std::endl;
 
@@ -57,8 +58,11 @@ void ObsComposite::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                               ObsDiagnostics & ydiags) const {
   oops::Log::trace() << "ObsComposite: simulateObs entered" << std::endl;
 
-  for (const std::unique_ptr<ObsOperatorBase> &component : components_)
-    component->simulateObs(gv, ovec, ydiags);
+  // Components write to disjoint rows of ovec, so they can safely run concurrently.
+  forEachComponent(components_, concurrent_, ydiags,
+                   [&](const ObsOperatorBase &component, ObsDiagnostics &diags) {
+    component.simulateObs(gv, ovec, diags);
+  });
 
   oops::Log::trace() << "ObsComposite: simulateObs exit " <<  std::endl;
 }
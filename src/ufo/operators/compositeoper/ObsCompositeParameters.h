@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/RequiredParameter.h"
 #include "ufo/ObsOperatorParametersBase.h"
 
@@ -24,6 +25,14 @@ class ObsCompositeParameters : public ObsOperatorParametersBase {
  public:
   /// A list of configuration options for each operator used to simulate a subset of variables.
   oops::RequiredParameter<std::vector<eckit::LocalConfiguration>> components{"components", this};
+
+  /// If true, the components are run concurrently (using OpenMP threads) rather than one after
+  /// another. Each component writes only the rows of the H(x) vector holding the variables it
+  /// simulates, so no locking is needed, but the components must be thread-safe. Each component
+  /// fills its own diagnostics, which are gathered once all components have finished, so no two
+  /// components may compute the same diagnostic. In the adjoint, components are only run
+  /// concurrently if no two of them require the same GeoVaLs.
+  oops::Parameter<bool> concurrent{"run components concurrently", false, this};
 };
 
 }  // namespace ufo
@@ -18,6 +18,7 @@
 
 #include "ufo/GeoVaLs.h"
 #include "ufo/operators/compositeoper/ObsCompositeParameters.h"
+#include "ufo/operators/compositeoper/ObsCompositeUtils.h"
 
 namespace ufo {
 
@@ -26,18 +27,23 @@ static LinearObsOperatorMaker<ObsCompositeTLAD> makerCompositeTL_("Composite");
 // -----------------------------------------------------------------------------
 
 ObsCompositeTLAD::ObsCompositeTLAD(const ioda::ObsSpace & odb, const Parameters_ & parameters)
-  : LinearObsOperatorBase(odb)
+  : LinearObsOperatorBase(odb), concurrent_(parameters.concurrent), concurrentAD_(false)
 {
   oops::Log::trace() << "ObsCompositeTLAD constructor starting" << std::endl;
 
+  size_t totalRequiredVars = 0;
   for (const eckit::LocalConfiguration &operatorConfig : parameters.components.value()) {
     LinearObsOperatorParametersWrapper operatorParams;
     operatorParams.validateAndDeserialize(operatorConfig);
     std::unique_ptr<LinearObsOperatorBase> op(
           LinearObsOperatorFactory::create(odb, operatorParams.operatorParameters));
-    requiredVars_ += op->requiredVars();
+    oops::Variables componentVars;
+    componentVars += op->requiredVars();
+    totalRequiredVars += componentVars.size();
+    requiredVars_ += componentVars;
     components_.push_back(std::move(op));
   }
+  concurrentAD_ = concurrent_ && totalRequiredVars == requiredVars_.size();
 
   oops::Log::trace() << "ObsCompositeTLAD created." << std::endl;
 }
@@ -53,8 +59,10 @@ ObsCompositeTLAD::~ObsCompositeTLAD() {
 void ObsCompositeTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics & ydiags) {
   oops::Log::trace() << "ObsCompositeTLAD: setTrajectory entered" << std::endl;
 
-  for (const std::unique_ptr<LinearObsOperatorBase> &component : components_)
-    component->setTrajectory(geovals, ydiags);
+  forEachComponent(components_, concurrent_, ydiags,
+                   [&](LinearObsOperatorBase &component, ObsDiagnostics &diags) {
+    component.setTrajectory(geovals, diags);
+  });
 
   oops::Log::trace() << "ObsCompositeTLAD: setTrajectory exit " <<  std::endl;
 }
@@ -64,8 +72,9 @@ void ObsCompositeTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics & y
 void ObsCompositeTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec) const {
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsTL entered" << std::endl;
 
-  for (const std::unique_ptr<LinearObsOperatorBase> &component : components_)
-    component->simulateObsTL(geovals, ovec);
+  forEachComponent(components_, concurrent_, [&](const LinearObsOperatorBase &component) {
+    component.simulateObsTL(geovals, ovec);
+  });
 
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsTL exit " <<  std::endl;
 }
@@ -75,8 +84,9 @@ void ObsCompositeTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector &
 void ObsCompositeTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector & ovec) const {
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsAD entered" << std::endl;
 
-  for (const std::unique_ptr<LinearObsOperatorBase> &component : components_)
-    component->simulateObsAD(geovals, ovec);
+  forEachComponent(components_, concurrentAD_, [&](const LinearObsOperatorBase &component) {
+    component.simulateObsAD(geovals, ovec);
+  });
 
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsAD exit " <<  std::endl;
 }
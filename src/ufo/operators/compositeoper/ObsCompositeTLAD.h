@@ -57,6 +57,10 @@ class ObsCompositeTLAD : public LinearObsOperatorBase,
  private:
   std::vector<std::unique_ptr<LinearObsOperatorBase>> components_;
   oops::Variables requiredVars_;
+  bool concurrent_;
+  /// True if the components can run their adjoints concurrently, i.e. no two of them require
+  /// the same GeoVaLs (into which the adjoints accumulate).
+  bool concurrentAD_;
 };
 
 // -----------------------------------------------------------------------------
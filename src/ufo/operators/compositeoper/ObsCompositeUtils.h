@@ -0,0 +1,89 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OPERATORS_COMPOSITEOPER_OBSCOMPOSITEUTILS_H_
+#define UFO_OPERATORS_COMPOSITEOPER_OBSCOMPOSITEUTILS_H_
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "ufo/ObsDiagnostics.h"
+
+namespace ufo {
+
+/// \brief Call \p processComponent(icomp) for each \p icomp from 0 to \p ncomponents - 1.
+///
+/// If \p concurrent is true and OpenMP is available, the components are processed concurrently,
+/// each by a single thread, so the total cost is bounded by that of the most expensive component
+/// rather than the sum of the costs of all components. An exception thrown by any component is
+/// rethrown once all components have been processed.
+template <typename ComponentFunction>
+void forEachComponentIndex(size_t ncomponents, bool concurrent,
+                           const ComponentFunction &processComponent) {
+  if (!concurrent || ncomponents < 2) {
+    for (size_t icomp = 0; icomp < ncomponents; ++icomp)
+      processComponent(icomp);
+    return;
+  }
+
+  const std::ptrdiff_t n = ncomponents;
+  std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+  for (std::ptrdiff_t icomp = 0; icomp < n; ++icomp) {
+    try {
+      processComponent(icomp);
+    } catch (...) {
+#pragma omp critical(ufo_forEachComponent)
+      if (!error)
+        error = std::current_exception();
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+/// \brief Call \p processComponent for each element of \p components (see
+/// forEachComponentIndex()).
+template <typename Component, typename ComponentFunction>
+void forEachComponent(const std::vector<std::unique_ptr<Component>> &components,
+                      bool concurrent, const ComponentFunction &processComponent) {
+  forEachComponentIndex(components.size(), concurrent, [&](size_t icomp) {
+    processComponent(*components[icomp]);
+  });
+}
+
+/// \brief Call \p processComponent(component, diags) for each element of \p components.
+///
+/// If the components are processed concurrently, each of them gets its own diagnostics, since
+/// operators allocate and fill the diagnostics they compute without locking. These are copied
+/// to \p ydiags once all components have been processed; two components may not compute the
+/// same diagnostic. Otherwise all components use \p ydiags directly.
+template <typename Component, typename ComponentFunction>
+void forEachComponent(const std::vector<std::unique_ptr<Component>> &components,
+                      bool concurrent, ObsDiagnostics &ydiags,
+                      const ComponentFunction &processComponent) {
+  if (!concurrent || components.size() < 2) {
+    for (const std::unique_ptr<Component> &component : components)
+      processComponent(*component, ydiags);
+    return;
+  }
+
+  std::vector<std::unique_ptr<ObsDiagnostics>> componentDiags;
+  for (size_t icomp = 0; icomp < components.size(); ++icomp)
+    componentDiags.push_back(ydiags.emptyCopy());
+  forEachComponentIndex(components.size(), concurrent, [&](size_t icomp) {
+    processComponent(*components[icomp], *componentDiags[icomp]);
+  });
+  for (const std::unique_ptr<ObsDiagnostics> &diags : componentDiags)
+    ydiags.copyAllocated(*diags);
+}
+
+}  // namespace ufo
+
+#endif  // UFO_OPERATORS_COMPOSITEOPER_OBSCOMPOSITEUTILS_H_
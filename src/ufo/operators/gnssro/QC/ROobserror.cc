@@ -7,6 +7,8 @@
 
 #include "ufo/operators/gnssro/QC/ROobserror.h"
 
+#include <vector>
+
 #include "eckit/config/Configuration.h"
 
 #include "ioda/ObsDataVector.h"
@@ -14,6 +16,7 @@
 #include "ioda/ObsVector.h"
 #include "oops/util/Logger.h"
 #include "ufo/GeoVaLs.h"
+#include "ufo/GeoVaLsSubsetView.h"
 
 namespace ufo {
 
@@ -75,15 +78,20 @@ void ROobserror::applyFilter(const std::vector<bool> & apply,
 
 Eigen::ArrayXXf ROobserror::get_geovals(const std::string& var_name) const {
     // Get the geovals
-    // Note that ROPP has more geovals than observation locations, and this converts to
-    // the correct number (there are n_horiz geovals for every observation)
-    size_t nlocs = obsdb_.nlocs() * static_cast<size_t>(n_horiz);
-    ASSERT(nlocs == data_.getGeoVaLs()->nlocs());
+    // Note that ROPP has more geovals than observation locations (there are n_horiz geovals
+    // for every observation). Only the central one of each observation is used, so view just
+    // those.
+    size_t nlocs = obsdb_.nlocs();
+    ASSERT(nlocs * static_cast<size_t>(n_horiz) == data_.getGeoVaLs()->nlocs());
+    std::vector<size_t> centralLocations(nlocs);
+    for (size_t iloc = 0; iloc < nlocs; ++iloc)
+        centralLocations[iloc] = iloc * n_horiz + (n_horiz - 1) / 2;
+    const GeoVaLsSubsetView centralGeoVaLs(*data_.getGeoVaLs(), centralLocations);
     size_t nlevs = data_.nlevs(Variable(var_name));
     Eigen::ArrayXXf all_geovals(nlocs, nlevs);
     std::vector<float> single_geoval(nlocs);
     for (int ilev=0; ilev < static_cast<int>(nlevs); ilev++) {
-        data_.getGeoVaLs()->getAtLevel(single_geoval, Variable(var_name).variable(), ilev);
+        centralGeoVaLs.getAtLevel(single_geoval, Variable(var_name).variable(), ilev);
         all_geovals.col(ilev) = Eigen::VectorXf::Map(single_geoval.data(), single_geoval.size());
     }
     return all_geovals;
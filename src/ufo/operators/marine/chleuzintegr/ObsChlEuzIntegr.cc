@@ -18,6 +18,7 @@
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/utils/Constants.h"
+#include "ufo/utils/LocationChunks.h"
 
 namespace ufo {
 
@@ -44,38 +45,45 @@ ObsChlEuzIntegr::~ObsChlEuzIntegr() {
 // -----------------------------------------------------------------------------
 void ObsChlEuzIntegr::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                                   ObsDiagnostics &) const {
-  int nlocs = ovec.size();
-  int nlevs = gv.nlevs("mass_concentration_of_chlorophyll_in_sea_water");
-
-  // common vectors storage
-  std::vector <double> tmp(nlocs, 0.0);
-
-  // Retrieve the chlorophyll and cell thickness
-  std::vector<std::vector<double>> chl;
-  std::vector<std::vector<double>> h;
-  for ( std::size_t k = 0; k < nlevs; ++k ) {
-    gv.getAtLevel(tmp, "sea_water_cell_thickness", k);
-    h.push_back(tmp);
-    gv.getAtLevel(tmp, "mass_concentration_of_chlorophyll_in_sea_water", k);
-    chl.push_back(tmp);
-  }
+  const std::size_t nlocs = gv.nlocs();
+  ASSERT(ovec.size() == nlocs);
+  const std::size_t nlevs = gv.nlevs("mass_concentration_of_chlorophyll_in_sea_water");
+
+  // Retrieve the chlorophyll and cell thickness; level k starts at element k * nlocs
+  std::vector<double> chl;
+  std::vector<double> h;
+  gv.getAllLevels(h, "sea_water_cell_thickness");
+  gv.getAllLevels(chl, "mass_concentration_of_chlorophyll_in_sea_water");
 
   // Calculate mean chlorophyll averaged over euphotic layer (euz_mod)
-  for ( std::size_t i = 0; i < nlocs; ++i ) {
-    double euz = Constants::euzc_0 * pow(chl[0][i], Constants::euzc_1);
-    double euz_mod = 0.0;
-    int elev = 0;
+  std::vector<double> euz(nlocs);
+  std::vector<double> euz_mod(nlocs, 0.0);
+  std::vector<std::size_t> elev(nlocs, 0);
+  std::vector<double> chl_mean(nlocs, 0.0);
+  forEachLocationChunk(nlocs, [&](std::size_t begin, std::size_t end) {
+    for ( std::size_t i = begin; i < end; ++i )
+      euz[i] = Constants::euzc_0 * pow(chl[i], Constants::euzc_1);
     for ( std::size_t k = 0; k < nlevs; ++k ) {
-      if (euz_mod < euz) {
-        euz_mod += h[k][i];
-        elev++;
+      const double *hLevel = &h[k * nlocs];
+      for ( std::size_t i = begin; i < end; ++i ) {
+        if (euz_mod[i] < euz[i]) {
+          euz_mod[i] += hLevel[i];
+          elev[i]++;
+        }
       }
     }
-    ovec[i] = 0.0;
-    for ( std::size_t k = 0; k < elev; ++k ) {
-      ovec[i] += chl[k][i] * h[k][i] / euz_mod;
+    for ( std::size_t k = 0; k < nlevs; ++k ) {
+      const double *hLevel = &h[k * nlocs];
+      const double *chlLevel = &chl[k * nlocs];
+      for ( std::size_t i = begin; i < end; ++i ) {
+        if (k < elev[i])
+          chl_mean[i] += chlLevel[i] * hLevel[i] / euz_mod[i];
+      }
     }
-  }
+  });
+
+  for ( std::size_t i = 0; i < nlocs; ++i )
+    ovec[i] = chl_mean[i];
   oops::Log::trace() << "ObsChlEuzIntegr: observation operator run" << std::endl;
 }
 
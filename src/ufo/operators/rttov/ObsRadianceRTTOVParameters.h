@@ -73,6 +73,10 @@ class RTTOVObsOptionsParameters : public oops::Parameters {
   /// (nchan_max_sim)
   oops::Parameter<int> maxChanPerBatch{"max_channels_per_batch", 10000, this};
 
+  /// Store the Jacobians used by the linear model in single precision.  This halves the memory
+  /// held by the trajectory; TL/AD accumulation is still done in double precision.
+  oops::Parameter<bool> jacobianSinglePrecision{"jacobian_single_precision", false, this};
+
   /// If performing the qsplit calculation for qtotal within the interface this option
   /// allows for the inclusion of rain in the calculation.  Although the default is false
   /// it is turned to true in the interface if simulating a microwave instrument with
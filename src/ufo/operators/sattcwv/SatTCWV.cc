@@ -8,6 +8,7 @@
 
 #include "ufo/operators/sattcwv/SatTCWV.h"
 
+#include <algorithm>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -20,6 +21,7 @@
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/utils/Constants.h"
+#include "ufo/utils/LocationChunks.h"
 
 namespace ufo {
 
@@ -60,38 +62,44 @@ void SatTCWV::simulateObs(const GeoVaLs & geovals, ioda::ObsVector & hofx,
   std::vector<float> ps(nprofiles);  // surface pressure (Pa)
   geovals.get(ps, "surface_pressure");
 
-  // Get 3-D air pressure on rho levels (Pa), one level at a time
-  std::vector<std::vector<float>> plev(nlevels, std::vector<float>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels; ++lev) {
-    geovals.getAtLevel(plev[lev], "air_pressure_levels", lev);
-  }
-
-  // Get 3-D specific humidity on theta levels (kg/kg), one level at a time
-  std::vector<std::vector<float>> q(nlevels-1, std::vector<float>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.getAtLevel(q[lev], "specific_humidity", lev);
-  }
+  // Get 3-D air pressure on rho levels (Pa) and specific humidity on theta levels (kg/kg);
+  // level lev of each field starts at element lev * nprofiles
+  std::vector<float> plev;
+  geovals.getAllLevels(plev, "air_pressure_levels");
+  ASSERT(geovals.nlevs("specific_humidity") >= nlevels - 1);
+  std::vector<float> q;
+  geovals.getAllLevels(q, "specific_humidity");
 
   // Check model fields are top-down, fail if not
-  if (plev.front() > plev.back()) {
+  const float *plevTop = plev.data();
+  const float *plevBottom = plev.data() + (nlevels - 1) * nprofiles;
+  if (std::lexicographical_compare(plevBottom, plevBottom + nprofiles,
+                                   plevTop, plevTop + nprofiles)) {
     throw eckit::BadValue("model fields must be ordered from the top down", Here());
   }
 
   // Calculate TCWV for each profile, integrating over each layer
-
-  // Loop over profiles
-  for (size_t prof = 0; prof < nprofiles; ++prof) {
+  std::vector<double> tcwv(nprofiles);
+  forEachLocationChunk(nprofiles, [&](std::size_t begin, std::size_t end) {
     // Start with lowest model layer, using surface pressure
     // NB this assumes surface q is same as q 10m but could use q2m in future
-    hofx[prof] = (ps[prof] - plev[nlevels - 2][prof]) *
-                 q[nlevels - 2][prof] / Constants::grav;
+    const float *pBottom = &plev[(nlevels - 2) * nprofiles];
+    const float *qBottom = &q[(nlevels - 2) * nprofiles];
+    for (size_t prof = begin; prof < end; ++prof)
+      tcwv[prof] = (ps[prof] - pBottom[prof]) * qBottom[prof] / Constants::grav;
 
     // Loop over the rest of the model layers
     for (size_t lev = 0; lev < nlevels - 2; ++lev) {
-      hofx[prof] += (plev[lev+1][prof] - plev[lev][prof]) *
-                    q[lev][prof] / Constants::grav;
+      const float *pUpper = &plev[lev * nprofiles];
+      const float *pLower = &plev[(lev + 1) * nprofiles];
+      const float *qLayer = &q[lev * nprofiles];
+      for (size_t prof = begin; prof < end; ++prof)
+        tcwv[prof] += (pLower[prof] - pUpper[prof]) * qLayer[prof] / Constants::grav;
     }
-  }
+  });
+
+  for (size_t prof = 0; prof < nprofiles; ++prof)
+    hofx[prof] = tcwv[prof];
 }
 
 // -----------------------------------------------------------------------------
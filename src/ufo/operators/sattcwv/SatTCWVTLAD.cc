@@ -7,6 +7,7 @@
 
 #include "ufo/operators/sattcwv/SatTCWVTLAD.h"
 
+#include <algorithm>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/utils/Constants.h"
+#include "ufo/utils/LocationChunks.h"
 
 namespace ufo {
 
@@ -53,46 +55,44 @@ void SatTCWVTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics &) {
   nprofiles = geovals.nlocs();
   nlevels   = geovals.nlevs("air_pressure_levels");  // number of full (rho) levels
 
-  // (Re)initialise the Jacobian matrix
-  if (!k_matrix.empty()) k_matrix.clear();
-  k_matrix.resize(nlevels-1, std::vector<double>(nprofiles));
+  // (Re)initialise the Jacobian matrix; level lev starts at element lev * nprofiles
+  k_matrix.assign((nlevels - 1) * nprofiles, 0.0);
 
   // Get 2-D surface pressure
   std::vector<float> ps(nprofiles);  // surface pressure (Pa)
   geovals.get(ps, "surface_pressure");
 
-  // Get 3-D air pressure on rho levels (Pa), one level at a time
-  std::vector<std::vector<float>> plev(nlevels, std::vector<float>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels; ++lev) {
-    geovals.getAtLevel(plev[lev], "air_pressure_levels", lev);
-  }
-
-  // Get 3-D specific humidity on theta levels (kg/kg), one level at a time
-  std::vector<std::vector<float>> q(nlevels-1, std::vector<float>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.getAtLevel(q[lev], "specific_humidity", lev);
-  }
+  // Get 3-D air pressure on rho levels (Pa), laid out as k_matrix
+  std::vector<float> plev;
+  geovals.getAllLevels(plev, "air_pressure_levels");
 
   // Check model fields are top-down
-  if (plev.front() > plev.back()) {
+  const float *plevTop = plev.data();
+  const float *plevBottom = plev.data() + (nlevels - 1) * nprofiles;
+  if (std::lexicographical_compare(plevBottom, plevBottom + nprofiles,
+                                   plevTop, plevTop + nprofiles)) {
     // Bottom-up: fail as JEDI should be top-down
     throw eckit::BadValue("model fields must be ordered from the top down", Here());
   }
 
   // Calculate partial derivatives d(TCWV)/d(q) for each profile element
-
-  // Loop over profiles
-
-  for (size_t prof = 0; prof < nprofiles; ++prof) {
-    k_matrix[nlevels - 2][prof] = (ps[prof] - plev[nlevels - 2][prof]) /
-                                    Constants::grav;
+  forEachLocationChunk(nprofiles, [&](std::size_t begin, std::size_t end) {
+    // Lowest model layer, using surface pressure
+    double *kBottom = &k_matrix[(nlevels - 2) * nprofiles];
+    const float *pBottom = &plev[(nlevels - 2) * nprofiles];
+    for (size_t prof = begin; prof < end; ++prof)
+      kBottom[prof] = (ps[prof] - pBottom[prof]) / Constants::grav;
 
     // Loop over the rest of the model layers
     for (size_t lev = 0; lev < nlevels - 2; ++lev) {
-      k_matrix[lev][prof] = (plev[lev+1][prof] - plev[lev][prof]) /
-                            Constants::grav;
+      double *kLayer = &k_matrix[lev * nprofiles];
+      const float *pUpper = &plev[lev * nprofiles];
+      const float *pLower = &plev[(lev + 1) * nprofiles];
+      for (size_t prof = begin; prof < end; ++prof)
+        kLayer[prof] = (pLower[prof] - pUpper[prof]) / Constants::grav;
     }
-  }
+  });
+
   traj_init = true;
 }
 
@@ -111,18 +111,24 @@ void SatTCWVTLAD::simulateObsTL(
   ASSERT(geovals.nlocs() == hofx.nlocs());
   hofx.zero();
 
-  // Get 3-D specific humidity increments on theta levels (kg/kg), one level at a time
-  std::vector<std::vector<double>> q_d(nlevels-1, std::vector<double>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.getAtLevel(q_d[lev], "specific_humidity", lev);
-  }
+  // Get 3-D specific humidity increments on theta levels (kg/kg), laid out as k_matrix
+  ASSERT(geovals.nlevs("specific_humidity") >= nlevels - 1);
+  std::vector<double> q_d;
+  geovals.getAllLevels(q_d, "specific_humidity");
 
-  // Loop through the obs, calculating the increment to the observation hofx
-  for (size_t prof = 0; prof < nprofiles; ++prof) {
+  // Calculate the increment to the observation hofx
+  std::vector<double> tcwv_d(nprofiles, 0.0);
+  forEachLocationChunk(nprofiles, [&](std::size_t begin, std::size_t end) {
     for (size_t lev = 0; lev < nlevels-1; ++lev) {
-      hofx[prof] += k_matrix[lev][prof] * q_d[lev][prof];
+      const double *kLayer = &k_matrix[lev * nprofiles];
+      const double *qLayer = &q_d[lev * nprofiles];
+      for (size_t prof = begin; prof < end; ++prof)
+        tcwv_d[prof] += kLayer[prof] * qLayer[prof];
     }
-  }
+  });
+
+  for (size_t prof = 0; prof < nprofiles; ++prof)
+    hofx[prof] = tcwv_d[prof];
 }
 
 // -----------------------------------------------------------------------------
@@ -139,28 +145,31 @@ void SatTCWVTLAD::simulateObsAD(
   // Check hofx size
   ASSERT(geovals.nlocs() == hofx.nlocs());
 
-  // Get 3-D specific humidity increments on theta levels (kg/kg), one level at a time
-  std::vector<std::vector<double>> q_d(nlevels-1, std::vector<double>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.getAtLevel(q_d[lev], "specific_humidity", lev);
-  }
+  // Get 3-D specific humidity increments on theta levels (kg/kg), laid out as k_matrix
+  ASSERT(geovals.nlevs("specific_humidity") >= nlevels - 1);
+  std::vector<double> q_d;
+  geovals.getAllLevels(q_d, "specific_humidity");
 
   // Get the missing value indicator
   const double missing = util::missingValue(missing);
 
-  // Loop through the obs, adding the increment to the model state
-  for (size_t prof = 0; prof < nprofiles; ++prof) {
-    if (hofx[prof] != missing) {
-      for (size_t lev = 0; lev < nlevels-1; ++lev) {
-        q_d[lev][prof] += k_matrix[lev][prof] * hofx[prof];
-      }
+  // Zero the increment to the observation where it is missing
+  std::vector<double> tcwv_d(nprofiles);
+  for (size_t prof = 0; prof < nprofiles; ++prof)
+    tcwv_d[prof] = hofx[prof] != missing ? hofx[prof] : 0.0;
+
+  // Add the increment to the model state
+  forEachLocationChunk(nprofiles, [&](std::size_t begin, std::size_t end) {
+    for (size_t lev = 0; lev < nlevels-1; ++lev) {
+      const double *kLayer = &k_matrix[lev * nprofiles];
+      double *qLayer = &q_d[lev * nprofiles];
+      for (size_t prof = begin; prof < end; ++prof)
+        qLayer[prof] += kLayer[prof] * tcwv_d[prof];
     }
-  }
+  });
 
   // Store the updated model state increments
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.putAtLevel(q_d[lev], "specific_humidity", lev);
-  }
+  geovals.putAllLevels(q_d, "specific_humidity");
 }
 
 // -----------------------------------------------------------------------------
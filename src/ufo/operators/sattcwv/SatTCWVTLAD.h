@@ -86,7 +86,7 @@ class SatTCWVTLAD : public LinearObsOperatorBase,
   void print(std::ostream &) const override;
   std::unique_ptr<const oops::Variables> varin_;
 
-  std::vector<std::vector<double>> k_matrix;
+  std::vector<double> k_matrix;  // level lev of d(TCWV)/d(q) starts at lev * nprofiles
   bool traj_init;
   size_t nlevels;
   size_t nprofiles;
@@ -14,15 +14,12 @@
 #include "ioda/ObsVector.h"
 
 #include "oops/base/Variables.h"
-#include "oops/util/DateTime.h"
-#include "oops/util/Duration.h"
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.h"
 #include "ufo/Locations.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/ObsOperatorBase.h"
-#include "ufo/operators/timeoper/ObsTimeOperUtil.h"
 
 namespace ufo {
 
@@ -37,19 +34,8 @@ ObsTimeOper::ObsTimeOper(const ioda::ObsSpace & odb,
                       odb,
                       oops::validateAndDeserialize<ObsOperatorParametersWrapper>(
                         parameters.obsOperator.value()).operatorParameters)),
-    odb_(odb), timeWeights_(timeWeightCreate(odb, parameters))
+    odb_(odb), timeWeights_(odb, parameters.windowSub.value())
 {
-  oops::Log::trace() << "ObsTimeOper creating" << std::endl;
-
-  util::DateTime windowBegin(odb_.windowStart());
-  util::DateTime windowEnd(odb_.windowEnd());
-
-  const util::Duration windowSub = parameters.windowSub.value();
-  util::Duration window = windowEnd - windowBegin;
-
-  if (window == windowSub) {
-    ABORT("Time Interpolation of obs not implemented when assimilation window = subWindow");
-  }
   oops::Log::trace() << "ObsTimeOper created" << std::endl;
 }
 
@@ -65,11 +51,8 @@ ObsTimeOper::~ObsTimeOper() {
 std::unique_ptr<Locations> ObsTimeOper::locations() const {
   oops::Log::trace() << "entered ObsOperatorTime::locations" << std::endl;
 
-  std::unique_ptr<Locations> locs = actualoperator_->locations();
-  // concatenate locations with itself (double the size)
-  *locs += *locs;
-
-  return locs;
+  // two copies of each location, valid at the times of the states bracketing the observation
+  return timeWeights_.expandLocations(*actualoperator_->locations());
 }
 
 // -----------------------------------------------------------------------------
@@ -78,20 +61,9 @@ void ObsTimeOper::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                               ObsDiagnostics & ydiags) const {
   oops::Log::trace() << "ObsTimeOper: simulateObs entered" << std::endl;
 
-  oops::Log::trace() << gv <<  std::endl;
-
-  GeoVaLs gv1(odb_.distribution(), gv.getVars());
-  GeoVaLs gv2(odb_.distribution(), gv.getVars());
-
-  gv.split(gv1, gv2);
-
-  oops::Log::trace() << gv1 << std::endl;
-  oops::Log::trace() << gv2 << std::endl;
-
-  gv1 *= timeWeights_[0];
-  gv2 *= timeWeights_[1];
-  gv1 += gv2;
-  actualoperator_->simulateObs(gv1, ovec, ydiags);
+  GeoVaLs gvInterp(odb_.distribution(), gv.getVars());
+  timeWeights_.interpolate(gv, gvInterp);
+  actualoperator_->simulateObs(gvInterp, ovec, ydiags);
 
   oops::Log::trace() << "ObsTimeOper: simulateObs exit " <<  std::endl;
 }
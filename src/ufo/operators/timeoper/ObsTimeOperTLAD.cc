@@ -15,12 +15,9 @@
 #include "ioda/ObsVector.h"
 
 #include "oops/base/Variables.h"
-#include "oops/util/DateTime.h"
-#include "oops/util/Duration.h"
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.h"
-#include "ufo/operators/timeoper/ObsTimeOperUtil.h"
 
 namespace ufo {
 
@@ -35,7 +32,7 @@ ObsTimeOperTLAD::ObsTimeOperTLAD(const ioda::ObsSpace & odb,
                       odb,
                       oops::validateAndDeserialize<LinearObsOperatorParametersWrapper>(
                         parameters.obsOperator.value()).operatorParameters)),
-    timeWeights_(timeWeightCreate(odb, parameters))
+    timeWeights_(odb, parameters.windowSub.value())
 {
   oops::Log::trace() << "ObsTimeOperTLAD created" << std::endl;
 }
@@ -52,29 +49,9 @@ void ObsTimeOperTLAD::setTrajectory(const GeoVaLs & geovals,
                                     ObsDiagnostics & ydiags) {
   oops::Log::trace() << "ObsTimeOperTLAD::setTrajectory entering" << std::endl;
 
-  oops::Log::debug() << "ObsTimeOperTLAD::setTrajectory input geovals "
-                     << geovals << std::endl;
-
-  GeoVaLs gv1(obsspace().distribution(), geovals.getVars());
-  GeoVaLs gv2(obsspace().distribution(), geovals.getVars());
-  geovals.split(gv1, gv2);
-
-  oops::Log::debug() << "ObsTimeOperTLAD::setTrajectory split geovals gv1 "
-                     << gv1 << std::endl;
-
-  oops::Log::debug() << "ObsTimeOperTLAD::setTrajectory split geovals gv2 "
-                     << gv2 << std::endl;
-
-  gv1 *= timeWeights_[0];
-  gv2 *= timeWeights_[1];
-  gv1 += gv2;
-
-  oops::Log::debug() << "ObsTimeOperTLAD::setTrajectory final geovals gv1 "
-                     << gv1 << std::endl;
-
-  actualoperator_->setTrajectory(gv1, ydiags);
-
-  oops::Log::debug() << gv1;
+  GeoVaLs gvInterp(obsspace().distribution(), geovals.getVars());
+  timeWeights_.interpolate(geovals, gvInterp);
+  actualoperator_->setTrajectory(gvInterp, ydiags);
 
   oops::Log::trace() << "ObsTimeOperTLAD::setTrajectory exiting" << std::endl;
 }
@@ -84,27 +61,9 @@ void ObsTimeOperTLAD::setTrajectory(const GeoVaLs & geovals,
 void ObsTimeOperTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec) const {
   oops::Log::trace() << "ObsTimeOperTLAD::simulateObsTL entering" << std::endl;
 
-  oops::Log::debug() << "ObsTimeOperTLAD::setTrajectory input geovals "
-                     << geovals << std::endl;
-
-  GeoVaLs gv1(obsspace().distribution(), geovals.getVars());
-  GeoVaLs gv2(obsspace().distribution(), geovals.getVars());
-  geovals.split(gv1, gv2);
-
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsTL split geovals gv1 "
-                     << gv1 << std::endl;
-
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsTL split geovals gv2 "
-                     << gv2 << std::endl;
-
-  gv1 *= timeWeights_[0];
-  gv2 *= timeWeights_[1];
-  gv1 += gv2;
-
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsTL final geovals gv1 "
-                     << gv1 << std::endl;
-
-  actualoperator_->simulateObsTL(gv1, ovec);
+  GeoVaLs gvInterp(obsspace().distribution(), geovals.getVars());
+  timeWeights_.interpolate(geovals, gvInterp);
+  actualoperator_->simulateObsTL(gvInterp, ovec);
 
   oops::Log::trace() << "ObsTimeOperTLAD::simulateObsTL exiting" << std::endl;
 }
@@ -114,29 +73,13 @@ void ObsTimeOperTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & o
 void ObsTimeOperTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector & ovec) const {
   oops::Log::trace() << "ObsTimeOperTLAD::simulateObsAD entering" << std::endl;
 
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsAD input geovals "
-                     << geovals << std::endl;
-
-  GeoVaLs gv1(obsspace().distribution(), geovals.getVars());
-  GeoVaLs gv2(obsspace().distribution(), geovals.getVars());
-  geovals.split(gv1, gv2);
-
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsAD split geovals gv1 "
-                     << gv1 << std::endl;
-
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsAD split geovals gv2 "
-                     << gv2 << std::endl;
-
-  actualoperator_->simulateObsAD(gv1, ovec);
-
-  gv2 = gv1;
-  gv1 *= timeWeights_[0];
-  gv2 *= timeWeights_[1];
-
-  geovals.merge(gv1, gv2);
-
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsAD final geovals "
-                     << geovals << std::endl;
+  // The interpolated GeoVaLs are given the shape expected by the operator, i.e. that of the
+  // GeoVaLs at the first copy of each location, before the operator adjoint is applied.
+  GeoVaLs gvInterp(obsspace().distribution(), geovals.getVars());
+  timeWeights_.interpolate(geovals, gvInterp);
+  gvInterp.zero();
+  actualoperator_->simulateObsAD(gvInterp, ovec);
+  timeWeights_.interpolateAD(geovals, gvInterp);
 
   oops::Log::trace() << "ObsTimeOperTLAD::simulateObsAD exiting" << std::endl;
 }
@@ -5,81 +5,114 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0. 
  */
 
+#include "ufo/operators/timeoper/ObsTimeOperUtil.h"
 
 #include <algorithm>
-#include <ostream>
 #include <string>
 #include <vector>
 
-#include "ioda/ObsVector.h"
+#include "eckit/exception/Exceptions.h"
+
+#include "ioda/ObsSpace.h"
 
-#include "oops/util/DateTime.h"
-#include "oops/util/Duration.h"
 #include "oops/util/Logger.h"
-#include "ufo/operators/timeoper/ObsTimeOperParameters.h"
-#include "ufo/operators/timeoper/ObsTimeOperUtil.h"
 
-namespace ufo {
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
 
+namespace ufo {
 
 //--------------------------------------------------------------------------------------------------
-std::vector<std::vector<float>> timeWeightCreate(const ioda::ObsSpace & odb_,
-                                    const ObsTimeOperParameters & parameters) {
-  util::DateTime windowBegin(odb_.windowStart());
-  const util::Duration windowSub = parameters.windowSub.value();
-  int64_t windowSubSec = windowSub.toSeconds();
-
-  std::size_t nlocs = odb_.nlocs();
-
-  oops::Log::debug() << "nlocs =    " << nlocs << std::endl;
-
-  std::vector<float> TimeWeightObsAfterState(nlocs, 0.0);
-
+ObsTimeOperWeights::ObsTimeOperWeights(const ioda::ObsSpace & odb,
+                                       const util::Duration & windowSub)
+  : windowBegin_(odb.windowStart()), windowSub_(windowSub)
+{
+  const int64_t windowSubSec = windowSub.toSeconds();
+  const int64_t windowSec = (odb.windowEnd() - windowBegin_).toSeconds();
+  if (windowSubSec <= 0 || windowSec % windowSubSec != 0)
+    throw eckit::UserError("TimeOperLinInterp: the assimilation window length must be a "
+                           "multiple of windowSub", Here());
+  nstates_ = windowSec / windowSubSec + 1;
+
+  const size_t nlocs = odb.nlocs();
   std::vector<util::DateTime> dateTimeIn(nlocs);
-  odb_.get_db("MetaData", "dateTime", dateTimeIn);
-
-  oops::Log::debug() << "dateTime =  " << dateTimeIn[0].toString() << std::endl;
-
-  for (std::size_t i = 0; i < nlocs; ++i) {
-    util::Duration timeFromStart = dateTimeIn[i] - windowBegin;
-    int64_t timeFromStartSec = timeFromStart.toSeconds();
-    int64_t StateTimeFromStartSec =
-      (timeFromStartSec / windowSubSec) * windowSubSec;
-    if ((timeFromStartSec - StateTimeFromStartSec) == 0) {
-      TimeWeightObsAfterState[i] = 1.0f;
+  odb.get_db("MetaData", "dateTime", dateTimeIn);
+
+  stateBefore_.reserve(nlocs);
+  offsets_.reserve(nlocs + 1);
+  sources_.reserve(2 * nlocs);
+  weights_.reserve(2 * nlocs);
+  offsets_.push_back(0);
+  for (size_t i = 0; i < nlocs; ++i) {
+    const int64_t timeFromStartSec = (dateTimeIn[i] - windowBegin_).toSeconds();
+    const int64_t stateBefore = timeFromStartSec / windowSubSec;
+    const int64_t timeFromStateSec = timeFromStartSec - stateBefore * windowSubSec;
+    stateBefore_.push_back(stateBefore);
+    if (timeFromStateSec == 0) {
+      sources_.push_back(i);
+      weights_.push_back(1.0);
     } else {
-      TimeWeightObsAfterState[i] = 1.0f - static_cast<float>(timeFromStartSec -
-                                                       StateTimeFromStartSec)/
-                                         static_cast<float>(windowSubSec);
+      const double weightAfter = static_cast<double>(timeFromStateSec) / windowSubSec;
+      sources_.push_back(i);
+      weights_.push_back(1.0 - weightAfter);
+      sources_.push_back(nlocs + i);
+      weights_.push_back(weightAfter);
     }
-    oops::Log::debug() << " timeFromStartSec = " << timeFromStartSec
-                       << " windowSubSec = " << windowSubSec
-                       << " StateTimeFromStartSec = " << StateTimeFromStartSec
-                       << std::endl;
+    offsets_.push_back(weights_.size());
   }
-  for (std::size_t i=0; i < TimeWeightObsAfterState.size(); ++i) {
-    oops::Log::debug() << "timeweights [" << i << "] = "
-                       << TimeWeightObsAfterState[i] << std::endl;
+  if (weights_.size() == nlocs) {
+    std::vector<size_t> firstCopies(nlocs);
+    for (size_t i = 0; i < nlocs; ++i)
+      firstCopies[i] = i;
+    sameTimeMap_ = GeoVaLsIndexMap(firstCopies);
   }
+  oops::Log::debug() << "ObsTimeOperWeights: " << nlocs << " locations, " << weights_.size()
+                     << " non-zero weights, " << nstates_ << " states" << std::endl;
+}
 
-  std::vector<float> TimeWeightObsBeforeState(nlocs, 0.0);
-  transform(TimeWeightObsAfterState.cbegin(), TimeWeightObsAfterState.cend(),
-            TimeWeightObsBeforeState.begin(),
-            [] (float element) {return 1.0f - element;});
+// -----------------------------------------------------------------------------
 
-  std::vector<std::vector<float>> timeWeights;
-  timeWeights.push_back(TimeWeightObsAfterState);
-  timeWeights.push_back(TimeWeightObsBeforeState);
+util::DateTime ObsTimeOperWeights::stateTime(int istate) const {
+  return windowBegin_ + util::Duration(istate * windowSub_.toSeconds());
+}
 
-  for (auto i : timeWeights[0]) {
-    oops::Log::debug() << "TimeOperUtil::timeWeights[0] = " << i << std::endl;
-  }
-  for (auto i : timeWeights[1]) {
-    oops::Log::debug() << "TimeOperUtil::timeWeights[1] = " << i << std::endl;
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<Locations> ObsTimeOperWeights::expandLocations(const Locations & locs) const {
+  if (locs.size() != nlocs())
+    throw eckit::BadValue("TimeOperLinInterp: the obs operator must use one location per "
+                          "observation", Here());
+  const std::vector<float> lons = locs.lons();
+  const std::vector<float> lats = locs.lats();
+  std::vector<float> expandedLons(lons);
+  expandedLons.insert(expandedLons.end(), lons.begin(), lons.end());
+  std::vector<float> expandedLats(lats);
+  expandedLats.insert(expandedLats.end(), lats.begin(), lats.end());
+  std::vector<util::DateTime> expandedTimes(2 * nlocs());
+  const int lastState = nstates_ - 1;
+  for (size_t iloc = 0; iloc < nlocs(); ++iloc) {
+    expandedTimes[iloc] = stateTime(stateBefore_[iloc]);
+    expandedTimes[nlocs() + iloc] = stateTime(std::min(stateBefore_[iloc] + 1, lastState));
   }
+  return std::unique_ptr<Locations>(new Locations(expandedLons, expandedLats, expandedTimes,
+                                                  locs.distribution()));
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsTimeOperWeights::interpolate(const GeoVaLs & expanded, GeoVaLs & interpolated) const {
+  if (sameTimeMap_)
+    interpolated.gather(expanded, *sameTimeMap_);
+  else
+    interpolated.interpolateFrom(expanded, offsets_, sources_, weights_);
+}
 
-  return timeWeights;
+// -----------------------------------------------------------------------------
+
+void ObsTimeOperWeights::interpolateAD(GeoVaLs & expanded, const GeoVaLs & interpolated) const {
+  interpolated.interpolateFromAD(expanded, 2 * nlocs(), offsets_, sources_, weights_);
 }
+
 // -----------------------------------------------------------------------------
 
 }  // namespace ufo
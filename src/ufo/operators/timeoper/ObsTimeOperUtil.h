@@ -9,22 +9,82 @@
 #ifndef UFO_OPERATORS_TIMEOPER_OBSTIMEOPERUTIL_H_
 #define UFO_OPERATORS_TIMEOPER_OBSTIMEOPERUTIL_H_
 
-#include <algorithm>
-#include <ostream>
+#include <memory>
 #include <vector>
 
-#include "ioda/ObsVector.h"
+#include <boost/optional.hpp>
 
 #include "oops/util/DateTime.h"
 #include "oops/util/Duration.h"
-#include "oops/util/Logger.h"
+
+#include "ufo/GeoVaLsIndexMap.h"
+
+namespace ioda {
+  class ObsSpace;
+}
 
 namespace ufo {
 
-class ObsTimeOperParameters;
+class GeoVaLs;
+class Locations;
+
+// -----------------------------------------------------------------------------
+
+/// \brief Weights used to interpolate model values linearly in time from the model states
+/// bracketing each observation.
+///
+/// Model states are valid at `window begin + k * windowSub` for k = 0, 1, ..., nstates() - 1,
+/// and there may be any number of them. GeoVaLs are requested at two copies of each observation
+/// location (see expandLocations()): the first nlocs() locations are valid at the time of the
+/// state preceding (or coinciding with) each observation and the next nlocs() at the time of the
+/// following state. The number of GeoVaLs therefore does not depend on the number of states.
+///
+/// The weights are computed once, when the operator is constructed. Only non-zero weights are
+/// stored: those of location `iloc` are the elements `offsets()[iloc]` up to (but excluding)
+/// `offsets()[iloc + 1]` of weights(), and sources() holds the indices of the GeoVaLs locations
+/// they apply to. Observations taken exactly at the validity time of a state have a single
+/// weight; if that is true of all observations, interpolate() copies the first nlocs()
+/// locations in a single block instead of forming weighted sums.
+class ObsTimeOperWeights {
+ public:
+  ObsTimeOperWeights(const ioda::ObsSpace & odb, const util::Duration & windowSub);
+
+  /// Number of observation locations.
+  size_t nlocs() const {return stateBefore_.size();}
+  /// Number of model states.
+  size_t nstates() const {return nstates_;}
+
+  const std::vector<int> & offsets() const {return offsets_;}
+  const std::vector<int> & sources() const {return sources_;}
+  const std::vector<double> & weights() const {return weights_;}
+
+  /// Validity time of the state with index \p istate.
+  util::DateTime stateTime(int istate) const;
+
+  /// \brief Return the locations at which GeoVaLs need to be requested.
+  ///
+  /// The locations \p locs are copied twice. Each copy of a location is given the validity time
+  /// of one of the states bracketing the observation, so that it is interpolated from that state.
+  std::unique_ptr<Locations> expandLocations(const Locations & locs) const;
+
+  /// Interpolate the GeoVaLs \p expanded at the locations returned by expandLocations() in time
+  /// and store the result in \p interpolated.
+  void interpolate(const GeoVaLs & expanded, GeoVaLs & interpolated) const;
+  /// Adjoint of interpolate().
+  void interpolateAD(GeoVaLs & expanded, const GeoVaLs & interpolated) const;
 
-std::vector<std::vector<float>> timeWeightCreate(const ioda::ObsSpace & odb_,
-                                                 const ObsTimeOperParameters & parameters);
+ private:
+  util::DateTime windowBegin_;
+  util::Duration windowSub_;
+  size_t nstates_;
+  /// Index of the state preceding or coinciding with each observation.
+  std::vector<int> stateBefore_;
+  std::vector<int> offsets_;
+  std::vector<int> sources_;
+  std::vector<double> weights_;
+  /// Set if all observations coincide with a state: maps each location onto its first copy.
+  boost::optional<GeoVaLsIndexMap> sameTimeMap_;
+};
 
 // -----------------------------------------------------------------------------
 
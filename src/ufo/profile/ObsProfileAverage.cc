@@ -18,6 +18,7 @@
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.h"
+#include "ufo/GeoVaLsSubsetView.h"
 #include "ufo/Locations.h"
 #include "ufo/ObsDiagnostics.h"
 
@@ -71,6 +72,8 @@ void ObsProfileAverage::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
     // Retrieve slant path locations.
     const std::vector<std::size_t>& slant_path_location =
       data_.getSlantPathLocations(locsOriginal, locsExtended);
+    // Level mlev of the H(x) profile is taken from location mlev of this view.
+    const GeoVaLsSubsetView slantPathGeoVaLs(gv, slant_path_location);
 
     // Fill H(x) vector for each variable.
     for (int jvar : data_.operatorVarIndices()) {
@@ -80,12 +83,10 @@ void ObsProfileAverage::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
       // GeoVaL vector for this variable.
       std::vector<double> var_gv(nlevs_var);
       // For each level:
-      // - get the relevant slant path location,
-      // - retrieve the GeoVaL at that location,
+      // - retrieve the GeoVaL at the relevant slant path location,
       // - fill H(x) with the relevant level in the GeoVaL.
       for (std::size_t mlev = 0; mlev < nlevs_var; ++mlev) {
-        const std::size_t jloc = slant_path_location[mlev];
-        gv.getAtLocation(var_gv, variable, jloc);
+        slantPathGeoVaLs.getAtLocation(var_gv, variable, mlev);
         if (data_.geovalsObsSameDir()) {  // geovals and observations are the same way round:
           ovec[locsExtended[mlev] * ovec.nvars() + jvar] = var_gv[mlev];
         } else {  // reverse geovals so they're the same way round in extended space as
@@ -8,6 +8,7 @@
 #include "oops/util/FloatCompare.h"
 #include "oops/util/missingValues.h"
 
+#include "ufo/GeoVaLsSubsetView.h"
 #include "ufo/profile/ObsProfileAverageData.h"
 #include "ufo/profile/SlantPathLocations.h"
 #include "ufo/utils/OperatorUtils.h"  // for getOperatorVariables
@@ -102,8 +103,9 @@ namespace ufo {
       const std::size_t nlevs_p = cachedGeoVaLs_->nlevs(modelVerticalCoord_);
       // Vector used to store different pressure GeoVaLs.
       std::vector <float> pressure_gv(nlevs_p);
+      const GeoVaLsSubsetView slantPathGeoVaLs(*cachedGeoVaLs_, slant_path_location);
       for (std::size_t mlev = 0; mlev < nlevs_p; ++mlev) {
-        cachedGeoVaLs_->getAtLocation(pressure_gv, modelVerticalCoord_, slant_path_location[mlev]);
+        slantPathGeoVaLs.getAtLocation(pressure_gv, modelVerticalCoord_, mlev);
         slant_pressure.push_back(pressure_gv[nlevs_p - 1 - mlev]);
       }
       this->compareAuxiliaryReferenceVariables(locsExtended,
@@ -18,6 +18,7 @@
 #include "oops/util/missingValues.h"
 
 #include "ufo/GeoVaLs.h"
+#include "ufo/GeoVaLsSubsetView.h"
 #include "ufo/ObsDiagnostics.h"
 
 namespace ufo {
@@ -66,14 +67,14 @@ void ObsProfileAverageTLAD::simulateObsTL(const GeoVaLs & dx, ioda::ObsVector &
     // Retrieve slant path locations.
     const std::vector<std::size_t>& slant_path_location =
       data_.getSlantPathLocations(locsOriginal, locsExtended);
+    const GeoVaLsSubsetView slantPathDx(dx, slant_path_location);
 
     for (int jvar : data_.operatorVarIndices()) {
       const auto& variable = dy.varnames().variables()[jvar];
       const std::size_t nlevs_var = dx.nlevs(variable);
       std::vector<double> var_gv(nlevs_var);
       for (std::size_t mlev = 0; mlev < nlevs_var; ++mlev) {
-        const std::size_t jloc = slant_path_location[mlev];
-        dx.getAtLocation(var_gv, variable, jloc);
+        slantPathDx.getAtLocation(var_gv, variable, mlev);
         if (data_.geovalsObsSameDir()) {  // geovals and observations are the same way round:
           dy[locsExtended[mlev] * dy.nvars() + jvar] = var_gv[mlev];
         } else {  // reverse geovals so they're the same way round in extended space as
@@ -0,0 +1,71 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_CHANNELLEVELLOCATIONARRAY_H_
+#define UFO_UTILS_CHANNELLEVELLOCATIONARRAY_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "gsl/gsl-lite.hpp"
+
+namespace ufo {
+
+/// \brief Values of a multi-channel, multi-level variable at all locations, stored in a single
+/// contiguous block.
+///
+/// The values at all locations for a given channel and level are contiguous, so level() returns
+/// a span that can be passed to array-at-a-time code. Objects of this class are normally filled
+/// by ObsFilterData::get() and then only read.
+template <typename T>
+class ChannelLevelLocationArray {
+ public:
+  ChannelLevelLocationArray() = default;
+  ChannelLevelLocationArray(size_t nchans, size_t nlevs, size_t nlocs) {
+    resize(nchans, nlevs, nlocs);
+  }
+
+  void resize(size_t nchans, size_t nlevs, size_t nlocs) {
+    nchans_ = nchans;
+    nlevs_ = nlevs;
+    nlocs_ = nlocs;
+    values_.resize(nchans * nlevs * nlocs);
+  }
+
+  size_t nchans() const { return nchans_; }
+  size_t nlevs() const { return nlevs_; }
+  size_t nlocs() const { return nlocs_; }
+
+  const T &operator()(size_t ichan, size_t ilev, size_t iloc) const {
+    return values_[(ichan * nlevs_ + ilev) * nlocs_ + iloc];
+  }
+
+  /// Values at all locations for channel \p ichan and level \p ilev.
+  gsl::span<const T> level(size_t ichan, size_t ilev) const {
+    return gsl::span<const T>(values_.data() + (ichan * nlevs_ + ilev) * nlocs_, nlocs_);
+  }
+  /// \overload
+  gsl::span<T> level(size_t ichan, size_t ilev) {
+    return gsl::span<T>(values_.data() + (ichan * nlevs_ + ilev) * nlocs_, nlocs_);
+  }
+
+  /// Values at all levels and locations for channel \p ichan; the values at each level are
+  /// contiguous.
+  gsl::span<T> channel(size_t ichan) {
+    return gsl::span<T>(values_.data() + ichan * nlevs_ * nlocs_, nlevs_ * nlocs_);
+  }
+
+ private:
+  size_t nchans_ = 0;
+  size_t nlevs_ = 0;
+  size_t nlocs_ = 0;
+  std::vector<T> values_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_CHANNELLEVELLOCATIONARRAY_H_
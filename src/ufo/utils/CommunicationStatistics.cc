@@ -0,0 +1,58 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/CommunicationStatistics.h"
+
+#include <mutex>
+
+namespace ufo {
+
+namespace {
+
+std::mutex &statisticsMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<std::string, size_t> &statistics() {
+  static std::map<std::string, size_t> bytesPerSite;
+  return bytesPerSite;
+}
+
+}  // namespace
+
+void CommunicationStatistics::add(const std::string &site, size_t bytes) {
+  std::lock_guard<std::mutex> lock(statisticsMutex());
+  statistics()[site] += bytes;
+}
+
+std::map<std::string, size_t> CommunicationStatistics::bytesPerSite() {
+  std::lock_guard<std::mutex> lock(statisticsMutex());
+  return statistics();
+}
+
+size_t CommunicationStatistics::totalBytes() {
+  std::lock_guard<std::mutex> lock(statisticsMutex());
+  size_t total = 0;
+  for (const auto &siteAndBytes : statistics())
+    total += siteAndBytes.second;
+  return total;
+}
+
+void CommunicationStatistics::reset() {
+  std::lock_guard<std::mutex> lock(statisticsMutex());
+  statistics().clear();
+}
+
+size_t CommunicationStatistics::sizeInBytes(const std::vector<std::string> &values) {
+  size_t bytes = 0;
+  for (const std::string &value : values)
+    bytes += value.size();
+  return bytes;
+}
+
+}  // namespace ufo
@@ -0,0 +1,67 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_COMMUNICATIONSTATISTICS_H_
+#define UFO_UTILS_COMMUNICATIONSTATISTICS_H_
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ufo {
+
+/// \brief Tally of the volume of data received by this MPI task in collective operations issued
+/// by UFO components.
+///
+/// Components gathering or exchanging observation data across tasks (e.g. ObsAccessor,
+/// MetOfficeBuddyCheck and PrintFilterData) call recordReceived() after each collective
+/// operation, passing their name and the received data. Tools such as ufo_scaling.x read the
+/// tally with bytesPerSite() to find components whose communication volume grows with the total
+/// number of observations. The tally is shared by all threads of the process.
+class CommunicationStatistics {
+ public:
+  /// Add \p bytes to the volume of data received by the component \p site.
+  static void add(const std::string &site, size_t bytes);
+
+  /// Record the reception of \p received by the component \p site.
+  template <typename T>
+  static void recordReceived(const std::string &site, const std::vector<T> &received) {
+    add(site, sizeInBytes(received));
+  }
+
+  /// Record the reception of \p received (with one element per sending task) by the
+  /// component \p site.
+  template <typename T>
+  static void recordReceived(const std::string &site,
+                             const std::vector<std::vector<T>> &received) {
+    size_t bytes = 0;
+    for (const std::vector<T> &fromTask : received)
+      bytes += sizeInBytes(fromTask);
+    add(site, bytes);
+  }
+
+  /// Volume of data (in bytes) received by each component since the last call to reset().
+  static std::map<std::string, size_t> bytesPerSite();
+
+  /// Total volume of data (in bytes) received since the last call to reset().
+  static size_t totalBytes();
+
+  static void reset();
+
+ private:
+  template <typename T>
+  static size_t sizeInBytes(const std::vector<T> &values) {
+    return values.size() * sizeof(T);
+  }
+
+  static size_t sizeInBytes(const std::vector<std::string> &values);
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_COMMUNICATIONSTATISTICS_H_
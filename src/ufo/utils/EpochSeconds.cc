@@ -0,0 +1,183 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/EpochSeconds.h"
+
+#include "oops/util/DateTime.h"
+#include "oops/util/Duration.h"
+#include "oops/util/missingValues.h"
+
+namespace ufo {
+
+namespace {
+
+const std::int64_t secondsPerDay = 86400;
+const std::int64_t daysPerEra = 146097;  // Days in 400 years of the Gregorian calendar
+const std::int64_t daysFromEraStartToEpoch = 719468;  // From 0000-03-01 to 1970-01-01
+
+/// Weights of the fields (year to second) in the keys of partial date/time bounds.
+const std::array<std::int64_t, 6> fieldWeights = {10000000000, 100000000, 1000000, 10000, 100, 1};
+
+const util::DateTime &epoch() {
+  static const util::DateTime epoch(1970, 1, 1, 0, 0, 0);
+  return epoch;
+}
+
+std::int64_t floorDiv(std::int64_t a, std::int64_t b) {
+  return a / b - (a % b < 0 ? 1 : 0);
+}
+
+// The two functions below implement the algorithms described by H. Hinnant in
+// "chrono-Compatible Low-Level Date Algorithms", treating years as cycles of 400 years (eras)
+// starting on 1 March.
+
+std::int64_t daysFromCivil(std::int64_t year, int month, int day) {
+  year -= month <= 2;
+  const std::int64_t era = floorDiv(year, 400);
+  const std::int64_t yearOfEra = year - era * 400;
+  const std::int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const std::int64_t dayOfEra =
+      yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * daysPerEra + dayOfEra - daysFromEraStartToEpoch;
+}
+
+void civilFromDays(std::int64_t days, CalendarFields &fields) {
+  days += daysFromEraStartToEpoch;
+  const std::int64_t era = floorDiv(days, daysPerEra);
+  const std::int64_t dayOfEra = days - era * daysPerEra;
+  const std::int64_t yearOfEra =
+      (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  const std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  const std::int64_t monthFromMarch = (5 * dayOfYear + 2) / 153;
+  fields.day = dayOfYear - (153 * monthFromMarch + 2) / 5 + 1;
+  fields.month = monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9;
+  fields.year = yearOfEra + era * 400 + (fields.month <= 2);
+}
+
+/// Parse the field of \p str occupying \p length characters starting at \p offset. Set \p value
+/// to -1 if the field is made of asterisks. Return false if it is neither made of asterisks
+/// nor of digits.
+bool parseField(const std::string &str, size_t offset, size_t length, int &value) {
+  if (str.compare(offset, length, std::string(length, '*')) == 0) {
+    value = -1;
+    return true;
+  }
+  value = 0;
+  for (size_t i = offset; i < offset + length; ++i) {
+    if (str[i] < '0' || str[i] > '9')
+      return false;
+    value = 10 * value + (str[i] - '0');
+  }
+  return true;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+EpochSeconds missingEpochSeconds() {
+  static const EpochSeconds missing = toEpochSeconds(util::missingValue(util::DateTime()));
+  return missing;
+}
+
+EpochSeconds toEpochSeconds(const util::DateTime &dateTime) {
+  return (dateTime - epoch()).toSeconds();
+}
+
+std::vector<EpochSeconds> toEpochSeconds(const std::vector<util::DateTime> &dateTimes) {
+  std::vector<EpochSeconds> seconds(dateTimes.size());
+  for (size_t i = 0; i < dateTimes.size(); ++i)
+    seconds[i] = toEpochSeconds(dateTimes[i]);
+  return seconds;
+}
+
+util::DateTime fromEpochSeconds(EpochSeconds seconds) {
+  return epoch() + util::Duration(seconds);
+}
+
+std::vector<util::DateTime> fromEpochSeconds(const std::vector<EpochSeconds> &seconds) {
+  std::vector<util::DateTime> dateTimes;
+  dateTimes.reserve(seconds.size());
+  for (EpochSeconds s : seconds)
+    dateTimes.push_back(fromEpochSeconds(s));
+  return dateTimes;
+}
+
+// -----------------------------------------------------------------------------
+
+CalendarFields toCalendarFields(EpochSeconds seconds) {
+  CalendarFields fields;
+  const std::int64_t days = floorDiv(seconds, secondsPerDay);
+  const std::int64_t secondOfDay = seconds - days * secondsPerDay;
+  civilFromDays(days, fields);
+  fields.hour = secondOfDay / 3600;
+  fields.minute = secondOfDay / 60 % 60;
+  fields.second = secondOfDay % 60;
+  return fields;
+}
+
+EpochSeconds fromCalendarFields(const CalendarFields &fields) {
+  return daysFromCivil(fields.year, fields.month, fields.day) * secondsPerDay +
+         fields.hour * 3600 + fields.minute * 60 + fields.second;
+}
+
+// -----------------------------------------------------------------------------
+
+boost::optional<PartialDateTimeBound> PartialDateTimeBound::parse(const std::string &str) {
+  if (str.size() != 20 || str[4] != '-' || str[7] != '-' || str[10] != 'T' ||
+      str[13] != ':' || str[16] != ':' || str[19] != 'Z')
+    return boost::none;
+  std::array<int, 6> values;
+  if (!parseField(str, 0, 4, values[0]) || !parseField(str, 5, 2, values[1]) ||
+      !parseField(str, 8, 2, values[2]) || !parseField(str, 11, 2, values[3]) ||
+      !parseField(str, 14, 2, values[4]) || !parseField(str, 17, 2, values[5]))
+    return boost::none;
+
+  PartialDateTimeBound bound;
+  bool allSpecified = true, dateSpecified = false;
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i] < 0) {
+      allSpecified = false;
+    } else {
+      bound.weights_[i] = fieldWeights[i];
+      bound.key_ += fieldWeights[i] * values[i];
+      dateSpecified = dateSpecified || i < 3;
+    }
+  }
+
+  if (allSpecified) {
+    // Chronological order coincides with the lexicographic order of fields only for valid dates
+    const CalendarFields fields{values[0], values[1], values[2], values[3], values[4], values[5]};
+    const EpochSeconds seconds = fromCalendarFields(fields);
+    const CalendarFields check = toCalendarFields(seconds);
+    if (check.year == fields.year && check.month == fields.month && check.day == fields.day &&
+        check.hour == fields.hour && check.minute == fields.minute &&
+        check.second == fields.second) {
+      bound.kind_ = Kind::FULL;
+      bound.key_ = seconds;
+    }
+  } else if (!dateSpecified) {
+    bound.kind_ = Kind::TIME_OF_DAY;
+  }
+  return bound;
+}
+
+std::int64_t PartialDateTimeBound::timeOfDayKey(EpochSeconds seconds) const {
+  const std::int64_t secondOfDay = seconds - floorDiv(seconds, secondsPerDay) * secondsPerDay;
+  return weights_[3] * (secondOfDay / 3600) + weights_[4] * (secondOfDay / 60 % 60) +
+         weights_[5] * (secondOfDay % 60);
+}
+
+std::int64_t PartialDateTimeBound::generalKey(EpochSeconds seconds) const {
+  const CalendarFields fields = toCalendarFields(seconds);
+  return weights_[0] * fields.year + weights_[1] * fields.month + weights_[2] * fields.day +
+         weights_[3] * fields.hour + weights_[4] * fields.minute + weights_[5] * fields.second;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
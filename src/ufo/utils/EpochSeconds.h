@@ -0,0 +1,117 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_EPOCHSECONDS_H_
+#define UFO_UTILS_EPOCHSECONDS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+namespace util {
+class DateTime;
+}
+
+namespace ufo {
+
+/// \brief Number of seconds elapsed since 1970-01-01T00:00:00Z.
+///
+/// Columns of date/times stored in this form can be sorted, compared and differenced with
+/// integer arithmetic instead of util::DateTime operations.
+typedef std::int64_t EpochSeconds;
+
+/// Return the epoch seconds of the missing date/time, util::missingValue(util::DateTime()).
+///
+/// Conversions to and from epoch seconds need no special treatment of missing values, and
+/// missing date/times sort in the same position as the util::DateTime objects they replace.
+EpochSeconds missingEpochSeconds();
+
+/// Convert a date/time to epoch seconds.
+EpochSeconds toEpochSeconds(const util::DateTime &dateTime);
+/// \overload
+std::vector<EpochSeconds> toEpochSeconds(const std::vector<util::DateTime> &dateTimes);
+
+/// Convert epoch seconds to a date/time.
+util::DateTime fromEpochSeconds(EpochSeconds seconds);
+/// \overload
+std::vector<util::DateTime> fromEpochSeconds(const std::vector<EpochSeconds> &seconds);
+
+/// \brief Fields of a date/time in the proleptic Gregorian calendar.
+struct CalendarFields {
+  int year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  int second;
+};
+
+/// Split epoch seconds into calendar fields using integer arithmetic only.
+CalendarFields toCalendarFields(EpochSeconds seconds);
+
+/// Return the number of epoch seconds corresponding to the given calendar fields.
+EpochSeconds fromCalendarFields(const CalendarFields &fields);
+
+/// \brief A bound on date/times some of whose fields may be left unspecified (the counterpart
+/// of util::PartialDateTime), compiled into integer arithmetic on epoch seconds.
+///
+/// As for util::PartialDateTime, a date/time is compared with the bound by comparing
+/// lexicographically only the fields (year, month, day, hour, minute, second) specified in the
+/// bound. Each date/time is mapped onto an integer key in which unspecified fields have zero
+/// weight. Fully specified bounds are compared with epoch seconds directly, and bounds on the
+/// time of day alone do not need the calendar date to be computed.
+class PartialDateTimeBound {
+ public:
+  /// \brief Compile a bound written as `YYYY-MM-DDThh:mm:ssZ`, where each field may be replaced
+  /// by asterisks to leave it unspecified.
+  ///
+  /// Returns boost::none if \p str does not have this format.
+  static boost::optional<PartialDateTimeBound> parse(const std::string &str);
+
+  /// Return a negative number, zero or a positive number if the fields of \p seconds specified
+  /// in the bound compare respectively less than, equal to or greater than those of the bound.
+  int compare(EpochSeconds seconds) const {
+    EpochSeconds key;
+    switch (kind_) {
+    case Kind::FULL:
+      key = seconds;
+      break;
+    case Kind::TIME_OF_DAY:
+      key = timeOfDayKey(seconds);
+      break;
+    default:
+      key = generalKey(seconds);
+      break;
+    }
+    return key < key_ ? -1 : (key > key_ ? 1 : 0);
+  }
+
+ private:
+  enum class Kind {
+    FULL,         ///< All fields specified: keys are epoch seconds.
+    TIME_OF_DAY,  ///< No date fields specified.
+    GENERAL
+  };
+
+  PartialDateTimeBound() = default;
+
+  std::int64_t timeOfDayKey(EpochSeconds seconds) const;
+  std::int64_t generalKey(EpochSeconds seconds) const;
+
+  Kind kind_ = Kind::GENERAL;
+  /// Weights of the fields (year to second) in the key; zero for unspecified fields.
+  std::array<std::int64_t, 6> weights_{};
+  /// Key of the bound itself.
+  std::int64_t key_ = 0;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_EPOCHSECONDS_H_
@@ -0,0 +1,40 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_LOCATIONCHUNKS_H_
+#define UFO_UTILS_LOCATIONCHUNKS_H_
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ufo {
+
+/// Number of consecutive locations processed together by forEachLocationChunk().
+constexpr std::size_t defaultLocationChunkSize = 256;
+
+/// \brief Call \p processChunk(begin, end) for consecutive ranges [begin, end) of locations
+/// covering [0, \p nlocs).
+///
+/// Intended for column kernels reading level-major blocks returned by GeoVaLs::getAllLevels():
+/// \p processChunk typically loops over levels and, for each level, over the locations of the
+/// chunk, so that the innermost loop runs over contiguous memory. If OpenMP is available, chunks
+/// are processed concurrently; \p processChunk must therefore not throw and must only write to
+/// elements belonging to its own chunk.
+template <typename ChunkFunction>
+void forEachLocationChunk(std::size_t nlocs, const ChunkFunction &processChunk,
+                          std::size_t chunkSize = defaultLocationChunkSize) {
+  const std::ptrdiff_t nchunks = (nlocs + chunkSize - 1) / chunkSize;
+#pragma omp parallel for schedule(static)
+  for (std::ptrdiff_t ichunk = 0; ichunk < nchunks; ++ichunk) {
+    const std::size_t begin = ichunk * chunkSize;
+    processChunk(begin, std::min(begin + chunkSize, nlocs));
+  }
+}
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_LOCATIONCHUNKS_H_
@@ -6,12 +6,14 @@
  */
 
 #include <algorithm>
+#include <memory>
 #include <string>
 
 #include "ioda/ObsSpace.h"
 
 #include "oops/util/missingValues.h"
 
+#include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/utils/RecordHandler.h"
 
@@ -19,13 +21,21 @@ namespace ufo {
   RecordHandler::RecordHandler(const ioda::ObsSpace & obsdb,
                                const Variables & filtervars,
                                const ioda::ObsDataVector<int> & flags,
-                               const bool retainOnlyIfAllFilterVariablesAreValid)
+                               const bool retainOnlyIfAllFilterVariablesAreValid,
+                               const ObsFilterData * data)
     : obsdb_(obsdb),
+      data_(data),
       filtervars_(filtervars),
       flags_(flags),
       retainOnlyIfAllFilterVariablesAreValid_(retainOnlyIfAllFilterVariablesAreValid)
   {}
 
+const RecordIndex & RecordHandler::recordIndex() const {
+  if (!recordIndex_)
+    recordIndex_ = data_ ? data_->recordIndex() : std::make_shared<const RecordIndex>(obsdb_);
+  return *recordIndex_;
+}
+
 std::vector<std::size_t> RecordHandler::getLaunchPositions() const {
   const util::DateTime missingDateTime = util::missingValue(missingDateTime);
 
@@ -43,21 +53,21 @@ std::vector<std::size_t> RecordHandler::getLaunchPositions() const {
   // Vector of locations corresponding to profile launch positions.
   std::vector<std::size_t> launchPositions;
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
+  // Sort the locations of each record according to values of dateTime, ignoring missing values.
+  const std::vector<std::size_t> sortedLocs = recordIndex().sortedWithinRecords(
+      [&](std::size_t a, std::size_t b)
+      {return dateTimes[a] == missingDateTime ?
+          false :
+          (dateTimes[b] == missingDateTime ?
+           true :
+           dateTimes[a] < dateTimes[b]);});
+  const std::vector<std::size_t> &offsets = recordIndex().offsets();
+
   // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < recnums.size(); ++jprof) {
-    // Get locations corresponding to this profile.
-    std::vector<std::size_t> locs = obsdb_.recidx_vector(recnums[jprof]);
-    // Sort locs according to values of dateTime, ignoring missing values.
-    std::stable_sort(locs.begin(),
-                     locs.end(),
-                     [&](int a, int b)
-                     {return dateTimes[a] == missingDateTime ?
-                         false :
-                         (dateTimes[b] == missingDateTime ?
-                          true :
-                          dateTimes[a] < dateTimes[b]);});
+  for (std::size_t jprof = 0; jprof < recordIndex().nrecs(); ++jprof) {
+    // Get locations corresponding to this profile, sorted by dateTime.
+    const gsl::span<const std::size_t> locs(sortedLocs.data() + offsets[jprof],
+                                            offsets[jprof + 1] - offsets[jprof]);
 
     // Find the location corresponding to the launch position.
     // This is defined as the location with the earliest non-missing datetime
@@ -65,7 +75,7 @@ std::vector<std::size_t> RecordHandler::getLaunchPositions() const {
     // If `retainOnlyIfAllFilterVariablesAreValid` is true, all filter variables must
     // have QC flags equal to pass. If it is false then at least one must have a
     // QC flag equal to pass.
-    size_t launchPosition = locs.front();
+    size_t launchPosition = locs[0];
     for (const size_t jloc : locs) {
       // Skip location if dateTime is missing.
       if (dateTimes[jloc] == missingDateTime) continue;
@@ -110,14 +120,11 @@ std::vector<bool> RecordHandler::changeApplyIfRecordsAreSingleObs
   // that record. All other values in the vector are set to false.
   std::vector<bool> applyRecord(obsdb_.nlocs(), false);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
-
   // Loop over profiles.
   const std::vector<std::size_t> launchPositions = getLaunchPositions();
-  for (std::size_t jprof = 0; jprof < recnums.size(); ++jprof) {
+  for (std::size_t jprof = 0; jprof < recordIndex().nrecs(); ++jprof) {
     // Get locations corresponding to this profile.
-    const std::vector<std::size_t> & locs = obsdb_.recidx_vector(recnums[jprof]);
+    const gsl::span<const std::size_t> locs = recordIndex().locations(jprof);
     // Logical `or` of values of apply in the entire record.
     bool applyLogicalOr = false;
     for (std::size_t loc : locs) {
@@ -142,13 +149,10 @@ std::vector<bool> RecordHandler::changeThinnedIfRecordsAreSingleObs
   // in each record are set to logical `or` of the isThinned values in that record.
   std::vector<bool> isThinnedRecord(isThinned.size(), false);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
-
   // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < recnums.size(); ++jprof) {
+  for (std::size_t jprof = 0; jprof < recordIndex().nrecs(); ++jprof) {
     // Get locations corresponding to this profile.
-    const std::vector<std::size_t> & locs = obsdb_.recidx_vector(recnums[jprof]);
+    const gsl::span<const std::size_t> locs = recordIndex().locations(jprof);
     // Logical `or` of values of isThinned in the entire record.
     bool isThinnedLogicalOr = false;
     for (std::size_t loc : locs) {
@@ -189,15 +193,12 @@ void RecordHandler::checkRecordCategoriesImpl(const Variable & categoryVariableN
                 categoryVariableName.variable(),
                 categoryVariable);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
-
   // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < recnums.size(); ++jprof) {
+  for (std::size_t jprof = 0; jprof < recordIndex().nrecs(); ++jprof) {
     // Get locations corresponding to this profile.
-    const std::vector<std::size_t> & locs = obsdb_.recidx_vector(recnums[jprof]);
+    const gsl::span<const std::size_t> locs = recordIndex().locations(jprof);
     for (std::size_t loc : locs) {
-      if (categoryVariable[loc] != categoryVariable[locs.front()]) {
+      if (categoryVariable[loc] != categoryVariable[locs[0]]) {
         throw eckit::UserError("Cannot have multiple categories per record", Here());
       }
     }
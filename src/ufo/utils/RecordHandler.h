@@ -8,11 +8,13 @@
 #ifndef UFO_UTILS_RECORDHANDLER_H_
 #define UFO_UTILS_RECORDHANDLER_H_
 
+#include <memory>
 #include <vector>
 
 #include "ioda/ObsDataVector.h"
 
 #include "ufo/filters/Variables.h"
+#include "ufo/utils/RecordIndex.h"
 
 namespace ioda {
   template <typename DATATYPE> class ObsDataVector;
@@ -20,6 +22,7 @@ namespace ioda {
 }
 
 namespace ufo {
+  class ObsFilterData;
 
   /// \brief Class which is used to ensure records are treated as single observations in the spatial
   /// and temporal thinning routines.
@@ -32,10 +35,13 @@ namespace ufo {
 class RecordHandler
 {
  public:
+  /// If \p data is supplied, its record index (see ObsFilterData::recordIndex()) is used;
+  /// otherwise the record index of \p obsdb is built by this object when first needed.
   explicit RecordHandler(const ioda::ObsSpace & obsdb,
                          const Variables & filtervars,
                          const ioda::ObsDataVector<int> & flags,
-                         const bool retainOnlyIfAllFilterVariablesAreValid);
+                         const bool retainOnlyIfAllFilterVariablesAreValid,
+                         const ObsFilterData * data = nullptr);
 
   /// Modify the input `apply` vector if records are treated as single observations.
   /// This function first finds the location of the earliest non-missing datetime in each record,
@@ -59,6 +65,12 @@ class RecordHandler
   /// ObsSpace.
   const ioda::ObsSpace & obsdb_;
 
+  /// Filter data providing a shared record index (may be null).
+  const ObsFilterData * data_;
+
+  /// Record index of the ObsSpace. Set when first needed.
+  mutable std::shared_ptr<const RecordIndex> recordIndex_;
+
   /// Filter variables.
   const Variables & filtervars_;
 
@@ -74,6 +86,9 @@ class RecordHandler
   /// The default value of this parameter is false.
   const bool retainOnlyIfAllFilterVariablesAreValid_;
 
+  /// Return the record index of the ObsSpace.
+  const RecordIndex & recordIndex() const;
+
   /// Obtain 'launch' position associated with each record, which is the location in the record
   /// with the earliest non-missing datetime.
   std::vector<std::size_t> getLaunchPositions() const;
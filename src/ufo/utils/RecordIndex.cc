@@ -0,0 +1,37 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/RecordIndex.h"
+
+#include "ioda/ObsSpace.h"
+
+namespace ufo {
+
+RecordIndex::RecordIndex(const ioda::ObsSpace &obsdb)
+  : recnums_(obsdb.recidx_all_recnums()),
+    recordOfLocation_(obsdb.nlocs()),
+    positionInRecord_(obsdb.nlocs())
+{
+  offsets_.reserve(recnums_.size() + 1);
+  indices_.reserve(obsdb.nlocs());
+  offsets_.push_back(0);
+  for (size_t irec = 0; irec < recnums_.size(); ++irec) {
+    const std::vector<size_t> &locs = obsdb.recidx_vector(recnums_[irec]);
+    for (size_t pos = 0; pos < locs.size(); ++pos) {
+      recordOfLocation_[locs[pos]] = irec;
+      positionInRecord_[locs[pos]] = pos;
+    }
+    indices_.insert(indices_.end(), locs.begin(), locs.end());
+    offsets_.push_back(indices_.size());
+  }
+}
+
+bool RecordIndex::isValidFor(const ioda::ObsSpace &obsdb) const {
+  return obsdb.nlocs() == nlocs() && obsdb.nrecs() == nrecs();
+}
+
+}  // namespace ufo
@@ -0,0 +1,85 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_RECORDINDEX_H_
+#define UFO_UTILS_RECORDINDEX_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "gsl/gsl-lite.hpp"
+
+namespace ioda {
+  class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief Compact description of the records held by an ObsSpace on the current MPI rank.
+///
+/// The locations of all records are stored contiguously (CSR layout): the locations of the
+/// record with index `irec` are the elements of indices() from `offsets()[irec]` up to (but
+/// excluding) `offsets()[irec + 1]`, in the order used by the ObsSpace's record index (i.e.
+/// sorted by the ObsSpace sort variable, if there is one). Records are indexed in the order of
+/// `ioda::ObsSpace::recidx_all_recnums()`.
+///
+/// The index is built in O(nlocs) and is meant to be built once and shared, e.g. by a filter
+/// and the variable transforms and helpers it uses; see ObsFilterData::recordIndex().
+class RecordIndex {
+ public:
+  explicit RecordIndex(const ioda::ObsSpace &obsdb);
+
+  /// Return true if this index still describes the records of \p obsdb.
+  bool isValidFor(const ioda::ObsSpace &obsdb) const;
+
+  /// Number of records.
+  size_t nrecs() const { return recnums_.size(); }
+  /// Number of locations.
+  size_t nlocs() const { return indices_.size(); }
+
+  /// ObsSpace record number of each record. These numbers are unique across MPI ranks.
+  const std::vector<size_t> &recordNumbers() const { return recnums_; }
+  /// Offsets of the first location of each record in indices(); has nrecs() + 1 elements.
+  const std::vector<size_t> &offsets() const { return offsets_; }
+  /// Locations of all records, stored record after record.
+  const std::vector<size_t> &indices() const { return indices_; }
+
+  /// Locations of the record with index \p irec.
+  gsl::span<const size_t> locations(size_t irec) const {
+    return gsl::span<const size_t>(indices_.data() + offsets_[irec],
+                                   offsets_[irec + 1] - offsets_[irec]);
+  }
+
+  /// Index of the record containing each location.
+  const std::vector<size_t> &recordOfLocation() const { return recordOfLocation_; }
+  /// Position of each location within its record.
+  const std::vector<size_t> &positionInRecord() const { return positionInRecord_; }
+
+  /// \brief Return the locations of all records, each record sorted by \p comp.
+  ///
+  /// The sort is stable, so locations comparing equal keep the order of the ObsSpace record
+  /// index. The result uses the same offsets as indices().
+  template <typename Compare>
+  std::vector<size_t> sortedWithinRecords(Compare comp) const {
+    std::vector<size_t> sorted(indices_);
+    for (size_t irec = 0; irec < nrecs(); ++irec)
+      std::stable_sort(sorted.begin() + offsets_[irec], sorted.begin() + offsets_[irec + 1], comp);
+    return sorted;
+  }
+
+ private:
+  std::vector<size_t> recnums_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> indices_;
+  std::vector<size_t> recordOfLocation_;
+  std::vector<size_t> positionInRecord_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_RECORDINDEX_H_
@@ -0,0 +1,165 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/SolarGeometry.h"
+
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+
+#include "eckit/exception/Exceptions.h"
+#include "oops/util/missingValues.h"
+#include "ufo/utils/Constants.h"
+
+namespace ufo {
+
+namespace {
+
+const std::int64_t secondsPerDay = 60 * 60 * 24;
+const double centuriesPerDay = 1.0 / 36525.0;
+const double hoursPerSecond = 1.0 / 3600.0;
+const double degreesLongitudePerHour = 15.0;
+const double hoursPerDegreeLongitude = 1.0 / degreesLongitudePerHour;
+const double one_over_360 = 1.0 / 360.0;
+
+/// Quantities dependent only on the date (not time).
+struct DayTerms {
+  /// Equation of time (in hours).
+  double eqnt;
+  /// Sine and cosine of the solar declination.
+  double sinDecl;
+  double cosDecl;
+};
+
+/// Compute the quantities dependent only on the day starting at \p dayStart.
+DayTerms computeDayTerms(EpochSeconds dayStart) {
+  static const EpochSeconds startOfLastDayOf19thCentury =
+      fromCalendarFields({1899, 12, 31, 0, 0, 0});
+
+  // Day since 31 Dec 1899 ("0 Jan 1900")
+  // (Used instead of 1 Jan 1900 since 2000 was a leap year.)
+  const std::size_t centuryDay = (dayStart - startOfLastDayOf19thCentury) / secondsPerDay;
+  const double rcd = centuryDay * centuriesPerDay;  // Fraction of days elapsed this century
+  const double rcd2 = rcd * rcd;
+  double ydeg = (rcd * 36000.769 + 279.697) * one_over_360;
+  ydeg = std::fmod(ydeg, 1.0) * 360.0;
+  const double yrad = ydeg * Constants::deg2rad;
+
+  // Compute equation of time (in seconds) for this day
+  // (No reference for this but it gives the correct answers
+  // when compared with table in Norton's Star Atlas.)
+  // The linter protests about extra spaces used for alignment, so is disabled.
+  double eqnt = - (( 93.0 + 14.23 * rcd - 0.0144 * rcd2) * std::sin(yrad))         // NOLINT
+                - ((432.5 - 3.71  * rcd - 0.2063 * rcd2) * std::cos(yrad))         // NOLINT
+                + ((596.9 - 0.81  * rcd - 0.0096 * rcd2) * std::sin(2.0 * yrad))   // NOLINT
+                - ((  1.4 + 0.28  * rcd)                 * std::cos(2.0 * yrad))   // NOLINT
+                + ((  3.8 + 0.6   * rcd)                 * std::sin(3.0 * yrad))   // NOLINT
+                + (( 19.5 - 0.21  * rcd - 0.0103 * rcd2) * std::cos(3.0 * yrad))   // NOLINT
+                - (( 12.8 - 0.03  * rcd)                 * std::sin(4.0 * yrad));  // NOLINT
+
+  // Get solar declination for given day (radians)
+  const double sinalp = std::sin((ydeg - eqnt / 240.0) * Constants::deg2rad);
+  const double taneqn = 0.43382 - 0.00027 * rcd;
+  const double decl = std::atan(taneqn * sinalp);
+  eqnt *= hoursPerSecond;  // Convert to hours
+
+  return DayTerms{eqnt, std::sin(decl), std::cos(decl)};
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+SolarGeometry::SolarGeometry(std::vector<float> lats, std::vector<float> lons,
+                             std::vector<EpochSeconds> times)
+  : lats_(std::move(lats)), lons_(std::move(lons)), times_(std::move(times))
+{
+  ASSERT(lons_.size() == lats_.size() && times_.size() == lats_.size());
+  compute();
+}
+
+// -----------------------------------------------------------------------------
+
+void SolarGeometry::compute() {
+  const float missingFloat = util::missingValue(float());
+  const EpochSeconds missingDateTime = missingEpochSeconds();
+  const size_t nlocs = lats_.size();
+
+  status_.assign(nlocs, Status::VALID);
+  zenith_.assign(nlocs, missingFloat);
+
+  // Find the locations at which the geometry can be computed and the distinct days they fall on
+  std::vector<size_t> validLocs;
+  std::vector<size_t> dayOfValidLoc;
+  std::vector<EpochSeconds> dayStarts;
+  std::unordered_map<EpochSeconds, size_t> dayIndices;
+  for (size_t loc = 0; loc < nlocs; ++loc) {
+    Status &status = status_[loc];
+    if (lats_[loc] == missingFloat) {
+      status = Status::MISSING_LATITUDE;
+    } else if (lons_[loc] == missingFloat) {
+      status = Status::MISSING_LONGITUDE;
+    } else if (times_[loc] == missingDateTime) {
+      status = Status::MISSING_DATETIME;
+    } else if (lats_[loc] < -90 || lats_[loc] > 90) {
+      status = Status::LATITUDE_OUT_OF_RANGE;
+    } else {
+      const CalendarFields fields = toCalendarFields(times_[loc]);
+      if (fields.year > 1950 && fields.year <= 2200) {
+        const EpochSeconds dayStart =
+            times_[loc] - (fields.hour * 3600 + fields.minute * 60 + fields.second);
+        const auto inserted = dayIndices.emplace(dayStart, dayStarts.size());
+        if (inserted.second)
+          dayStarts.push_back(dayStart);
+        validLocs.push_back(loc);
+        dayOfValidLoc.push_back(inserted.first->second);
+      } else {
+        status = Status::DATETIME_OUT_OF_RANGE;
+      }
+    }
+  }
+
+  std::vector<DayTerms> dayTerms;
+  dayTerms.reserve(dayStarts.size());
+  for (EpochSeconds dayStart : dayStarts)
+    dayTerms.push_back(computeDayTerms(dayStart));
+
+  // Gather the terms needed at each valid location into contiguous arrays
+  const size_t numValid = validLocs.size();
+  std::vector<double> sinTerms(numValid), cosTerms(numValid), hourAngles(numValid);
+  for (size_t i = 0; i < numValid; ++i) {
+    const size_t loc = validLocs[i];
+    const DayTerms &day = dayTerms[dayOfValidLoc[i]];
+    const double lat = lats_[loc];
+    const double lon = lons_[loc];
+
+    const double latInRadians = lat * Constants::deg2rad;
+    sinTerms[i] = day.sinDecl * std::sin(latInRadians);
+    cosTerms[i] = day.cosDecl * std::cos(latInRadians);
+
+    const std::int64_t secondsSinceDayStart = times_[loc] - dayStarts[dayOfValidLoc[i]];
+    const double hoursSinceDayStart = secondsSinceDayStart * hoursPerSecond;
+    const double localSolarTimeInHours =
+        lon * hoursPerDegreeLongitude + day.eqnt + hoursSinceDayStart;
+    // Local hour angle (when longitude is 0, this is the Greenwich hour angle given in the
+    // Air Almanac)
+    hourAngles[i] = (localSolarTimeInHours * degreesLongitudePerHour + 180.0) * Constants::deg2rad;
+  }
+
+  std::vector<double> zenith(numValid);
+  for (size_t i = 0; i < numValid; ++i) {
+    const double sinEv = sinTerms[i] + cosTerms[i] * std::cos(hourAngles[i]);
+    zenith[i] = (M_PI / 2 - std::asin(sinEv)) * Constants::rad2deg;
+  }
+
+  for (size_t i = 0; i < numValid; ++i)
+    zenith_[validLocs[i]] = zenith[i];
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,70 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_SOLARGEOMETRY_H_
+#define UFO_UTILS_SOLARGEOMETRY_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "ufo/utils/EpochSeconds.h"
+
+namespace ufo {
+
+/// \brief Position of the Sun seen from a set of observation locations and times.
+///
+/// Quantities depending only on the day (the equation of time and the solar declination) are
+/// computed once per distinct day rather than once per location. Quantities depending on the
+/// location are then evaluated in loops over contiguous arrays holding all valid locations.
+///
+/// The object is meant to be built once and shared by all users of the same locations and
+/// times; see ObsFilterData::solarGeometry().
+///
+/// The formulae are those of `Ops_Solar_Zenith` (subroutine in the Met Office OPS system); see
+/// SolarZenith for references.
+class SolarGeometry {
+ public:
+  /// Reason why the solar geometry at a location could not be computed (if any).
+  enum class Status : char {
+    VALID,
+    MISSING_LATITUDE,
+    MISSING_LONGITUDE,
+    MISSING_DATETIME,
+    LATITUDE_OUT_OF_RANGE,
+    DATETIME_OUT_OF_RANGE
+  };
+
+  /// \brief Compute the solar geometry at locations with latitudes \p lats and longitudes
+  /// \p lons (in degrees) at times \p times.
+  SolarGeometry(std::vector<float> lats, std::vector<float> lons,
+                std::vector<EpochSeconds> times);
+
+  size_t nlocs() const { return status_.size(); }
+
+  const std::vector<float> &latitudes() const { return lats_; }
+  const std::vector<float> &longitudes() const { return lons_; }
+  const std::vector<EpochSeconds> &times() const { return times_; }
+
+  /// Status of each location.
+  const std::vector<Status> &status() const { return status_; }
+  /// Solar zenith angle (in degrees) at each location; missing unless the status is VALID.
+  const std::vector<float> &zenith() const { return zenith_; }
+
+ private:
+  void compute();
+
+  std::vector<float> lats_;
+  std::vector<float> lons_;
+  std::vector<EpochSeconds> times_;
+
+  std::vector<Status> status_;
+  std::vector<float> zenith_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_SOLARGEOMETRY_H_
@@ -415,7 +415,7 @@ DataExtractor<ExtractedValue>::DataExtractor(const std::string &filepath,
   // Read the data from the file
   load(filepath, group);
   // Start by constraining to the full range of our data
-  resetExtract();
+  resetExtract(query_);
   // Initialise splitter for each dimension
   splitter_.emplace_back(ufo::RecursiveSplitter(interpolatedArray_.shape()[0]));
   splitter_.emplace_back(ufo::RecursiveSplitter(interpolatedArray_.shape()[1]));
@@ -436,9 +436,6 @@ void DataExtractor<ExtractedValue>::load(const std::string &filepath,
                                             [input.payloadArray.shape()[1]]
                                             [input.payloadArray.shape()[2]]);
   interpolatedArray_ = std::move(input.payloadArray);
-  // Set the unconstrained size of matching ranges along both axes of the payload array.
-  for (size_t i = 0; i < constrainedRanges_.size(); ++i)
-    constrainedRanges_[i] = ConstrainedRange(input.payloadArray.shape()[i]);
 }
 
 
@@ -460,7 +457,7 @@ DataExtractor<ExtractedValue>::createBackendFor(const std::string &filepath) {
 template <typename ExtractedValue>
 void DataExtractor<ExtractedValue>::sort() {
   DataExtractorPayload<ExtractedValue> sortedArray = interpolatedArray_;
-  nextCoordToExtractBy_ = coordsToExtractBy_.begin();
+  resetExtract(query_);
 
   for (size_t dim = 0; dim < dim2CoordMapping_.size(); ++dim) {
     if (interpolatedArray_.shape()[dim] == 1)  // Avoid sorting scalar coordinates
@@ -553,51 +550,77 @@ void DataExtractor<ExtractedValue>::scheduleSort(const std::string &varName,
 }
 
 
+template <typename ExtractedValue>
+typename DataExtractor<ExtractedValue>::Query DataExtractor<ExtractedValue>::newQuery() const {
+  Query query(*this);
+  resetExtract(query);
+  return query;
+}
+
+
 template <typename ExtractedValue>
 void DataExtractor<ExtractedValue>::extract(float obVal) {
-  extractImpl(obVal);
+  extractImpl(query_, obVal);
 }
 
 
 template <typename ExtractedValue>
 void DataExtractor<ExtractedValue>::extract(int obVal) {
-  extractImpl(obVal);
+  extractImpl(query_, obVal);
 }
 
 
 template <typename ExtractedValue>
 void DataExtractor<ExtractedValue>::extract(const std::string &obVal) {
-  extractImpl(obVal);
+  extractImpl(query_, obVal);
+}
+
+
+template <typename ExtractedValue>
+void DataExtractor<ExtractedValue>::Query::extract(float obVal) {
+  extractor_->extractImpl(*this, obVal);
+}
+
+
+template <typename ExtractedValue>
+void DataExtractor<ExtractedValue>::Query::extract(int obVal) {
+  extractor_->extractImpl(*this, obVal);
+}
+
+
+template <typename ExtractedValue>
+void DataExtractor<ExtractedValue>::Query::extract(const std::string &obVal) {
+  extractor_->extractImpl(*this, obVal);
 }
 
 
 template <typename ExtractedValue>
 template <typename T>
-void DataExtractor<ExtractedValue>::extractImpl(const T &obVal) {
-  if (nextCoordToExtractBy_ == coordsToExtractBy_.cend())
+void DataExtractor<ExtractedValue>::extractImpl(Query &query, const T &obVal) const {
+  if (query.nextCoordToExtractBy_ == coordsToExtractBy_.size())
     throw eckit::UserError("Too many extract() calls made for the expected number of variables.",
                            Here());
-  T obValN = applyExtrapolation(obVal);
-  if (resultSet_)
+  T obValN = applyExtrapolation(query, obVal);
+  if (query.resultSet_)
     return;
 
   // Perform the extraction using the selected method
-  if (nextCoordToExtractBy_->method == InterpMethod::LINEAR)
-    maybeExtractByLinearInterpolation(obValN);
+  const Coordinate &coord = coordsToExtractBy_[query.nextCoordToExtractBy_];
+  if (coord.method == InterpMethod::LINEAR)
+    maybeExtractByLinearInterpolation(query, obValN);
   else
-    match(nextCoordToExtractBy_->method, nextCoordToExtractBy_->name,
-          boost::get<std::vector<T>>(nextCoordToExtractBy_->values), obValN,
-          nextCoordToExtractBy_->equidistantChoice,
-          constrainedRanges_[nextCoordToExtractBy_->payloadDim]);
+    match(coord.method, coord.name, boost::get<std::vector<T>>(coord.values), obValN,
+          coord.equidistantChoice, query.constrainedRanges_[coord.payloadDim]);
 
-  ++nextCoordToExtractBy_;
+  ++query.nextCoordToExtractBy_;
 }
 
 
 // Primary template, used for all ExtractedValue types except float.
 template <typename ExtractedValue>
 template <typename T>
-void DataExtractor<ExtractedValue>::maybeExtractByLinearInterpolation(const T &obVal) {
+void DataExtractor<ExtractedValue>::maybeExtractByLinearInterpolation(Query &query,
+                                                                      const T &obVal) const {
   // Should never be called -- this error should be detected earlier.
   throw eckit::BadParameter("Linear interpolation can be used when extracting floating-point "
                             "values, but not integers or strings.", Here());
@@ -607,69 +630,83 @@ void DataExtractor<ExtractedValue>::maybeExtractByLinearInterpolation(const T &o
 // Specialization for ExtractedValue = float.
 template <>
 template <typename T>
-void DataExtractor<float>::maybeExtractByLinearInterpolation(const T &obVal) {
-  int dimIndex = nextCoordToExtractBy_->payloadDim;
+void DataExtractor<float>::maybeExtractByLinearInterpolation(Query &query,
+                                                             const T &obVal) const {
+  const Coordinate &coord = coordsToExtractBy_[query.nextCoordToExtractBy_];
+  int dimIndex = coord.payloadDim;
   const auto &interpolatedArray = get1DSlice(interpolatedArray_,
                                              dimIndex,
-                                             constrainedRanges_);
-  result_ = linearInterpolation(nextCoordToExtractBy_->name,
-                                boost::get<std::vector<T>>(nextCoordToExtractBy_->values),
-                                obVal, constrainedRanges_[dimIndex], interpolatedArray);
-  resultSet_ = true;
+                                             query.constrainedRanges_);
+  query.result_ = linearInterpolation(coord.name, boost::get<std::vector<T>>(coord.values),
+                                      obVal, query.constrainedRanges_[dimIndex],
+                                      interpolatedArray);
+  query.resultSet_ = true;
 }
 
 
 // Primary template, used for all ExtractedValue types except float.
 template <typename ExtractedValue>
-ExtractedValue DataExtractor<ExtractedValue>::getResult() {
+ExtractedValue DataExtractor<ExtractedValue>::getResultImpl(Query &query) const {
   // Fetch the result
-  ExtractedValue res = getUniqueMatch();
-  resetExtract();
+  ExtractedValue res = getUniqueMatch(query);
+  resetExtract(query);
   return res;
 }
 
 
 // Specialization adding support for linear interpolation.
 template <>
-float DataExtractor<float>::getResult() {
+float DataExtractor<float>::getResultImpl(Query &query) const {
   // Fetch the result
-  if (resultSet_) {
+  if (query.resultSet_) {
     // This was derived from linear/bilinear interpolation so return it.
-    resetExtract();
-    return result_;
+    resetExtract(query);
+    return query.result_;
   }
 
-  float res = getUniqueMatch();
-  resetExtract();
+  float res = getUniqueMatch(query);
+  resetExtract(query);
   return res;
 }
 
 
 template <typename ExtractedValue>
-ExtractedValue DataExtractor<ExtractedValue>::getUniqueMatch() const {
+ExtractedValue DataExtractor<ExtractedValue>::getResult() {
+  return getResultImpl(query_);
+}
+
+
+template <typename ExtractedValue>
+ExtractedValue DataExtractor<ExtractedValue>::Query::getResult() {
+  return extractor_->getResultImpl(*this);
+}
+
+
+template <typename ExtractedValue>
+ExtractedValue DataExtractor<ExtractedValue>::getUniqueMatch(const Query &query) const {
   // This function should be called only if linear interpolation is not used within the
   // extraction process.
-  ASSERT(!resultSet_);
+  ASSERT(!query.resultSet_);
 
-  for (size_t dim=0; dim < constrainedRanges_.size(); dim++) {
-    if (constrainedRanges_[dim].size() == 0)
+  const std::array<ConstrainedRange, 3> &ranges = query.constrainedRanges_;
+  for (size_t dim=0; dim < ranges.size(); dim++) {
+    if (ranges[dim].size() == 0)
       throw eckit::Exception("No match found in the interpolation array.", Here());
-    else if (constrainedRanges_[dim].size() > 1)
+    else if (ranges[dim].size() > 1)
       throw eckit::Exception("Extraction criteria were not sufficient to identify a unique match "
                              "in the interpolation array.", Here());
   }
-  return interpolatedArray_[constrainedRanges_[0].begin()]
-                           [constrainedRanges_[1].begin()]
-                           [constrainedRanges_[2].begin()];
+  return interpolatedArray_[ranges[0].begin()][ranges[1].begin()][ranges[2].begin()];
 }
 
 
 template <typename ExtractedValue>
-void DataExtractor<ExtractedValue>::resetExtract() {
-  for (ConstrainedRange &range : constrainedRanges_)
-    range.reset();
-  resultSet_ = false;
-  nextCoordToExtractBy_ = coordsToExtractBy_.begin();
+void DataExtractor<ExtractedValue>::resetExtract(Query &query) const {
+  // Set the unconstrained size of matching ranges along all axes of the payload array.
+  for (size_t dim = 0; dim < query.constrainedRanges_.size(); ++dim)
+    query.constrainedRanges_[dim] = ConstrainedRange(interpolatedArray_.shape()[dim]);
+  query.resultSet_ = false;
+  query.nextCoordToExtractBy_ = 0;
 }
 
 
@@ -463,6 +463,10 @@ enum class EquidistantChoice {
 /// * To extract a value from the payload array for a particular data point, pass the values of
 ///   successive coordinates of that point to calls to extract() (in the order matching the order of
 ///   the preceding calls to scheduleSort()). Then call getResult() to retrieve the extracted value.
+/// * Alternatively, call newQuery() and then the extract() and getResult() member functions of the
+///   returned Query object. The data loaded from the file are not modified by these calls, so
+///   values for different data points can be extracted concurrently by separate threads, each
+///   using its own Query.
 ///
 /// Here is a summary of particulars to the extraction/interpolation algorithms available:
 /// - Nearest neighbour 'interpolation' chooses the **first** nearest value to be found in the case
@@ -486,6 +490,13 @@ class DataExtractor
   /// \param[in] group Group containing the payload variable.
   explicit DataExtractor(const std::string &filepath, const std::string &group);
 
+  // query_ and the Query objects returned by newQuery() point to the extractor that created
+  // them, so it can be neither copied nor moved.
+  DataExtractor(const DataExtractor &) = delete;
+  DataExtractor(DataExtractor &&) = delete;
+  DataExtractor &operator=(const DataExtractor &) = delete;
+  DataExtractor &operator=(DataExtractor &&) = delete;
+
   /// \brief Update the instruction on how to sort the data for the provided variable name.
   /// \details This works iteratively by further splitting the RecursiveSplitter sub-groups
   /// according to the variable name provided.  By this, it is possible to sort the data in
@@ -514,6 +525,47 @@ class DataExtractor
   /// this sort.
   void sort();
 
+  /// \brief State of a single extraction: the ranges of the payload array still matching the
+  /// coordinate values passed to extract() so far and the result of any interpolation.
+  ///
+  /// Queries are created by newQuery(). They do not modify the extractor that created them, so
+  /// once sort() has been called several queries (e.g. one per thread) may be used concurrently.
+  /// Their extract() and getResult() member functions behave like those of DataExtractor.
+  class Query {
+   public:
+    void extract(float obVal);
+    void extract(int obVal);
+    void extract(const std::string &obVal);
+
+    template <typename T, typename R>
+    void extract(T obValDim0, R obValDim1) {
+      extractor_->extractImpl(*this, obValDim0, obValDim1);
+    }
+
+    ExtractedValue getResult();
+
+   private:
+    friend class DataExtractor;
+
+    explicit Query(const DataExtractor &extractor) : extractor_(&extractor) {}
+
+    const DataExtractor *extractor_;
+    // Object represent the extraction range in both dimensions.
+    std::array<ConstrainedRange, 3> constrainedRanges_;
+    // Index of the coordinate to be used in the next call to extract().
+    size_t nextCoordToExtractBy_ = 0;
+    // Interpolation result.  Used when utilising linear/bilinear interpolation and also with
+    // extrapolation (where applicable).
+    ExtractedValue result_{};
+    // Set to true if result_ is a valid value.
+    bool resultSet_ = false;
+  };
+
+  /// \brief Create the state of a new extraction from the sorted data.
+  ///
+  /// Call this function after sort().
+  Query newQuery() const;
+
   /// \brief Perform extract, given an observation value for the coordinate associated with this
   /// extract iteration.
   /// \details Calls the relevant extract method (linear, nearest or exact), corresponding to the
@@ -537,18 +589,7 @@ class DataExtractor
   /// \param[in] obValDim1 is the observation value used for the extract operation corresponding
   /// to the second coordinate utilised by the underlying method.
   template <typename T, typename R>
-  void extract(T obValDim0, R obValDim1) {
-    if (nextCoordToExtractBy_ == coordsToExtractBy_.cend())
-      throw eckit::UserError("Too many extract() calls made for the expected number of variables.",
-                             Here());
-
-    // Perform the extraction using the selected method
-    if (nextCoordToExtractBy_->method == InterpMethod::BILINEAR)
-      maybeExtractByBiLinearInterpolation(obValDim0, obValDim1);
-    else
-        throw eckit::UserError("Only bilinear method supports two variables as arguments.", Here());
-    ++nextCoordToExtractBy_;
-  }
+  void extract(T obValDim0, R obValDim1) { extractImpl(query_, obValDim0, obValDim1); }
 
   /// \brief Fetch the final interpolated value.
   /// \details This will only be successful if previous calls to extract() have produced a single
@@ -556,32 +597,51 @@ class DataExtractor
   ExtractedValue getResult();
 
  private:
-  /// \brief Common implementation of the overloaded public function extract().
+  /// \brief Common implementation of the overloaded function Query::extract() taking one value.
   template <typename T>
-  void extractImpl(const T &obVal);
+  void extractImpl(Query &query, const T &obVal) const;
+
+  /// \brief Implementation of the function Query::extract() taking two values.
+  template <typename T, typename R>
+  void extractImpl(Query &query, const T &obValDim0, const R &obValDim1) const {
+    if (query.nextCoordToExtractBy_ == coordsToExtractBy_.size())
+      throw eckit::UserError("Too many extract() calls made for the expected number of variables.",
+                             Here());
+
+    // Perform the extraction using the selected method
+    if (coordsToExtractBy_[query.nextCoordToExtractBy_].method == InterpMethod::BILINEAR)
+      maybeExtractByBiLinearInterpolation(query, obValDim0, obValDim1);
+    else
+        throw eckit::UserError("Only bilinear method supports two variables as arguments.", Here());
+    ++query.nextCoordToExtractBy_;
+  }
+
+  /// \brief Implementation of the function Query::getResult().
+  ExtractedValue getResultImpl(Query &query) const;
 
   /// \brief Apply extrapolation stage.
   ///
   /// Return a new obVal after applying the relevant extrapolation mode for the given value.
-  /// It can also populate `result_` (as indicated by `resultSet_`), the final interpolation
-  /// result where applicable (where out-of-bounds should return missing).  Where `result_`
-  /// is populated, all subsequent extraction stages are then ignored.
+  /// It can also populate `query.result_` (as indicated by `query.resultSet_`), the final
+  /// interpolation result where applicable (where out-of-bounds should return missing).  Where
+  /// `query.result_` is populated, all subsequent extraction stages are then ignored.
   template <typename T>
-  T applyExtrapolation(const T &obVal) {
-    if (resultSet_)
+  T applyExtrapolation(Query &query, const T &obVal) const {
+    if (query.resultSet_)
       return obVal;
 
-    const std::vector<T> varValues = boost::get<std::vector<T>>(nextCoordToExtractBy_->values);
-    ConstrainedRange &range = constrainedRanges_[nextCoordToExtractBy_->payloadDim];
-    const std::string &varName = nextCoordToExtractBy_->name;
+    const Coordinate &coord = coordsToExtractBy_[query.nextCoordToExtractBy_];
+    const std::vector<T> &varValues = boost::get<std::vector<T>>(coord.values);
+    const ConstrainedRange &range = query.constrainedRanges_[coord.payloadDim];
+    const std::string &varName = coord.name;
 
     // Handle extrapolation mode
     T obValN = obVal;
-    if ((nextCoordToExtractBy_->method == ufo::InterpMethod::EXACT) &&
-        (nextCoordToExtractBy_->extrapMode != ufo::ExtrapolationMode::ERROR))
+    if ((coord.method == ufo::InterpMethod::EXACT) &&
+        (coord.extrapMode != ufo::ExtrapolationMode::ERROR))
       throw eckit::BadParameter("Only 'error' extrapolation mode supported for 'exact' method "
                                 "extract.", Here());
-    switch (nextCoordToExtractBy_->extrapMode) {
+    switch (coord.extrapMode) {
       case ufo::ExtrapolationMode::ERROR:
         // Error (no extrapolation) is the default behaviour of all methods so no action required.
         break;
@@ -593,8 +653,8 @@ class DataExtractor
         }
         break;
       case ufo::ExtrapolationMode::MISSING:
-        resultSet_ = true;
-        result_ = util::missingValue(result_);
+        query.resultSet_ = true;
+        query.result_ = util::missingValue(query.result_);
         return obValN;
       default:
         throw eckit::Exception("Unrecognised extrapolation mode for '" + varName + "', please "
@@ -606,10 +666,11 @@ class DataExtractor
   /// \brief Perform extraction using piecewise linear interpolation, if it's compatible with the
   /// ExtractedValue type in use; otherwise throw an exception.
   template <typename T>
-  void maybeExtractByLinearInterpolation(const T &obVal);
+  void maybeExtractByLinearInterpolation(Query &query, const T &obVal) const;
 
   template <typename T, typename R>
-  void maybeExtractByBiLinearInterpolation(const T &obValDim0, const R &obValDim1) {
+  void maybeExtractByBiLinearInterpolation(Query &query, const T &obValDim0,
+                                           const R &obValDim1) const {
     // Should never be called -- this error should be detected earlier (scheduleSort).
     throw eckit::BadParameter("Bilinear interpolation can be used when extracting floating-point "
                               "values, but not integers or strings.", Here());
@@ -620,17 +681,17 @@ class DataExtractor
   ///
   /// An exception is thrown if these calls haven't produced a unique match of the extraction
   /// criteria.
-  ExtractedValue getUniqueMatch() const;
+  ExtractedValue getUniqueMatch(const Query &query) const;
 
-  /// \brief Reset the extraction range for this object.
+  /// \brief Reset the extraction range of \p query.
   /// \details Each time an exactMatch, nearestMatch, leastUpperBoundMatch or
   /// greatestLowerBoundMatch call is made for one or more variable,
   /// the extraction range is further constrained to match our updated match conditions.  After
   /// the final 'extract' is made (i.e. an interpolated value is derived) it is desirable to reset
   /// the extraction range by calling this method.
-  /// \internal This is called by the getResult member function just before returning the
+  /// \internal This is called by the getResultImpl member function just before returning the
   /// interpolated value.
-  void resetExtract();
+  void resetExtract(Query &query) const;
 
   /// \brief Load all data from the input file.
   void load(const std::string &filepath, const std::string &interpolatedArrayGroup);
@@ -639,9 +700,6 @@ class DataExtractor
   static std::unique_ptr<DataExtractorBackend<ExtractedValue>> createBackendFor(
       const std::string &filepath);
 
-  // Object represent the extraction range in both dimensions.
-  std::array<ConstrainedRange, 3> constrainedRanges_;
-
   // Container holding coordinate arrays (of all supported types) loaded from the input file.
   typedef boost::variant<std::vector<int>,
                          std::vector<float>,
@@ -649,11 +707,6 @@ class DataExtractor
   std::unordered_map<std::string, CoordinateValues> coordsVals_;
   // The array to be interpolated (the payload array).
   DataExtractorPayload<ExtractedValue> interpolatedArray_;
-  // Interpolation result.  Used when utilising linear/bilinear interpolation and also with
-  // extrapolation (where applicable).
-  ExtractedValue result_;
-  // Set to true if result_ is a valid value.
-  bool resultSet_;
   // Container for re-ordering our data
   std::vector<ufo::RecursiveSplitter> splitter_;
 
@@ -682,7 +735,9 @@ class DataExtractor
 
   /// Coordinates to use in successive calls to extract().
   std::vector<Coordinate> coordsToExtractBy_;
-  typename std::vector<Coordinate>::const_iterator nextCoordToExtractBy_;
+
+  /// Query used by the extract() and getResult() member functions of this class.
+  Query query_{*this};
 };
 
 
@@ -690,39 +745,41 @@ class DataExtractor
 template <>
 template <typename T, typename R>
 void DataExtractor<float>::maybeExtractByBiLinearInterpolation(
-    const T &obValDim0, const R &obValDim1) {
-  auto &ranges = constrainedRanges_;
+    Query &query, const T &obValDim0, const R &obValDim1) const {
+  const auto &ranges = query.constrainedRanges_;
 
-  T obValDim0N = applyExtrapolation(obValDim0);
-  if (resultSet_)
+  T obValDim0N = applyExtrapolation(query, obValDim0);
+  if (query.resultSet_)
     return;
-  const size_t dimIndex0 = nextCoordToExtractBy_->payloadDim;
-  const std::string &varName0 = nextCoordToExtractBy_->name;
-  const std::vector<T> &varValues0 = boost::get<std::vector<T>>(nextCoordToExtractBy_->values);
-  ++nextCoordToExtractBy_;  // Consume variable
-
-  if (nextCoordToExtractBy_->method != InterpMethod::BILINEAR)
+  const Coordinate &coord0 = coordsToExtractBy_[query.nextCoordToExtractBy_];
+  const size_t dimIndex0 = coord0.payloadDim;
+  const std::string &varName0 = coord0.name;
+  const std::vector<T> &varValues0 = boost::get<std::vector<T>>(coord0.values);
+  ++query.nextCoordToExtractBy_;  // Consume variable
+
+  const Coordinate &coord1 = coordsToExtractBy_[query.nextCoordToExtractBy_];
+  if (coord1.method != InterpMethod::BILINEAR)
     throw eckit::BadParameter("Second parameter provided to the Bilinear interpolator is not of "
                               "method 'bilinear'.", Here());
-  R obValDim1N = applyExtrapolation(obValDim1);
-  if (resultSet_)
+  R obValDim1N = applyExtrapolation(query, obValDim1);
+  if (query.resultSet_)
     return;
-  const size_t dimIndex1 = nextCoordToExtractBy_->payloadDim;
-  const std::string &varName1 = nextCoordToExtractBy_->name;
-  const std::vector<R> &varValues1 = boost::get<std::vector<R>>(nextCoordToExtractBy_->values);
+  const size_t dimIndex1 = coord1.payloadDim;
+  const std::string &varName1 = coord1.name;
+  const std::vector<R> &varValues1 = boost::get<std::vector<R>>(coord1.values);
 
   auto interpolatedArray = get2DSlice(interpolatedArray_, dimIndex0, dimIndex1,
                                       ranges);
   if (dimIndex1 > dimIndex0) {
-    result_ = bilinearInterpolation(varName0, varValues0, obValDim0N, ranges[dimIndex0],
-                                    varName1, varValues1, obValDim1N, ranges[dimIndex1],
-                                    interpolatedArray);
+    query.result_ = bilinearInterpolation(varName0, varValues0, obValDim0N, ranges[dimIndex0],
+                                          varName1, varValues1, obValDim1N, ranges[dimIndex1],
+                                          interpolatedArray);
   } else {
-    result_ = bilinearInterpolation(varName1, varValues1, obValDim1N, ranges[dimIndex1],
-                                    varName0, varValues0, obValDim0N, ranges[dimIndex0],
-                                    interpolatedArray);
+    query.result_ = bilinearInterpolation(varName1, varValues1, obValDim1N, ranges[dimIndex1],
+                                          varName0, varValues0, obValDim0N, ranges[dimIndex0],
+                                          interpolatedArray);
   }
-  resultSet_ = true;
+  query.resultSet_ = true;
 }
 
 
@@ -6,35 +6,60 @@
  */
 
 #include "ufo/utils/metoffice/MetOfficeBMatrixStatic.h"
+
+#include <array>
+#include <cstdint>
+
+#include "eckit/config/Configuration.h"
+#include "eckit/exception/Exceptions.h"
 #include "oops/util/Logger.h"
+#include "ufo/utils/metoffice/MetOfficeMatrixCache.h"
 
 namespace ufo {
 
+namespace {
+
+// Arrays stored in cache files
+enum BMatrixCacheArray {SOUTH_LIMITS, NORTH_LIMITS, ELEMENTS, INVERSES};
+
+/// Options affecting the contents of the bmatrix; cache files record them to check that they
+/// are used consistently.
+std::string cacheSignature(const eckit::Configuration & config) {
+  std::string signature = "background fields:";
+  for (const std::string & field : config.getStringVector("background fields"))
+    signature += " " + field;
+  signature += config.getBool("qtotal") ? "; qtotal: true" : "; qtotal: false";
+  return signature;
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 /// \brief Constructor
 MetOfficeBMatrixStatic::MetOfficeBMatrixStatic(const eckit::Configuration & config):
-    nbands_(0), nelements_(0), southlimits_(), northlimits_(), elements_()
+    nbands_(0), nelements_(0), southlimits_(), northlimits_(), cache_(), ownedElements_(),
+    elements_(nullptr), inverses_(nullptr)
 {
   oops::Log::trace() << "MetOfficeBMatrixStatic constructor starting" << std::endl;
 
+  if (config.has("BMatrix cache")) {
+    readCache(config.getString("BMatrix cache"), config);
+    oops::Log::trace() << "MetOfficeBMatrixStatic constructor end" << std::endl;
+    return;
+  }
+
   // Read bmatrix file into Fortran object
   ufo_metoffice_bmatrixstatic_setup_f90(keyMetOfficeBMatrixStatic_, config, nbands_, nelements_);
 
-  // Map Fortran data to c++
+  // Map Fortran data to c++; band i of B is stored in column-major order from element
+  // i*nelements_*nelements_ onwards
   northlimits_.resize(nbands_);
   southlimits_.resize(nbands_);
-  size_t ntotal = nelements_ * nelements_ * nbands_;
-  std::vector<float> Btotal(ntotal);
+  ownedElements_.resize(nelements_ * nelements_ * nbands_);
   ufo_metoffice_bmatrixstatic_getelements_f90(keyMetOfficeBMatrixStatic_,
                                               nelements_, nbands_, southlimits_.data(),
-                                              northlimits_.data(), Btotal.data());
-
-  // For each of nbands, store B matrix in container
-  for (size_t i = 0; i < nbands_; ++i) {
-    Eigen::Map<Eigen::MatrixXf> bmap(Btotal.data()+i*nelements_*nelements_,
-                                     nelements_, nelements_);
-    elements_.push_back(bmap);
-  }
+                                              northlimits_.data(), ownedElements_.data());
+  elements_ = ownedElements_.data();
 
   // Remove the Fortran object because it is no longer needed
   ufo_metoffice_bmatrixstatic_delete_f90(keyMetOfficeBMatrixStatic_);
@@ -42,6 +67,54 @@ MetOfficeBMatrixStatic::MetOfficeBMatrixStatic(const eckit::Configuration & conf
   oops::Log::trace() << "MetOfficeBMatrixStatic constructor end" << std::endl;
 }
 // -----------------------------------------------------------------------------
+MetOfficeBMatrixStatic::~MetOfficeBMatrixStatic() {}
+// -----------------------------------------------------------------------------
+/// \brief Map the bmatrix from a cache file
+void MetOfficeBMatrixStatic::readCache(const std::string & filename,
+                                       const eckit::Configuration & config) {
+  cache_ = MetOfficeMatrixCache::open(filename, MetOfficeMatrixCache::Kind::BMatrix,
+                                      cacheSignature(config));
+  nbands_ = cache_->dim(0);
+  nelements_ = cache_->dim(1);
+  const float * south = cache_->array<float>(SOUTH_LIMITS, nbands_);
+  const float * north = cache_->array<float>(NORTH_LIMITS, nbands_);
+  southlimits_.assign(south, south + nbands_);
+  northlimits_.assign(north, north + nbands_);
+  elements_ = cache_->array<float>(ELEMENTS, nelements_ * nelements_ * nbands_);
+  if (cache_->has(INVERSES))
+    inverses_ = cache_->array<float>(INVERSES, nelements_ * nelements_ * nbands_);
+}
+// -----------------------------------------------------------------------------
+/// \brief Write the bmatrix to a cache file
+void MetOfficeBMatrixStatic::writeCache(const std::string & filename,
+                                        const eckit::Configuration & config,
+                                        bool withInverse) const {
+  const size_t bandSize = nelements_ * nelements_;
+  std::vector<float> inverses;
+  if (withInverse) {
+    inverses.resize(bandSize * nbands_);
+    for (size_t iband = 0; iband < nbands_; ++iband) {
+      Eigen::Map<Eigen::MatrixXf> inverse(inverses.data() + iband * bandSize,
+                                          nelements_, nelements_);
+      inverse = band(iband).cast<double>().inverse().cast<float>();
+    }
+  }
+  const std::array<std::uint64_t, MetOfficeMatrixCache::maxDims> dims{{nbands_, nelements_}};
+  std::vector<MetOfficeMatrixCache::ArrayData> arrays(INVERSES + 1);
+  arrays[SOUTH_LIMITS] = {southlimits_.data(), nbands_ * sizeof(float)};
+  arrays[NORTH_LIMITS] = {northlimits_.data(), nbands_ * sizeof(float)};
+  arrays[ELEMENTS] = {elements_, nbands_ * bandSize * sizeof(float)};
+  arrays[INVERSES] = {withInverse ? inverses.data() : nullptr, nbands_ * bandSize * sizeof(float)};
+  MetOfficeMatrixCache::write(filename, MetOfficeMatrixCache::Kind::BMatrix, dims, arrays,
+                              cacheSignature(config));
+}
+// -----------------------------------------------------------------------------
+/// \brief Return the bmatrix for band \p iband
+Eigen::Map<const Eigen::MatrixXf> MetOfficeBMatrixStatic::band(const size_t iband) const {
+  return Eigen::Map<const Eigen::MatrixXf>(elements_ + iband * nelements_ * nelements_,
+                                           nelements_, nelements_);
+}
+// -----------------------------------------------------------------------------
 /// \brief Return bmatrix size (number of rows or columns of square matrix)
 size_t MetOfficeBMatrixStatic::getsize(void) const {
   return nelements_;
@@ -58,16 +131,38 @@ void MetOfficeBMatrixStatic::multiply(const float lat,
                                       const Eigen::MatrixXf & in,
                                       Eigen::MatrixXf & out) const {
   size_t index = this->getindex(lat);
-  out = elements_[index] * in;
+  out = band(index) * in;
+}
+// -----------------------------------------------------------------------------
+/// \brief Multiply input matrix by inverse of bmatrix array based on latitude
+void MetOfficeBMatrixStatic::multiplyInverse(const float lat,
+                                             const Eigen::MatrixXf & in,
+                                             Eigen::MatrixXf & out) const {
+  size_t index = this->getindex(lat);
+  if (inverses_ != nullptr) {
+    out = Eigen::Map<const Eigen::MatrixXf>(inverses_ + index * nelements_ * nelements_,
+                                            nelements_, nelements_) * in;
+  } else {
+    out = band(index).ldlt().solve(in);
+  }
 }
 
 // -----------------------------------------------------------------------------
 /// \brief Scale elements of bmatrix array to user-defined standard deviation
 void MetOfficeBMatrixStatic::scale(const size_t elem, const float stdev) {
+  // A mapped cache file is read-only: take a private copy of B first. Inverses read from the
+  // cache no longer apply.
+  if (elements_ != ownedElements_.data()) {
+    ownedElements_.assign(elements_, elements_ + nelements_ * nelements_ * nbands_);
+    elements_ = ownedElements_.data();
+  }
+  inverses_ = nullptr;
   for (size_t iband = 0; iband < nbands_; ++iband) {
-    float scaling = stdev/std::sqrt(elements_[iband](elem, elem));
-    elements_[iband].row(elem) *= scaling;
-    elements_[iband].col(elem) *= scaling;
+    Eigen::Map<Eigen::MatrixXf> bmatrix(ownedElements_.data() + iband * nelements_ * nelements_,
+                                        nelements_, nelements_);
+    float scaling = stdev/std::sqrt(bmatrix(elem, elem));
+    bmatrix.row(elem) *= scaling;
+    bmatrix.col(elem) *= scaling;
   }
 }
 // -----------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 #include <Eigen/Dense>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -25,11 +26,24 @@ namespace eckit {
 
 namespace ufo {
 
+  class MetOfficeMatrixCache;
+
 // -----------------------------------------------------------------------------
 /// MetOfficeBMatrixStatic: Met Office static model covariance
 /// This class provides access to the static b matrix used for radiance
 /// processing by the Met Office.  The objects main method is to multiply
 /// an eigen matrix by the bmatrix
+///
+/// The b matrix is read from the file given by the "BMatrix" option unless the
+/// "BMatrix cache" option is set. In that case it is memory-mapped from a binary
+/// file written by writeCache() (e.g. by the ufo_metoffice_matrix_cache.x application)
+/// and shared by all objects using that file. The cache file may also hold the inverse of
+/// each band, used by multiplyInverse(); B is then never factorised at run time.
+///
+/// Only C++ users of this class (currently CloudCostFunction) read the cache file.
+/// RTTOVOneDVarCheck and GNSSROOneDVarCheck read B, and invert it, through the Fortran
+/// ufo_metoffice_bmatrixstatic_mod and ufo_gnssroonedvarcheck_get_bmatrix_mod modules and do
+/// not benefit from it.
 // -----------------------------------------------------------------------------
 
 class MetOfficeBMatrixStatic : public util::Printable,
@@ -39,19 +53,38 @@ class MetOfficeBMatrixStatic : public util::Printable,
 
   explicit MetOfficeBMatrixStatic(const eckit::Configuration &);
 
+  MetOfficeBMatrixStatic(const MetOfficeBMatrixStatic &) = delete;
+  MetOfficeBMatrixStatic & operator=(const MetOfficeBMatrixStatic &) = delete;
+  ~MetOfficeBMatrixStatic();
+
   size_t getindex(const float) const;
   size_t getsize(void) const;
   void multiply(const float, const Eigen::MatrixXf &, Eigen::MatrixXf &) const;
+  /// Multiply input matrix by the inverse of the bmatrix array for the given latitude, using
+  /// the inverses stored in the cache file if available.
+  void multiplyInverse(const float, const Eigen::MatrixXf &, Eigen::MatrixXf &) const;
   void scale(const size_t elem, const float stdev);
 
+  /// Write the bmatrix to a binary cache file, together with its inverse if \p withInverse
+  /// is true. \p config must hold the options with which this object was constructed.
+  void writeCache(const std::string & filename, const eckit::Configuration & config,
+                  bool withInverse) const;
+
  private:
   void print(std::ostream &) const override;
+  void readCache(const std::string & filename, const eckit::Configuration & config);
+  Eigen::Map<const Eigen::MatrixXf> band(const size_t iband) const;
+
   F90obfilter keyMetOfficeBMatrixStatic_;  // key to Fortran for B
   size_t nbands_;                          // number of latitude bands for B
   size_t nelements_;                       // number of elements in each dimension of B
   std::vector<float> southlimits_;         // southern latitude limit per band
   std::vector<float> northlimits_;         // northern latitude limit per band
-  std::vector<Eigen::MatrixXf> elements_;  // container for B contents
+  std::shared_ptr<const MetOfficeMatrixCache> cache_;  // mapped cache file (if used)
+  std::vector<float> ownedElements_;       // B contents unless used in place from cache_
+  const float * elements_;                 // B for band i starts at elements_ + i*nelements_^2
+  const float * inverses_;                 // inverse of B per band, laid out as elements_
+                                           // (null if not available)
 };
 
 }  // namespace ufo
@@ -0,0 +1,218 @@
+/*
+ * (C) Crown Copyright 2021 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/metoffice/MetOfficeMatrixCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "oops/util/Logger.h"
+
+namespace ufo {
+
+namespace {
+
+const char fileMagic[8] = {'U', 'F', 'O', 'M', 'O', 'C', 'O', 'V'};
+const std::uint32_t fileVersion = 1;
+const std::size_t maxSignatureLength = 1024;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t kind;
+  std::uint64_t dims[MetOfficeMatrixCache::maxDims];
+  std::uint64_t offsets[MetOfficeMatrixCache::maxArrays];  // 0 for absent arrays
+  std::uint64_t bytes[MetOfficeMatrixCache::maxArrays];
+  std::uint64_t signatureLength;
+  char signature[maxSignatureLength];
+};
+
+std::size_t aligned(std::size_t offset) {
+  const std::size_t alignment = MetOfficeMatrixCache::alignment;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+const FileHeader & header(const void * address) {
+  return *static_cast<const FileHeader *>(address);
+}
+
+/// Mappings currently open in this process, indexed by file name.
+std::mutex openCachesMutex;
+std::map<std::string, std::weak_ptr<const MetOfficeMatrixCache>> openCaches;
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+void MetOfficeMatrixCache::write(const std::string & filename, Kind kind,
+                                 const std::array<std::uint64_t, maxDims> & dims,
+                                 const std::vector<ArrayData> & arrays,
+                                 const std::string & signature) {
+  if (arrays.size() > maxArrays)
+    throw eckit::BadParameter("Too many arrays to write to " + filename, Here());
+  if (signature.size() > maxSignatureLength)
+    throw eckit::BadParameter("Signature too long to write to " + filename, Here());
+
+  FileHeader hdr;
+  std::memset(&hdr, 0, sizeof(hdr));
+  std::memcpy(hdr.magic, fileMagic, sizeof(fileMagic));
+  hdr.version = fileVersion;
+  hdr.kind = static_cast<std::uint32_t>(kind);
+  for (std::size_t i = 0; i < maxDims; ++i)
+    hdr.dims[i] = dims[i];
+  std::size_t offset = aligned(sizeof(FileHeader));
+  for (std::size_t i = 0; i < arrays.size(); ++i) {
+    if (arrays[i].data == nullptr)
+      continue;
+    hdr.offsets[i] = offset;
+    hdr.bytes[i] = arrays[i].bytes;
+    offset = aligned(offset + arrays[i].bytes);
+  }
+  hdr.signatureLength = signature.size();
+  std::memcpy(hdr.signature, signature.data(), signature.size());
+
+  // Processes may have the existing file mapped, so it must not be modified in place. Write a
+  // new file next to it and rename it over the old one: existing mappings keep the old contents.
+  std::vector<char> tempname(filename.begin(), filename.end());
+  const std::string suffix = ".XXXXXX";
+  tempname.insert(tempname.end(), suffix.begin(), suffix.end());
+  tempname.push_back('\0');
+  const int fd = ::mkstemp(tempname.data());
+  if (fd < 0)
+    throw eckit::CantOpenFile(filename, Here());
+  // mkstemp creates the file readable by its owner only
+  const bool opened = ::fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0;
+  ::close(fd);
+
+  std::ofstream out(tempname.data(), std::ios::binary | std::ios::trunc);
+  if (opened && out) {
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    const std::vector<char> padding(alignment, 0);
+    std::size_t position = sizeof(hdr);
+    for (std::size_t i = 0; i < arrays.size(); ++i) {
+      if (arrays[i].data == nullptr)
+        continue;
+      out.write(padding.data(), hdr.offsets[i] - position);
+      out.write(static_cast<const char *>(arrays[i].data), arrays[i].bytes);
+      position = hdr.offsets[i] + arrays[i].bytes;
+    }
+    out.write(padding.data(), offset - position);
+    out.close();
+  }
+  if (!opened || out.fail() || ::rename(tempname.data(), filename.c_str()) != 0) {
+    ::unlink(tempname.data());
+    throw eckit::WriteError("Error writing " + filename, Here());
+  }
+  oops::Log::info() << "MetOfficeMatrixCache: written " << filename << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<const MetOfficeMatrixCache> MetOfficeMatrixCache::open(
+    const std::string & filename, Kind kind, const std::string & signature) {
+  std::lock_guard<std::mutex> lock(openCachesMutex);
+  std::shared_ptr<const MetOfficeMatrixCache> cache = openCaches[filename].lock();
+  if (cache) {
+    // Validate the shared mapping against the caller's expectations
+    const FileHeader & hdr = header(cache->address_);
+    if (hdr.kind != static_cast<std::uint32_t>(kind) ||
+        std::string(hdr.signature, hdr.signatureLength) != signature)
+      throw eckit::BadValue(filename + " was not written with the requested options", Here());
+  } else {
+    cache.reset(new MetOfficeMatrixCache(filename, kind, signature));
+    openCaches[filename] = cache;
+  }
+  return cache;
+}
+
+// -----------------------------------------------------------------------------
+
+MetOfficeMatrixCache::MetOfficeMatrixCache(const std::string & filename, Kind kind,
+                                           const std::string & signature)
+  : filename_(filename)
+{
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw eckit::CantOpenFile(filename, Here());
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    throw eckit::BadValue(filename + " is not a Met Office matrix cache file", Here());
+  }
+  length_ = status.st_size;
+  address_ = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (address_ == MAP_FAILED) {
+    address_ = nullptr;
+    throw eckit::FailedSystemCall("mmap " + filename, Here());
+  }
+
+  const FileHeader & hdr = header(address_);
+  std::string error;
+  if (std::memcmp(hdr.magic, fileMagic, sizeof(fileMagic)) != 0 || hdr.version != fileVersion)
+    error = " is not a Met Office matrix cache file of a supported version";
+  else if (hdr.kind != static_cast<std::uint32_t>(kind))
+    error = " holds the wrong kind of matrix";
+  else if (hdr.signatureLength > maxSignatureLength ||
+           std::string(hdr.signature, hdr.signatureLength) != signature)
+    error = " was not written with the requested options";
+  for (std::size_t i = 0; error.empty() && i < maxArrays; ++i)
+    if (hdr.offsets[i] % alignment != 0 || hdr.offsets[i] + hdr.bytes[i] > length_)
+      error = " is truncated or corrupt";
+  if (!error.empty()) {
+    ::munmap(address_, length_);
+    address_ = nullptr;
+    throw eckit::BadValue(filename + error, Here());
+  }
+  oops::Log::debug() << "MetOfficeMatrixCache: mapped " << filename << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+MetOfficeMatrixCache::~MetOfficeMatrixCache() {
+  if (address_ != nullptr)
+    ::munmap(address_, length_);
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t MetOfficeMatrixCache::dim(std::size_t i) const {
+  ASSERT(i < maxDims);
+  return header(address_).dims[i];
+}
+
+// -----------------------------------------------------------------------------
+
+bool MetOfficeMatrixCache::has(std::size_t i) const {
+  ASSERT(i < maxArrays);
+  return header(address_).offsets[i] != 0;
+}
+
+// -----------------------------------------------------------------------------
+
+const void * MetOfficeMatrixCache::arrayData(std::size_t i, std::size_t bytes) const {
+  ASSERT(has(i));
+  const FileHeader & hdr = header(address_);
+  if (hdr.bytes[i] != bytes)
+    throw eckit::BadValue(filename_ + " is inconsistent with its header", Here());
+  return static_cast<const char *>(address_) + hdr.offsets[i];
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,92 @@
+/*
+ * (C) Crown Copyright 2021 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_METOFFICE_METOFFICEMATRIXCACHE_H_
+#define UFO_UTILS_METOFFICE_METOFFICEMATRIXCACHE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+/// \brief Read-only memory mapping of a binary file holding a Met Office error covariance
+/// matrix (see MetOfficeBMatrixStatic and MetOfficeRMatrixRadiance).
+///
+/// A file consists of a fixed-size header followed by up to `maxArrays` arrays, each starting
+/// at a multiple of `alignment` bytes, so that they can be used in place once the file is mapped.
+/// The header records the kind of matrix, up to `maxDims` dimensions, the position and size of
+/// each array and a signature identifying the options with which the matrix was read from its
+/// original file. Files are written in the byte order of the machine writing them.
+///
+/// All objects of a process opening the same file share a single mapping. As files are mapped
+/// read-only, their pages are also shared by all processes running on the same node.
+// -----------------------------------------------------------------------------
+
+class MetOfficeMatrixCache {
+ public:
+  enum class Kind : std::uint32_t {
+    BMatrix = 1,
+    RMatrix = 2
+  };
+
+  static constexpr std::size_t alignment = 64;
+  static constexpr std::size_t maxDims = 4;
+  static constexpr std::size_t maxArrays = 6;
+
+  /// An array to be written to a file: a pointer to its contents and its size in bytes.
+  /// Arrays with a null pointer are left out.
+  struct ArrayData {
+    const void * data;
+    std::size_t bytes;
+  };
+
+  /// \brief Write a file of kind \p kind with dimensions \p dims, arrays \p arrays (at most
+  /// maxArrays) and signature \p signature.
+  static void write(const std::string & filename, Kind kind,
+                    const std::array<std::uint64_t, maxDims> & dims,
+                    const std::vector<ArrayData> & arrays, const std::string & signature);
+
+  /// \brief Map file \p filename, or return the existing mapping of that file if it is already
+  /// mapped by this process. Throws an exception if the file does not hold a matrix of kind
+  /// \p kind with signature \p signature.
+  static std::shared_ptr<const MetOfficeMatrixCache> open(const std::string & filename, Kind kind,
+                                                          const std::string & signature);
+
+  ~MetOfficeMatrixCache();
+  MetOfficeMatrixCache(const MetOfficeMatrixCache &) = delete;
+  MetOfficeMatrixCache & operator=(const MetOfficeMatrixCache &) = delete;
+
+  const std::string & filename() const {return filename_;}
+  std::uint64_t dim(std::size_t i) const;
+
+  /// \brief Return true if array \p i is present in the file.
+  bool has(std::size_t i) const;
+
+  /// \brief Return a pointer to array \p i, which must hold \p n elements of type T.
+  template <typename T>
+  const T * array(std::size_t i, std::size_t n) const {
+    return static_cast<const T *>(arrayData(i, n * sizeof(T)));
+  }
+
+ private:
+  MetOfficeMatrixCache(const std::string & filename, Kind kind, const std::string & signature);
+
+  const void * arrayData(std::size_t i, std::size_t bytes) const;
+
+  std::string filename_;
+  void * address_ = nullptr;
+  std::size_t length_ = 0;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_METOFFICE_METOFFICEMATRIXCACHE_H_
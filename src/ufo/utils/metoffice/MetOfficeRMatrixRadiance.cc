@@ -6,14 +6,26 @@
  */
 
 #include <assert.h>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "eckit/config/Configuration.h"
 #include "oops/util/abor1_cpp.h"
 #include "oops/util/Logger.h"
+#include "ufo/utils/metoffice/MetOfficeMatrixCache.h"
 #include "ufo/utils/metoffice/MetOfficeRMatrixRadiance.h"
 
 namespace ufo {
 
+namespace {
+
+// Arrays stored in cache files
+enum RMatrixCacheArray {CHANNELS, ERRORS};
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 /// \brief Constructor
 MetOfficeRMatrixRadiance::MetOfficeRMatrixRadiance(const eckit::Configuration & config):
@@ -21,9 +33,34 @@ MetOfficeRMatrixRadiance::MetOfficeRMatrixRadiance(const eckit::Configuration &
 {
   oops::Log::trace() << "MetOfficeRMatrixRadiance constructor starting" << std::endl;
 
-  // Read rmatrix file into Fortran object
-  ufo_metoffice_rmatrixradiance_setup_f90(keyMetOfficeRMatrixRadiance_, config,
-                                          nchans_, wmoid_, rtype_);
+  if (config.has("RMatrix cache")) {
+    // The r matrix is small: copy it out of the cache file
+    std::shared_ptr<const MetOfficeMatrixCache> cache =
+        MetOfficeMatrixCache::open(config.getString("RMatrix cache"),
+                                   MetOfficeMatrixCache::Kind::RMatrix, "");
+    nchans_ = cache->dim(0);
+    wmoid_ = cache->dim(1);
+    rtype_ = cache->dim(2);
+    const std::int32_t * chans = cache->array<std::int32_t>(CHANNELS, nchans_);
+    const float * errors = cache->array<float>(ERRORS, nchans_);
+    channels_.assign(chans, chans + nchans_);
+    errors_.assign(errors, errors + nchans_);
+  } else {
+    // Read rmatrix file into Fortran object
+    ufo_metoffice_rmatrixradiance_setup_f90(keyMetOfficeRMatrixRadiance_, config,
+                                            nchans_, wmoid_, rtype_);
+
+    // Map Fortran data to c++
+    std::vector<int> chans_data(nchans_);
+    std::vector<float> elements_data(nchans_);
+    ufo_metoffice_rmatrixradiance_getelements_f90(keyMetOfficeRMatrixRadiance_, nchans_,
+                                                chans_data.data(), elements_data.data());
+    channels_ = chans_data;
+    errors_ = elements_data;
+
+    // Remove Fortran object as no longer needed
+    ufo_metoffice_rmatrixradiance_delete_f90(keyMetOfficeRMatrixRadiance_);
+  }
 
   // Only diagonal setup at the moment
   // OPS 1=full; 2=diagonal; 3=band diagonal
@@ -31,17 +68,6 @@ MetOfficeRMatrixRadiance::MetOfficeRMatrixRadiance(const eckit::Configuration &
     ABORT("R-matrix type not currently in use - only diagonal");
   }
 
-  // Map Fortran data to c++
-  std::vector<int> chans_data(nchans_);
-  std::vector<float> elements_data(nchans_);
-  ufo_metoffice_rmatrixradiance_getelements_f90(keyMetOfficeRMatrixRadiance_, nchans_,
-                                              chans_data.data(), elements_data.data());
-  channels_ = chans_data;
-  errors_ = elements_data;
-
-  // Remove Fortran object as no longer needed
-  ufo_metoffice_rmatrixradiance_delete_f90(keyMetOfficeRMatrixRadiance_);
-
   oops::Log::trace() << "MetOfficeRMatrixRadiance constructor end" << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -72,6 +98,16 @@ void MetOfficeRMatrixRadiance::add(const std::vector<int> & chans_used,
   }
 }
 // -----------------------------------------------------------------------------
+/// \brief Write the r matrix to a cache file
+void MetOfficeRMatrixRadiance::writeCache(const std::string & filename) const {
+  const std::vector<std::int32_t> channels(channels_.begin(), channels_.end());
+  const std::array<std::uint64_t, MetOfficeMatrixCache::maxDims> dims{{nchans_, wmoid_, rtype_}};
+  std::vector<MetOfficeMatrixCache::ArrayData> arrays(ERRORS + 1);
+  arrays[CHANNELS] = {channels.data(), nchans_ * sizeof(std::int32_t)};
+  arrays[ERRORS] = {errors_.data(), nchans_ * sizeof(float)};
+  MetOfficeMatrixCache::write(filename, MetOfficeMatrixCache::Kind::RMatrix, dims, arrays, "");
+}
+// -----------------------------------------------------------------------------
 /// \brief Print
 void MetOfficeRMatrixRadiance::print(std::ostream & os) const {
   os << "MetOfficeRMatrixRadiance: print starting" << std::endl;
@@ -27,6 +27,10 @@ namespace ufo {
 /// MetOfficeRMatrixStatic: Met Office static model covariance
 /// This class provides access to the static r matrix used for radiance
 /// processing by the Met Office.
+///
+/// The r matrix is read from the file given by the "RMatrix" option unless the
+/// "RMatrix cache" option is set, in which case it is read from a binary file
+/// written by writeCache().
 // -----------------------------------------------------------------------------
 
 class MetOfficeRMatrixRadiance : public util::Printable,
@@ -38,6 +42,9 @@ class MetOfficeRMatrixRadiance : public util::Printable,
 
   void add(const std::vector<int> &, const Eigen::MatrixXf &, Eigen::MatrixXf &) const;
 
+  /// Write the r matrix to a binary cache file.
+  void writeCache(const std::string & filename) const;
+
  private:
   void print(std::ostream &) const override;
   F90obfilter keyMetOfficeRMatrixRadiance_;
@@ -38,8 +38,6 @@ void Cal_HeightFromPressure::runTransform(const std::vector<bool> &apply) {
 
   const size_t nlocs_ = obsdb_.nlocs();
 
-  ioda::ObsSpace::RecIdxIter irec;
-
   // 1. Obtain air pressure from the ObsSpace.
 
   getObservation(pressureGroup_, pressureCoord_, airPressure);
@@ -61,12 +59,11 @@ void Cal_HeightFromPressure::runTransform(const std::vector<bool> &apply) {
 
   // 3. Loop over each record
   // -------------------------------------------------------------------------------------
-  for (irec = obsdb_.recidx_begin(); irec != obsdb_.recidx_end(); ++irec) {
-    const std::vector<std::size_t> &rSort = obsdb_.recidx_vector(irec);
-    size_t ilocs = 0;
+  hasBeenUpdated = forEachRecord([&](gsl::span<const std::size_t> rSort) {
+    bool recordUpdated = false;
 
     // 3.1 Loop over each record
-    for (ilocs = 0; ilocs < rSort.size(); ++ilocs) {
+    for (size_t ilocs = 0; ilocs < rSort.size(); ++ilocs) {
       // Cycle if the data have been excluded by the where statement
       if (!apply[rSort[ilocs]]) continue;
 
@@ -76,9 +73,10 @@ void Cal_HeightFromPressure::runTransform(const std::vector<bool> &apply) {
       geopotentialHeight[rSort[ilocs]] = formulas::Pressure_To_Height(
           airPressure[rSort[ilocs]], method());
 
-      hasBeenUpdated = true;
+      recordUpdated = true;
     }
-  }
+    return recordUpdated;
+  });
 
   if (hasBeenUpdated) {
     // If the geopotential height was updated, save it as a DerivedValue.
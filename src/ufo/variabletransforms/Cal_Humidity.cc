@@ -86,7 +86,6 @@ Method: -
 void Cal_RelativeHumidity::methodUKMO(const std::vector<bool> &apply) {
   const size_t nlocs_ = obsdb_.nlocs();
 
-  float Q_sub_s_ice, Q_sub_s_w;
   float pressure, temperature, dewPoint;
   std::vector<float> airTemperature;
   std::vector<float> dewPointTemperature;
@@ -144,87 +143,89 @@ void Cal_RelativeHumidity::methodUKMO(const std::vector<bool> &apply) {
                           "P, T and Td", Here());
   }
 
-  // Lambda function to evaluate Saturated specific humidity
+  // 3. Select the locations to update and the temperatures to use
   // temp_1: airTemprature or dewPointTemperature
   // temp_2: airTemperature
   // -----------------------------------------------------------------------------------------------
-  auto evaluateSatSpecHumidity = [&](float temp_1, float temp_2){
-    float e_sub_s_w, e_sub_s_ice;
-    // sat. vapor pressure from Dewpoint  temperature - wrt water
-    e_sub_s_w = formulas::SatVaporPres_fromTemp(temp_1,
-                                                formulation());
-    e_sub_s_w = formulas::SatVaporPres_correction(e_sub_s_w,
-                                                  temp_1,
-                                                  pressure,
-                                                  formulation());
-    // Convert sat. vapor pressure (wrt water) to saturated specific humidity (water)
-    Q_sub_s_w = formulas::Qsat_From_Psat(e_sub_s_w, pressure);
-
-    // sat. vapor pressure from Drybulb temperature  - wrt ice
-    e_sub_s_ice = formulas::SatVaporPres_fromTemp(temp_2,
-                                                 formulas::MethodFormulation::LandoltBornstein);
-    e_sub_s_ice = formulas::SatVaporPres_correction(e_sub_s_ice,
-                                                    temp_2,
-                                                    pressure,
-                                                    formulation());
-    // Convert sat. vapor pressure (wrt ice) to saturated specific humidity (ice)
-    Q_sub_s_ice = formulas::Qsat_From_Psat(e_sub_s_ice, pressure);
-  };
-
-  // 3. Loop over each record
-  // -----------------------------------------------------------------------------------------------
-  for (ioda::ObsSpace::RecIdxIter irec = obsdb_.recidx_begin();
-       irec != obsdb_.recidx_end(); ++irec) {
-    const std::vector<std::size_t> &rSort = obsdb_.recidx_vector(irec);
-
-    // 3.1 Loop over each record
-    for (size_t iloc : rSort) {
-      // if the data have been excluded by the where statement
-      if (!apply[iloc]) continue;
-
-      // store some variables
-      pressure = airPressure[iloc];
-      temperature = airTemperature[iloc];
-      dewPoint = dewPointTemperature[iloc];
-
-      // There is very little sensitivity of calculated RH to P
-      // (less than 0.1% to change from 1000 to 800 hPa)
-      // --> so for surface observation that do not have any airPressure
-      //     we set it to 1000 hPa.
-      if (pressure == missingValueFloat && surfaceData) {
-        pressure = 100000.0;  // default pressure in Pascal
-      }
+  std::vector<float> temp_1(nlocs_, missingValueFloat);
+  std::vector<float> temp_2(nlocs_, missingValueFloat);
+  std::vector<float> pressureUsed(nlocs_, missingValueFloat);
+  std::vector<bool> fromDewPoint(nlocs_, false);
+  for (size_t iloc = 0; iloc < nlocs_; ++iloc) {
+    // if the data have been excluded by the where statement
+    if (!apply[iloc]) continue;
+
+    // store some variables
+    pressure = airPressure[iloc];
+    temperature = airTemperature[iloc];
+    dewPoint = dewPointTemperature[iloc];
+
+    // There is very little sensitivity of calculated RH to P
+    // (less than 0.1% to change from 1000 to 800 hPa)
+    // --> so for surface observation that do not have any airPressure
+    //     we set it to 1000 hPa.
+    if (pressure == missingValueFloat && surfaceData) {
+      pressure = 100000.0;  // default pressure in Pascal
+    }
 
-      // Cycle if observatoin are valid
-      if (temperature == missingValueFloat ||
-          pressure <= 1.0) continue;
-
-      // if dewpoint temperature is reported (most stations)
-      if (dewPoint > 1.0) {
-        // calculate saturated specific humidity wrt water and ice
-        evaluateSatSpecHumidity(dewPoint, temperature);
-
-        // if saturated specific humidity wrt water and ice are positive
-        // calculate relative humidity
-        if (Q_sub_s_w > 0 && Q_sub_s_ice > 0) {
-          relativeHumidity[iloc] = (Q_sub_s_w / Q_sub_s_ice) * 100.0;
-          if (!allowSuperSaturation_)
-            relativeHumidity[iloc] = std::min(100.0f, relativeHumidity[iloc]);
-          hasBeenUpdated = true;
-        }
-      // if relative humidity (Rh) is reported (small minority of stations)
-      // update from Rh wrt water to Rh wrt ice for temperatures below freezing
-      } else if (relativeHumidity[iloc] != missingValueFloat &&
-                temperature < ufo::Constants::t0c) {
-        // calculate saturated specific humidity wrt water and ice
-        evaluateSatSpecHumidity(temperature, temperature);
-        // update from Rh wrt water to Rh wrt ice for temperatures below freezing
-        relativeHumidity[iloc] *= (Q_sub_s_w / Q_sub_s_ice);
+    // Cycle if observatoin are valid
+    if (temperature == missingValueFloat ||
+        pressure <= 1.0) continue;
+
+    // if dewpoint temperature is reported (most stations)
+    if (dewPoint > 1.0) {
+      temp_1[iloc] = dewPoint;
+      temp_2[iloc] = temperature;
+      pressureUsed[iloc] = pressure;
+      fromDewPoint[iloc] = true;
+    // if relative humidity (Rh) is reported (small minority of stations)
+    // update from Rh wrt water to Rh wrt ice for temperatures below freezing
+    } else if (relativeHumidity[iloc] != missingValueFloat &&
+               temperature < ufo::Constants::t0c) {
+      temp_1[iloc] = temperature;
+      temp_2[iloc] = temperature;
+      pressureUsed[iloc] = pressure;
+    }
+  }
+
+  // 4. Evaluate saturated specific humidity for all selected locations at once
+  // -----------------------------------------------------------------------------------------------
+  // sat. vapor pressure from temp_1 - wrt water
+  std::vector<float> Q_sub_s_w(nlocs_);
+  formulas::SatVaporPres_fromTemp(temp_1, Q_sub_s_w, formulation());
+  formulas::SatVaporPres_correction(Q_sub_s_w, temp_1, pressureUsed, formulation());
+  // Convert sat. vapor pressure (wrt water) to saturated specific humidity (water)
+  formulas::Qsat_From_Psat(Q_sub_s_w, pressureUsed, Q_sub_s_w);
+
+  // sat. vapor pressure from Drybulb temperature  - wrt ice
+  std::vector<float> Q_sub_s_ice(nlocs_);
+  formulas::SatVaporPres_fromTemp(temp_2, Q_sub_s_ice,
+                                  formulas::MethodFormulation::LandoltBornstein);
+  formulas::SatVaporPres_correction(Q_sub_s_ice, temp_2, pressureUsed, formulation());
+  // Convert sat. vapor pressure (wrt ice) to saturated specific humidity (ice)
+  formulas::Qsat_From_Psat(Q_sub_s_ice, pressureUsed, Q_sub_s_ice);
+
+  // 5. Calculate relative humidity
+  // -----------------------------------------------------------------------------------------------
+  for (size_t iloc = 0; iloc < nlocs_; ++iloc) {
+    if (pressureUsed[iloc] == missingValueFloat) continue;
+
+    if (fromDewPoint[iloc]) {
+      // if saturated specific humidity wrt water and ice are positive
+      // calculate relative humidity
+      if (Q_sub_s_w[iloc] > 0 && Q_sub_s_ice[iloc] > 0) {
+        relativeHumidity[iloc] = (Q_sub_s_w[iloc] / Q_sub_s_ice[iloc]) * 100.0;
         if (!allowSuperSaturation_)
           relativeHumidity[iloc] = std::min(100.0f, relativeHumidity[iloc]);
-
         hasBeenUpdated = true;
       }
+    } else {
+      // update from Rh wrt water to Rh wrt ice for temperatures below freezing
+      relativeHumidity[iloc] *= (Q_sub_s_w[iloc] / Q_sub_s_ice[iloc]);
+      if (!allowSuperSaturation_)
+        relativeHumidity[iloc] = std::min(100.0f, relativeHumidity[iloc]);
+
+      hasBeenUpdated = true;
     }
   }
 
@@ -301,45 +302,41 @@ void Cal_RelativeHumidity::methodUKMOmixingratio(const std::vector<bool> &apply)
                           "P, T and MixingRatio", Here());
   }
 
-  for (ioda::ObsSpace::RecIdxIter irec = obsdb_.recidx_begin();
-       irec != obsdb_.recidx_end(); ++irec) {
-    const std::vector<std::size_t> &rSort = obsdb_.recidx_vector(irec);
-
-    // Loop over each record
-    for (size_t iloc : rSort) {
-      if (!apply[iloc]) continue;
-
-      // Store some variables
-      const float pressure = airPressure[iloc];
-      const float temperature = airTemperature[iloc];
-      const float mixRatio = mixingRatio[iloc];
-
-      if (pressure > 0  &&
-          pressure != missingValueFloat &&
-          temperature != missingValueFloat &&
-          mixRatio != missingValueFloat) {
-        // Sat. vapor pressure from Drybulb temperature  - wrt ice
-        float e_sub_s_ice = formulas::SatVaporPres_fromTemp(temperature,
-                                                            formulation());
-        e_sub_s_ice = formulas::SatVaporPres_correction(e_sub_s_ice,
-                                                        temperature,
-                                                        pressure,
-                                                        formulation());
-        // Convert sat. vapor pressure (wrt ice) to saturated specific humidity (ice)
-        const float Q_sub_s_ice = formulas::Qsat_From_Psat(e_sub_s_ice, pressure);
-
-        // Calculate RH
-        if (mixRatio >= 0 && Q_sub_s_ice > 0) {
-          relativeHumidity[iloc] = (mixRatio / Q_sub_s_ice) * 100.0f;
-        } else {
-          relativeHumidity[iloc] = missingValueFloat;
-        }
-        hasBeenUpdated = true;
-        if (relativeHumidity[iloc] != missingValueFloat &&
-            !allowSuperSaturation_) {
-          relativeHumidity[iloc] = std::min(100.0f, relativeHumidity[iloc]);
-        }
-      }
+  // Select the locations to update
+  std::vector<float> temperatureUsed(nlocs_, missingValueFloat);
+  std::vector<float> pressureUsed(nlocs_, missingValueFloat);
+  for (size_t iloc = 0; iloc < nlocs_; ++iloc) {
+    if (!apply[iloc]) continue;
+    if (airPressure[iloc] > 0  &&
+        airPressure[iloc] != missingValueFloat &&
+        airTemperature[iloc] != missingValueFloat &&
+        mixingRatio[iloc] != missingValueFloat) {
+      temperatureUsed[iloc] = airTemperature[iloc];
+      pressureUsed[iloc] = airPressure[iloc];
+    }
+  }
+
+  // Sat. vapor pressure from Drybulb temperature  - wrt ice
+  std::vector<float> Q_sub_s_ice(nlocs_);
+  formulas::SatVaporPres_fromTemp(temperatureUsed, Q_sub_s_ice, formulation());
+  formulas::SatVaporPres_correction(Q_sub_s_ice, temperatureUsed, pressureUsed, formulation());
+  // Convert sat. vapor pressure (wrt ice) to saturated specific humidity (ice)
+  formulas::Qsat_From_Psat(Q_sub_s_ice, pressureUsed, Q_sub_s_ice);
+
+  for (size_t iloc = 0; iloc < nlocs_; ++iloc) {
+    if (pressureUsed[iloc] == missingValueFloat) continue;
+    const float mixRatio = mixingRatio[iloc];
+
+    // Calculate RH
+    if (mixRatio >= 0 && Q_sub_s_ice[iloc] > 0) {
+      relativeHumidity[iloc] = (mixRatio / Q_sub_s_ice[iloc]) * 100.0f;
+    } else {
+      relativeHumidity[iloc] = missingValueFloat;
+    }
+    hasBeenUpdated = true;
+    if (relativeHumidity[iloc] != missingValueFloat &&
+        !allowSuperSaturation_) {
+      relativeHumidity[iloc] = std::min(100.0f, relativeHumidity[iloc]);
     }
   }
   // Assign the derived relative humidity as DerivedObsValue
@@ -353,7 +350,7 @@ void Cal_RelativeHumidity::methodUKMOmixingratio(const std::vector<bool> &apply)
 void Cal_RelativeHumidity::methodDEFAULT(const std::vector<bool> &apply) {
   const size_t nlocs = obsdb_.nlocs();
 
-  float esat, qvs, qv, satVaporPres;
+  float esat, qvs, qv;
 
   std::vector<float> specificHumidity;
   std::vector<float> airTemperature;
@@ -383,17 +380,26 @@ void Cal_RelativeHumidity::methodDEFAULT(const std::vector<bool> &apply) {
   // Initialise this vector with missing value
   relativeHumidity.assign(nlocs, missingValueFloat);
 
-  // Loop over all obs
+  // Select the locations to update
+  std::vector<float> temperatureUsed(nlocs, missingValueFloat);
   for (size_t jobs = 0; jobs < nlocs; ++jobs) {
     // if the data have been excluded by the where statement
     if (!apply[jobs]) continue;
 
     if (specificHumidity[jobs] != missingValueFloat &&
-        airTemperature[jobs] != missingValueFloat && pressure[jobs] != missingValueFloat) {
-      // Calculate saturation vapor pressure from temperature according to requested formulation
+        airTemperature[jobs] != missingValueFloat && pressure[jobs] != missingValueFloat)
+      temperatureUsed[jobs] = airTemperature[jobs];
+  }
+
+  // Calculate saturation vapor pressure from temperature according to requested formulation
+  std::vector<float> satVaporPres(nlocs);
+  formulas::SatVaporPres_fromTemp(temperatureUsed, satVaporPres, formulation());
+
+  // Loop over all obs
+  for (size_t jobs = 0; jobs < nlocs; ++jobs) {
+    if (temperatureUsed[jobs] != missingValueFloat) {
       // Double-check result is always lower than 15% of incoming pressure.
-      satVaporPres = formulas::SatVaporPres_fromTemp(airTemperature[jobs], formulation());
-      esat = std::min(pressure[jobs]*0.15f, satVaporPres);
+      esat = std::min(pressure[jobs]*0.15f, satVaporPres[jobs]);
 
       // Convert sat. vapor pressure to sat water vapor mixing ratio
       qvs = 0.622 * esat/(pressure[jobs]-esat);
@@ -453,7 +459,7 @@ void Cal_SpecificHumidity::runTransform(const std::vector<bool> &apply) {
 
 void Cal_SpecificHumidity::methodDEFAULT(const std::vector<bool> &) {
   const size_t nlocs = obsdb_.nlocs();
-  float esat, qvs, qv, satVaporPres;
+  float esat, qvs, qv;
   std::vector<float> relativeHumidity;
   std::vector<float> dewPointTemperature;
   std::vector<float> airTemperature;
@@ -513,11 +519,15 @@ void Cal_SpecificHumidity::methodDEFAULT(const std::vector<bool> &) {
   // to compute saturated vapor pressure, convert this to mixing ratio using relative
   // humidity, then end up with final conversion of mixing ratio to specific humdity.
 
+  // Saturation vapor pressure is missing wherever the temperature used is missing.
+  std::vector<float> satVaporPres(nlocs);
+  formulas::SatVaporPres_fromTemp(have_dewpoint ? dewPointTemperature : airTemperature,
+                                  satVaporPres, formulation());
+
   if (have_dewpoint) {
     for (size_t jobs = 0; jobs < nlocs; ++jobs) {
       if (pressure[jobs] != missingValueFloat && dewPointTemperature[jobs] != missingValueFloat) {
-        satVaporPres = formulas::SatVaporPres_fromTemp(dewPointTemperature[jobs], formulation());
-        esat = std::min(pressure[jobs]*0.15f, satVaporPres);
+        esat = std::min(pressure[jobs]*0.15f, satVaporPres[jobs]);
         qv = 0.622 * esat/(pressure[jobs]-esat);
         specificHumidity[jobs] = std::max(1.0e-12f, qv/(1.0f+qv));
       }
@@ -526,8 +536,7 @@ void Cal_SpecificHumidity::methodDEFAULT(const std::vector<bool> &) {
     for (size_t jobs = 0; jobs < nlocs; ++jobs) {
       if (pressure[jobs] != missingValueFloat && airTemperature[jobs] != missingValueFloat &&
                 relativeHumidity[jobs] != missingValueFloat) {
-        satVaporPres = formulas::SatVaporPres_fromTemp(airTemperature[jobs], formulation());
-        esat = std::min(pressure[jobs]*0.15f, satVaporPres);
+        esat = std::min(pressure[jobs]*0.15f, satVaporPres[jobs]);
         qvs = 0.622 * esat/(pressure[jobs]-esat);
         qv = std::max(1.0e-12f, relativeHumidity[jobs]*qvs);
         specificHumidity[jobs] = std::max(1.0e-12f, qv/(1.0f+qv));
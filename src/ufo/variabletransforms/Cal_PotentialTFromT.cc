@@ -84,10 +84,7 @@ void Cal_PotentialTFromT::runTransform(const std::vector<bool> &apply) {
                           "pressure, temperature and temperature error", Here());
   }
 
-  for (ioda::ObsSpace::RecIdxIter irec = obsdb_.recidx_begin();
-       irec != obsdb_.recidx_end(); ++irec) {
-    const std::vector<std::size_t> &rSort = obsdb_.recidx_vector(irec);
-
+  forEachRecord([&](gsl::span<const std::size_t> rSort) {
     // Loop over each record
     for (size_t iloc : rSort) {
       if (!apply[iloc]) continue;
@@ -104,7 +101,8 @@ void Cal_PotentialTFromT::runTransform(const std::vector<bool> &apply) {
       potTemp[iloc] = conversion * temp;
       potTempErr[iloc] = conversion * terr;
     }
-  }
+    return true;
+  });
 
   obsdb_.put_db("DerivedObsValue", potentialtempvariable_, potTemp);
   const size_t iv = obserr_.varnames().find(potentialtempvariable_);
@@ -61,17 +61,9 @@ void Cal_PressureFromHeightForProfile::methodUKMO(const std::vector<bool> &apply
   std::vector<float> stationElevation;
   std::vector<float> airPressure;
 
-  float Pvap = missingValueFloat;   // Vapour pressure
-  float Zcurrent = missingValueFloat;   // Current height value
-  float Tcurrent = missingValueFloat;   // Current temperature value
-  float Pprev = missingValueFloat;  // Previous pressure value [ps]
-  float Zprev = missingValueFloat;  // Previous height value [m]
-  float Tprev = missingValueFloat;  // Previous temperature value [k]
-
   bool hasBeenUpdated = false;
 
   const size_t nlocs_ = obsdb_.nlocs();
-  ioda::ObsSpace::RecIdxIter irec;
 
   // Here we can only use data that have not been QCed
   // so making sure UseValidDataOnly_ is set to True
@@ -141,22 +133,25 @@ void Cal_PressureFromHeightForProfile::methodUKMO(const std::vector<bool> &apply
   }
 
   // 4. Starting the calculation
-  //    Loop over each record
+  //    Loop over each record; records are independent profiles
   // -------------------------------------------------------------------------------------
-  for (irec = obsdb_.recidx_begin(); irec != obsdb_.recidx_end(); ++irec) {
-    const std::vector<std::size_t> &rSort = obsdb_.recidx_vector(irec);
+  hasBeenUpdated = forEachRecord([&](gsl::span<const std::size_t> rSort) {
+    float Pvap = missingValueFloat;   // Vapour pressure
+    float Zcurrent = missingValueFloat;   // Current height value
+    float Tcurrent = missingValueFloat;   // Current temperature value
+    bool recordUpdated = false;
     size_t ilocs = 0;
 
     // 4.1 Initialise for surface values
-    Pprev = pressureStation[rSort[ilocs]];
-    Zprev = stationElevation[rSort[ilocs]];
-    Tprev = airTemperatureSurface[rSort[ilocs]];
+    float Pprev = pressureStation[rSort[ilocs]];  // Previous pressure value [ps]
+    float Zprev = stationElevation[rSort[ilocs]];  // Previous height value [m]
+    float Tprev = airTemperatureSurface[rSort[ilocs]];  // Previous temperature value [k]
 
     // Cycle if stationElevation or airTemperatureSurface or pressureStation is
     // not valid
     if (Zprev == missingValueFloat || Tprev == missingValueFloat ||
         Pprev == missingValueFloat)
-      continue;
+      return false;
 
     // Update Tprev
     if (dewPointTemperature.empty()) {
@@ -226,9 +221,10 @@ void Cal_PressureFromHeightForProfile::methodUKMO(const std::vector<bool> &apply
       Pprev = airPressure[rSort[ilocs]];
       Zprev = Zcurrent;
       Tprev = Tcurrent;
-      hasBeenUpdated = true;
+      recordUpdated = true;
     }
-  }
+    return recordUpdated;
+  });
 
   if (hasBeenUpdated) {
     // if updated the airPressure
@@ -283,8 +279,6 @@ void Cal_PressureFromHeightForICAO::methodUKMO(const std::vector<bool> &apply) {
 
   const size_t nlocs_ = obsdb_.nlocs();
 
-  ioda::ObsSpace::RecIdxIter irec;
-
   // 0. Initialise the ouput array
   // -------------------------------------------------------------------------------
   getObservation(pressureGroup_, pressureCoord_,
@@ -307,25 +301,23 @@ void Cal_PressureFromHeightForICAO::methodUKMO(const std::vector<bool> &apply) {
     throw eckit::BadValue("GeopotentialHeight vector is the wrong size or empty ", Here());
   }
 
-  // 3. Loop over each record
+  // 3. Evaluate the ICAO pressure at every location at once
   // -------------------------------------------------------------------------------------
-  for (irec = obsdb_.recidx_begin(); irec != obsdb_.recidx_end(); ++irec) {
-    const std::vector<std::size_t> &rSort = obsdb_.recidx_vector(irec);
-    size_t ilocs = 0;
+  std::vector<float> airPressure_ICAO(nlocs_);
+  formulas::Height_To_Pressure_ICAO_atmos(geopotentialHeight, airPressure_ICAO, formulation());
 
-    // 3.1 Loop over each record
-    for (ilocs = 0; ilocs < rSort.size(); ++ilocs) {
-      // if the data have been excluded by the where statement
-      if (!apply[rSort[ilocs]]) continue;
+  // 4. Loop over each location
+  // -------------------------------------------------------------------------------------
+  for (size_t iloc = 0; iloc < nlocs_; ++iloc) {
+    // if the data have been excluded by the where statement
+    if (!apply[iloc]) continue;
 
-      // Cycle if airPressure is valid
-      if (airPressure[rSort[ilocs]] != missingValueFloat) continue;
+    // Cycle if airPressure is valid
+    if (airPressure[iloc] != missingValueFloat) continue;
 
-      airPressure[rSort[ilocs]] = formulas::Height_To_Pressure_ICAO_atmos(
-          geopotentialHeight[rSort[ilocs]], formulation());
+    airPressure[iloc] = airPressure_ICAO[iloc];
 
-      hasBeenUpdated = true;
-    }
+    hasBeenUpdated = true;
   }
 
   if (hasBeenUpdated) {
@@ -72,30 +72,22 @@ void Cal_ProfileHorizontalDrift::runTransform(const std::vector<bool> &apply) {
     throw eckit::BadValue("At least one vector is the wrong size", Here());
   }
 
-  // Number of locations in the ObsSpace.
-  const size_t nlocs = obsdb_.nlocs();
-
   // Output values are initialised to input values.
   std::vector<float> latitude_out = latitude_in;
   std::vector<float> longitude_out = longitude_in;
   std::vector<util::DateTime> datetime_out = datetime_in;
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<size_t> &recnums = obsdb_.recidx_all_recnums();
-
-  // Number of profiles in the ObsSpace.
-  const size_t nprofs = recnums.size();
-
   // Perform drift calculation for each profile in the sample.
-  for (size_t jprof = 0; jprof < nprofs; ++jprof) {
-    const std::vector<size_t> &locs = obsdb_.recidx_vector(recnums[jprof]);
+  const util::DateTime *windowEnd = keep_in_window_ ? &(obsdb_.windowEnd()) : nullptr;
+  forEachRecord([&](gsl::span<const size_t> locs) {
     formulas::horizontalDrift(locs, apply,
                               latitude_in, longitude_in, datetime_in,
                               height, wind_speed, wind_from_direction,
                               latitude_out, longitude_out, datetime_out,
                               formulas::MethodFormulation::UKMO,
-                              keep_in_window_ ? &(obsdb_.windowEnd()) : nullptr);
-  }
+                              windowEnd);
+    return true;
+  });
 
   // Save output values.
   obsdb_.put_db("MetaData", "latitude", latitude_out);
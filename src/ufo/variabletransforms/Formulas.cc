@@ -43,13 +43,20 @@ MethodFormulation resolveFormulations(const std::string& input, const std::strin
 }
 
 /* -------------------------------------------------------------------------------------*/
-float SatVaporPres_fromTemp(float temp_K, MethodFormulation formulation) {
-  const float missingValueFloat = util::missingValue(1.0f);
-  const float t0c = static_cast<float>(ufo::Constants::t0c);
-  float e_sub_s = missingValueFloat;  // Saturation vapour pressure (Pa)
 
-  switch (formulation) {
-    case formulas::MethodFormulation::UKMO:
+namespace {
+
+// Element kernels shared by the scalar formulas and their array-at-a-time versions. They are
+// templated on the formulation so that the array loops are compiled for a single formulation.
+
+/// Coefficients of the polynomial fit of Goff-Gratch (1946) formulation. (Walko, 1991)
+constexpr float walkoCoeffs[9] = {610.5851f, 44.40316f, 1.430341f, 0.2641412e-1f,
+  0.2995057e-3f, 0.2031998e-5f, 0.6936113e-8f, 0.2564861e-11f, -0.3704404e-13f};
+
+template <MethodFormulation F>
+inline float satVaporPresKernel(const float temp_K) {
+  const float t0c = static_cast<float>(ufo::Constants::t0c);
+  switch (F) {
     case formulas::MethodFormulation::Sonntag: {
       /* I. Source: Eqn 7, Sonntag, D., Advancements in the field of hygrometry,
        *     Meteorol. Zeitschrift, N. F., 3, 51-66, 1994.
@@ -57,15 +64,9 @@ float SatVaporPres_fromTemp(float temp_K, MethodFormulation formulation) {
        *     or Sonntag formulations, which are all very similar (Holger Vomel,
        *     pers. comm., 2011)
       */
-      if (temp_K != missingValueFloat) {
-        e_sub_s = std::exp(-6096.9385f / temp_K + 21.2409642f - 2.711193E-2f * temp_K +
-                        1.673952E-5f * temp_K * temp_K + 2.433502f * std::log(temp_K));
-      } else {
-        e_sub_s = 0.0f;
-      }
-      break;
+      return std::exp(-6096.9385f / temp_K + 21.2409642f - 2.711193E-2f * temp_K +
+                      1.673952E-5f * temp_K * temp_K + 2.433502f * std::log(temp_K));
     }
-    case formulas::MethodFormulation::UKMOmixingratio:
     case formulas::MethodFormulation::LandoltBornstein: {
       /* Returns a saturation mixing ratio given a temperature and pressure
          using saturation vapour pressures caluclated using the Goff-Gratch
@@ -74,67 +75,164 @@ float SatVaporPres_fromTemp(float temp_K, MethodFormulation formulation) {
          Technology.  Group V/Vol 4B Meteorology.  Physical and Chemical
          properties of Air, P35.
       */
-      if (temp_K != missingValueFloat) {
-        float adj_Temp;
-        float lookup_a;
-        int lookup_i;
-
-        const float Low_temp_thd = 183.15;   // Lowest temperature for which look-up table is valid
-        const float High_temp_thd = 338.15;  // Highest temperature for which look-up table is valid
-        const float Delta_Temp = 0.1;        // Temperature increment of look-up table
-
-        //  Use the lookup table to find saturated vapour pressure.
-        adj_Temp = std::max(Low_temp_thd, temp_K);
-        adj_Temp = std::min(High_temp_thd, adj_Temp);
-
-        lookup_a = (adj_Temp - Low_temp_thd + Delta_Temp) / Delta_Temp;
-        lookup_i = static_cast<int>(lookup_a);
-        lookup_a = lookup_a - lookup_i;
-        e_sub_s = (1.0 - lookup_a) *
-                  lookuptable::LandoltBornstein_lookuptable[lookup_i] +
-                  lookup_a *
-                  lookuptable::LandoltBornstein_lookuptable[lookup_i + 1];
-      } else {
-        e_sub_s = 0.0f;
-      }
-      break;
+      const float Low_temp_thd = 183.15;   // Lowest temperature for which look-up table is valid
+      const float High_temp_thd = 338.15;  // Highest temperature for which look-up table is valid
+      const float Delta_Temp = 0.1;        // Temperature increment of look-up table
+
+      //  Use the lookup table to find saturated vapour pressure.
+      float adj_Temp = std::max(Low_temp_thd, temp_K);
+      adj_Temp = std::min(High_temp_thd, adj_Temp);
+
+      float lookup_a = (adj_Temp - Low_temp_thd + Delta_Temp) / Delta_Temp;
+      const int lookup_i = static_cast<int>(lookup_a);
+      lookup_a = lookup_a - lookup_i;
+      return (1.0 - lookup_a) *
+             lookuptable::LandoltBornstein_lookuptable[lookup_i] +
+             lookup_a *
+             lookuptable::LandoltBornstein_lookuptable[lookup_i + 1];
     }
     case formulas::MethodFormulation::Walko: {
-          // Polynomial fit of Goff-Gratch (1946) formulation. (Walko, 1991)
-          float x = std::max(-80.0f, temp_K-t0c);
-          const std::vector<float> c{610.5851f, 44.40316f, 1.430341f, 0.2641412e-1f,
-            0.2995057e-3f, 0.2031998e-5f, 0.6936113e-8f, 0.2564861e-11f, -0.3704404e-13f};
-          e_sub_s = c[0]+x*(c[1]+x*(c[2]+x*(c[3]+x*(c[4]+x*(c[5]+x*(c[6]+x*(c[7]+x*c[8])))))));
-          break;
+      // Polynomial fit of Goff-Gratch (1946) formulation. (Walko, 1991)
+      const float x = std::max(-80.0f, temp_K-t0c);
+      const float *c = walkoCoeffs;
+      return c[0]+x*(c[1]+x*(c[2]+x*(c[3]+x*(c[4]+x*(c[5]+x*(c[6]+x*(c[7]+x*c[8])))))));
     }
     case formulas::MethodFormulation::Murphy: {
       // ALTERNATIVE (costs more CPU, more accurate than Walko, 1991)
       // Source: Murphy and Koop, Review of the vapour pressure of ice and
       //       supercooled water for atmospheric applications, Q. J. R.
       //       Meteorol. Soc (2005), 131, pp. 1539-1565.
-      e_sub_s = std::exp(54.842763f - 6763.22f / temp_K - 4.210f * std::log(temp_K)
-                     + 0.000367f * temp_K + std::tanh(0.0415f * (temp_K - 218.8f))
-                     * (53.878f - 1331.22f / temp_K - 9.44523f * std::log(temp_K)
-                     + 0.014025f * temp_K));
-      break;
+      return std::exp(54.842763f - 6763.22f / temp_K - 4.210f * std::log(temp_K)
+                      + 0.000367f * temp_K + std::tanh(0.0415f * (temp_K - 218.8f))
+                      * (53.878f - 1331.22f / temp_K - 9.44523f * std::log(temp_K)
+                      + 0.014025f * temp_K));
     }
-    case formulas::MethodFormulation::NCAR:
-    case formulas::MethodFormulation::NOAA:
     case formulas::MethodFormulation::Rogers:
     default: {
       // Classical formula from Rogers and Yau (1989; Eq2.17)
-      e_sub_s = 1000. * 0.6112 * std::exp(17.67f * (temp_K - t0c) / (temp_K - 29.65f));
-      break;
+      return 1000. * 0.6112 * std::exp(17.67f * (temp_K - t0c) / (temp_K - 29.65f));
     }
   }
-  return e_sub_s;
+}
+
+template <MethodFormulation F>
+void satVaporPresLoop(gsl::span<const float> temp_K, gsl::span<float> e_sub_s) {
+  const float missing = util::missingValue(1.0f);
+  const size_t n = temp_K.size();
+  for (size_t i = 0; i < n; ++i) {
+    const float t = temp_K[i];
+    e_sub_s[i] = t != missing ? satVaporPresKernel<F>(t) : missing;
+  }
+}
+
+/// Enhancement factor needed for moist air (see SatVaporPres_correction).
+inline float enhancementFactor(const float temp_K, const float pressure) {
+  const float t0c = static_cast<float>(ufo::Constants::t0c);
+  return 1.0f + 1.0E-8f * pressure * (4.5f + 6.0E-4f * (temp_K - t0c) *(temp_K - t0c));
+}
+
+inline float qsatKernel(const float Psat, const float P) {
+  return (Constants::epsilon * Psat) /
+         (std::max(P, Psat) - (1.0f - Constants::epsilon) * Psat);
+}
+
+inline float virtualTempKernel(const float Psat, const float P, const float T) {
+  return T * ((P + Psat / Constants::epsilon) / (P + Psat));
+}
+
+inline float heightToPressureICAOKernel(const float height) {
+  const float missingValueFloat = util::missingValue(1.0f);
+  const float RepT_Bot = 1.0 / Constants::icao_temp_surface;
+  const float RepT_Top = 1.0 / Constants::icao_temp_isothermal_layer;
+  const float ZP1 = Constants::g_over_rd / Constants::icao_lapse_rate_l;
+  const float ZP2 = Constants::g_over_rd / Constants::icao_lapse_rate_u;
+  float Pressure;
+
+  if (height <= missingValueFloat) {
+    Pressure = missingValueFloat;
+  } else if (height < -5000.0) {
+    // TODO(david simonin): The original code has this test.
+    // Not sure why! Are we expecting very negative height value??
+    Pressure = missingValueFloat;
+  } else if (height < Constants::icao_height_l) {
+    // Heights up to 11,000 geopotential heigh in meter [gpm]
+    Pressure = Constants::icao_lapse_rate_l * height * RepT_Bot;
+    Pressure = std::pow((1.0 - Pressure), ZP1);
+    Pressure = 100.0 * Pressure * Constants::icao_pressure_surface;
+  } else if (height < Constants::icao_height_u) {
+    // Heights between 11,000 and 20,000 geopotential heigh in meter [gpm]
+    Pressure = Constants::g_over_rd * (height - Constants::icao_height_l) * RepT_Top;
+    Pressure = std::log(Constants::icao_pressure_l) - Pressure;
+    Pressure = 100.0 * std::exp(Pressure);
+  } else {
+    // Heights above 20,000 geopotential heigh in meter [gpm]
+    Pressure = Constants::icao_lapse_rate_u * RepT_Top *
+               (height - Constants::icao_height_u);
+    Pressure = 100.0 * Constants::icao_pressure_u *
+               std::pow((1.0 - Pressure), ZP2);
+  }
+  return Pressure;
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------------------*/
+float SatVaporPres_fromTemp(float temp_K, MethodFormulation formulation) {
+  const float missingValueFloat = util::missingValue(1.0f);
+
+  switch (formulation) {
+    case formulas::MethodFormulation::UKMO:
+    case formulas::MethodFormulation::Sonntag: {
+      if (temp_K == missingValueFloat) return 0.0f;
+      return satVaporPresKernel<MethodFormulation::Sonntag>(temp_K);
+    }
+    case formulas::MethodFormulation::UKMOmixingratio:
+    case formulas::MethodFormulation::LandoltBornstein: {
+      if (temp_K == missingValueFloat) return 0.0f;
+      return satVaporPresKernel<MethodFormulation::LandoltBornstein>(temp_K);
+    }
+    case formulas::MethodFormulation::Walko:
+      return satVaporPresKernel<MethodFormulation::Walko>(temp_K);
+    case formulas::MethodFormulation::Murphy:
+      return satVaporPresKernel<MethodFormulation::Murphy>(temp_K);
+    case formulas::MethodFormulation::NCAR:
+    case formulas::MethodFormulation::NOAA:
+    case formulas::MethodFormulation::Rogers:
+    default:
+      return satVaporPresKernel<MethodFormulation::Rogers>(temp_K);
+  }
+}
+
+void SatVaporPres_fromTemp(gsl::span<const float> temp_K, gsl::span<float> e_sub_s,
+                           MethodFormulation formulation) {
+  ASSERT(e_sub_s.size() == temp_K.size());
+  switch (formulation) {
+    case formulas::MethodFormulation::UKMO:
+    case formulas::MethodFormulation::Sonntag:
+      satVaporPresLoop<MethodFormulation::Sonntag>(temp_K, e_sub_s);
+      break;
+    case formulas::MethodFormulation::UKMOmixingratio:
+    case formulas::MethodFormulation::LandoltBornstein:
+      satVaporPresLoop<MethodFormulation::LandoltBornstein>(temp_K, e_sub_s);
+      break;
+    case formulas::MethodFormulation::Walko:
+      satVaporPresLoop<MethodFormulation::Walko>(temp_K, e_sub_s);
+      break;
+    case formulas::MethodFormulation::Murphy:
+      satVaporPresLoop<MethodFormulation::Murphy>(temp_K, e_sub_s);
+      break;
+    case formulas::MethodFormulation::NCAR:
+    case formulas::MethodFormulation::NOAA:
+    case formulas::MethodFormulation::Rogers:
+    default:
+      satVaporPresLoop<MethodFormulation::Rogers>(temp_K, e_sub_s);
+      break;
+  }
 }
 
 /* -------------------------------------------------------------------------------------*/
 float SatVaporPres_correction(float e_sub_s, float temp_K, float pressure,
                               MethodFormulation formulation) {
-  const float t0c = static_cast<float>(ufo::Constants::t0c);
-
   switch (formulation) {
     case formulas::MethodFormulation::NCAR:
     case formulas::MethodFormulation::NOAA:
@@ -147,9 +245,7 @@ float SatVaporPres_correction(float e_sub_s, float temp_K, float pressure,
          If P > 0 then eqn A4.6 of Adrian Gill's book is used to guarantee consistency with the
          saturated specific humidity.
       */
-      float FsubW;  // Enhancement factor
-      FsubW = 1.0f + 1.0E-8f * pressure * (4.5f + 6.0E-4f * (temp_K - t0c) *(temp_K - t0c));
-      e_sub_s = e_sub_s * FsubW;
+      e_sub_s = e_sub_s * enhancementFactor(temp_K, pressure);
 
       break;
     }
@@ -161,6 +257,32 @@ float SatVaporPres_correction(float e_sub_s, float temp_K, float pressure,
   }
   return e_sub_s;
 }
+
+void SatVaporPres_correction(gsl::span<float> e_sub_s, gsl::span<const float> temp_K,
+                             gsl::span<const float> pressure, MethodFormulation formulation) {
+  ASSERT(temp_K.size() == e_sub_s.size());
+  ASSERT(pressure.size() == e_sub_s.size());
+  switch (formulation) {
+    case formulas::MethodFormulation::NCAR:
+    case formulas::MethodFormulation::NOAA:
+    case formulas::MethodFormulation::UKMOmixingratio:
+    case formulas::MethodFormulation::UKMO:
+    case formulas::MethodFormulation::Sonntag: {
+      const float missing = util::missingValue(1.0f);
+      const size_t n = e_sub_s.size();
+      for (size_t i = 0; i < n; ++i) {
+        const bool valid = e_sub_s[i] != missing && temp_K[i] != missing && pressure[i] != missing;
+        e_sub_s[i] = valid ? e_sub_s[i] * enhancementFactor(temp_K[i], pressure[i]) : missing;
+      }
+      break;
+    }
+    default: {
+      std::string errString = "Aborting, no method matches enum formulas::MethodFormulation";
+      oops::Log::error() << errString;
+      throw eckit::BadValue(errString);
+    }
+  }
+}
 /* -------------------------------------------------------------------------------------*/
 
 float Qsat_From_Psat(float Psat, float P, MethodFormulation formulation) {
@@ -177,14 +299,26 @@ float Qsat_From_Psat(float Psat, float P, MethodFormulation formulation) {
       // pressure)
       //  Note that at very low pressures we apply a fix, to prevent a
       //     singularity (Qsat tends to 1.0 kg/kg).
-      QSat = (Constants::epsilon * Psat) /
-             (std::max(P, Psat) - (1.0f - Constants::epsilon) * Psat);
+      QSat = qsatKernel(Psat, P);
       break;
     }
   }
   return QSat;
 }
 
+void Qsat_From_Psat(gsl::span<const float> Psat, gsl::span<const float> P,
+                    gsl::span<float> QSat, MethodFormulation) {
+  ASSERT(P.size() == Psat.size());
+  ASSERT(QSat.size() == Psat.size());
+  // All formulations use the Sonntag (1994) formula.
+  const float missing = util::missingValue(1.0f);
+  const size_t n = Psat.size();
+  for (size_t i = 0; i < n; ++i) {
+    const bool valid = Psat[i] != missing && P[i] != missing;
+    QSat[i] = valid ? qsatKernel(Psat[i], P[i]) : missing;
+  }
+}
+
 /* -------------------------------------------------------------------------------------*/
 
 // VirtualTemperature()
@@ -196,13 +330,28 @@ float VirtualTemp_From_Psat_P_T(float Psat, float P, float T, MethodFormulation
     case formulas::MethodFormulation::NOAA:
     case formulas::MethodFormulation::UKMO:
     default: {
-      Tv = T * ((P + Psat / Constants::epsilon) / (P + Psat));
+      Tv = virtualTempKernel(Psat, P, T);
       break;
     }
   }
   return Tv;
 }
 
+void VirtualTemp_From_Psat_P_T(gsl::span<const float> Psat, gsl::span<const float> P,
+                               gsl::span<const float> T, gsl::span<float> Tv,
+                               MethodFormulation) {
+  ASSERT(P.size() == Psat.size());
+  ASSERT(T.size() == Psat.size());
+  ASSERT(Tv.size() == Psat.size());
+  // All formulations use the same expression.
+  const float missing = util::missingValue(1.0f);
+  const size_t n = Psat.size();
+  for (size_t i = 0; i < n; ++i) {
+    const bool valid = Psat[i] != missing && P[i] != missing && T[i] != missing;
+    Tv[i] = valid ? virtualTempKernel(Psat[i], P[i], T[i]) : missing;
+  }
+}
+
 /* -------------------------------------------------------------------------------------*/
 
 float VirtualTemp_From_Rh_Psat_P_T(float Rh, float Psat, float P, float T,
@@ -226,50 +375,29 @@ float VirtualTemp_From_Rh_Psat_P_T(float Rh, float Psat, float P, float T,
 /* -------------------------------------------------------------------------------------*/
 
 float Height_To_Pressure_ICAO_atmos(float height, MethodFormulation formulation) {
-  const float missingValueFloat = util::missingValue(1.0f);
-  float Pressure = missingValueFloat;
+  float Pressure = util::missingValue(1.0f);
 
   switch (formulation) {
     case formulas::MethodFormulation::NCAR:
     case formulas::MethodFormulation::NOAA:
     case formulas::MethodFormulation::UKMO:
     default: {
-      float RepT_Bot, RepT_Top, ZP1, ZP2;
-
-      RepT_Bot = 1.0 / Constants::icao_temp_surface;
-      RepT_Top = 1.0 / Constants::icao_temp_isothermal_layer;
-      ZP1 = Constants::g_over_rd / Constants::icao_lapse_rate_l;
-      ZP2 = Constants::g_over_rd / Constants::icao_lapse_rate_u;
-
-      if (height <= missingValueFloat) {
-        Pressure = missingValueFloat;
-      } else if (height < -5000.0) {
-        // TODO(david simonin): The original code has this test.
-        // Not sure why! Are we expecting very negative height value??
-        Pressure = missingValueFloat;
-      } else if (height < Constants::icao_height_l) {
-        // Heights up to 11,000 geopotential heigh in meter [gpm]
-        Pressure = Constants::icao_lapse_rate_l * height * RepT_Bot;
-        Pressure = std::pow((1.0 - Pressure), ZP1);
-        Pressure = 100.0 * Pressure * Constants::icao_pressure_surface;
-      } else if (height < Constants::icao_height_u) {
-        // Heights between 11,000 and 20,000 geopotential heigh in meter [gpm]
-        Pressure = Constants::g_over_rd * (height - Constants::icao_height_l) * RepT_Top;
-        Pressure = std::log(Constants::icao_pressure_l) - Pressure;
-        Pressure = 100.0 * std::exp(Pressure);
-      } else {
-        // Heights above 20,000 geopotential heigh in meter [gpm]
-        Pressure = Constants::icao_lapse_rate_u * RepT_Top *
-                   (height - Constants::icao_height_u);
-        Pressure = 100.0 * Constants::icao_pressure_u *
-                   std::pow((1.0 - Pressure), ZP2);
-      }
+      Pressure = heightToPressureICAOKernel(height);
       break;
     }
   }
   return Pressure;
 }
 
+void Height_To_Pressure_ICAO_atmos(gsl::span<const float> height, gsl::span<float> pressure,
+                                   MethodFormulation) {
+  ASSERT(pressure.size() == height.size());
+  // All formulations use the ICAO standard; missing heights are handled by the kernel.
+  const size_t n = height.size();
+  for (size_t i = 0; i < n; ++i)
+    pressure[i] = heightToPressureICAOKernel(height[i]);
+}
+
 /* -------------------------------------------------------------------------------------*/
 
 float Pressure_To_Height(float pressure, MethodFormulation method) {
@@ -338,6 +466,15 @@ float GetWindDirection(float u, float v) {
   return windDirection;
 }
 
+void GetWindDirection(gsl::span<const float> u, gsl::span<const float> v,
+                      gsl::span<float> windDirection) {
+  ASSERT(v.size() == u.size());
+  ASSERT(windDirection.size() == u.size());
+  const size_t n = u.size();
+  for (size_t i = 0; i < n; ++i)
+    windDirection[i] = GetWindDirection(u[i], v[i]);
+}
+
 float GetWindSpeed(float u, float v) {
   const float missing = util::missingValue(1.0f);
   float windSpeed = missing;  // wind speed
@@ -348,6 +485,18 @@ float GetWindSpeed(float u, float v) {
   return windSpeed;
 }
 
+void GetWindSpeed(gsl::span<const float> u, gsl::span<const float> v,
+                  gsl::span<float> windSpeed) {
+  ASSERT(v.size() == u.size());
+  ASSERT(windSpeed.size() == u.size());
+  const float missing = util::missingValue(1.0f);
+  const size_t n = u.size();
+  for (size_t i = 0; i < n; ++i) {
+    const bool valid = u[i] != missing && v[i] != missing;
+    windSpeed[i] = valid ? hypot(u[i], v[i]) : missing;
+  }
+}
+
 float GetWind_U(float windSpeed, float windFromDirection) {
   const float missing = util::missingValue(1.0f);
   float u = missing;  // wind speed
@@ -359,6 +508,18 @@ float GetWind_U(float windSpeed, float windFromDirection) {
   return u;
 }
 
+void GetWind_U(gsl::span<const float> windSpeed, gsl::span<const float> windFromDirection,
+               gsl::span<float> u) {
+  ASSERT(windFromDirection.size() == windSpeed.size());
+  ASSERT(u.size() == windSpeed.size());
+  const float missing = util::missingValue(1.0f);
+  const size_t n = windSpeed.size();
+  for (size_t i = 0; i < n; ++i) {
+    const bool valid = windFromDirection[i] != missing &&
+                       windSpeed[i] != missing && windSpeed[i] >= 0;
+    u[i] = valid ? -windSpeed[i] * sin(windFromDirection[i] * Constants::deg2rad) : missing;
+  }
+}
 
 float GetWind_V(float windSpeed, float windFromDirection) {
   const float missing = util::missingValue(1.0f);
@@ -371,6 +532,19 @@ float GetWind_V(float windSpeed, float windFromDirection) {
   return v;
 }
 
+void GetWind_V(gsl::span<const float> windSpeed, gsl::span<const float> windFromDirection,
+               gsl::span<float> v) {
+  ASSERT(windFromDirection.size() == windSpeed.size());
+  ASSERT(v.size() == windSpeed.size());
+  const float missing = util::missingValue(1.0f);
+  const size_t n = windSpeed.size();
+  for (size_t i = 0; i < n; ++i) {
+    const bool valid = windFromDirection[i] != missing &&
+                       windSpeed[i] != missing && windSpeed[i] >= 0;
+    v[i] = valid ? -windSpeed[i] * cos(windFromDirection[i] * Constants::deg2rad) : missing;
+  }
+}
+
 /* -------------------------------------------------------------------------------------
 This formula takes a radiance (W / (m^2.sr.m^-1)) and a wavenumber (m^-1) and outputs
 a brightness temperature. where:
@@ -403,7 +577,7 @@ int RenumberScanPosition(const int scanpos, const int numFOV) {
 /* -------------------------------------------------------------------------------------*/
 
 void horizontalDrift
-(const std::vector<size_t> & locs,
+(gsl::span<const size_t> locs,
  const std::vector<bool> & apply,
  const std::vector<float> & lat_in,
  const std::vector<float> & lon_in,
@@ -424,7 +598,7 @@ void horizontalDrift
   case formulas::MethodFormulation::UKMO:
   default: {
     // Location of the first entry in the profile.
-    const size_t loc0 = locs.front();
+    const size_t loc0 = locs[0];
 
     // Values of latitude, longitude and datetime at the first entry of the profile.
     const double lat0 = lat_in[loc0];
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "gsl/gsl-lite.hpp"
 #include "oops/util/DateTime.h"
 #include "oops/util/Duration.h"
 #include "oops/util/missingValues.h"
@@ -345,7 +346,7 @@ int RenumberScanPosition(int scanpos, int numFOV);
 *     are larger than this value are set to this value.
 */
 void horizontalDrift
-(const std::vector<size_t> & locs,
+(gsl::span<const size_t> locs,
  const std::vector<bool> & apply,
  const std::vector<float> & lat_in,
  const std::vector<float> & lon_in,
@@ -373,6 +374,56 @@ void horizontalDrift
 * \return BkP
 */
 float BackgroundPressure(float PSurfParamA, float  PSurfParamB, float height);
+
+// -------------------------------------------------------------------------------------
+// Array-at-a-time versions of the formulas above.
+//
+// These evaluate a formula for a whole array of locations. The formulation is resolved once
+// per call and each loop is compiled for a single formulation, so the loop bodies contain
+// no switch, no allocation and no function call and can be vectorised by the compiler.
+// All spans must have the same size. A location with a missing input gets a missing output.
+// -------------------------------------------------------------------------------------
+
+/// \brief Array version of SatVaporPres_fromTemp(float, MethodFormulation).
+void SatVaporPres_fromTemp(gsl::span<const float> temp_K, gsl::span<float> e_sub_s,
+                   const MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \brief Array version of SatVaporPres_correction(float, float, float, MethodFormulation).
+/// \p e_sub_s is corrected in place.
+void SatVaporPres_correction(gsl::span<float> e_sub_s, gsl::span<const float> temp_K,
+                        gsl::span<const float> pressure,
+                        const MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \brief Array version of Qsat_From_Psat(float, float, MethodFormulation).
+void Qsat_From_Psat(gsl::span<const float> Psat, gsl::span<const float> P,
+                    gsl::span<float> QSat,
+                    MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \brief Array version of VirtualTemp_From_Psat_P_T(float, float, float, MethodFormulation).
+void VirtualTemp_From_Psat_P_T(gsl::span<const float> Psat, gsl::span<const float> P,
+                          gsl::span<const float> T, gsl::span<float> Tv,
+                          MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \brief Array version of Height_To_Pressure_ICAO_atmos(float, MethodFormulation).
+void Height_To_Pressure_ICAO_atmos(gsl::span<const float> height, gsl::span<float> pressure,
+                            MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \brief Array version of GetWindDirection(float, float).
+void GetWindDirection(gsl::span<const float> u, gsl::span<const float> v,
+                      gsl::span<float> windDirection);
+
+/// \brief Array version of GetWindSpeed(float, float).
+void GetWindSpeed(gsl::span<const float> u, gsl::span<const float> v,
+                  gsl::span<float> windSpeed);
+
+/// \brief Array version of GetWind_U(float, float). Negative wind speeds give a missing output.
+void GetWind_U(gsl::span<const float> windSpeed, gsl::span<const float> windFromDirection,
+               gsl::span<float> u);
+
+/// \brief Array version of GetWind_V(float, float). Negative wind speeds give a missing output.
+void GetWind_V(gsl::span<const float> windSpeed, gsl::span<const float> windFromDirection,
+               gsl::span<float> v);
+
 }  // namespace formulas
 }  // namespace ufo
 
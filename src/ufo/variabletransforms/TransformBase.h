@@ -10,6 +10,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <map>
 #include <memory>
@@ -32,6 +34,7 @@
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variables.h"
 #include "ufo/filters/VariableTransformParametersBase.h"
+#include "ufo/utils/RecordIndex.h"
 #include "ufo/variabletransforms/Formulas.h"
 
 
@@ -187,6 +190,38 @@ class TransformBase {
 
   std::string getDerivedGroup(const std::string group) const;
 
+  /// \brief Call \p processRecord for each record of the obs space.
+  ///
+  /// \p processRecord is called with the locations of one record (a `gsl::span<const size_t>`),
+  /// in the order of the obs space's record index, and returns true if it updated any of them.
+  /// The record index is shared with the filter running this transform (see
+  /// ObsFilterData::recordIndex()). Records are processed in parallel when OpenMP is available,
+  /// so \p processRecord must only write to the locations of the record it is given. An
+  /// exception thrown for any record is rethrown once all records have been processed.
+  ///
+  /// \return true if \p processRecord returned true for at least one record.
+  template <typename RecordFunction>
+  bool forEachRecord(const RecordFunction &processRecord) const {
+    const std::shared_ptr<const RecordIndex> recordIndex = data_.recordIndex();
+    const std::ptrdiff_t nrecs = recordIndex->nrecs();
+    bool anyUpdated = false;
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic) reduction(||:anyUpdated)
+    for (std::ptrdiff_t irec = 0; irec < nrecs; ++irec) {
+      try {
+        if (processRecord(recordIndex->locations(irec)))
+          anyUpdated = true;
+      } catch (...) {
+#pragma omp critical(ufo_TransformBase_forEachRecord)
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+    return anyUpdated;
+  }
+
   /// subclasses to access Method and formualtion used for the calculation
   formulas::MethodFormulation method() const { return method_; }
   formulas::MethodFormulation formulation() const { return formulation_; }
@@ -0,0 +1,15 @@
+/*
+ * (C) Copyright 2021 NOAA NWS NCEP EMC
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "../ufo/ESGDomainLookup.h"
+#include "oops/runs/Run.h"
+
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  ufo::test::ESGDomainLookup tests;
+  return run.execute(tests);
+}
@@ -0,0 +1,79 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_CHANNELLEVELLOCATIONARRAY_H_
+#define TEST_UFO_CHANNELLEVELLOCATIONARRAY_H_
+
+#include <string>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "ufo/utils/ChannelLevelLocationArray.h"
+
+namespace ufo {
+namespace test {
+
+CASE("ufo/ChannelLevelLocationArray/Empty") {
+  const ChannelLevelLocationArray<float> array;
+  EXPECT_EQUAL(array.nchans(), 0);
+  EXPECT_EQUAL(array.nlevs(), 0);
+  EXPECT_EQUAL(array.nlocs(), 0);
+}
+
+CASE("ufo/ChannelLevelLocationArray/Layout") {
+  const size_t nchans = 2, nlevs = 3, nlocs = 4;
+  ChannelLevelLocationArray<double> array(nchans, nlevs, nlocs);
+  EXPECT_EQUAL(array.nchans(), nchans);
+  EXPECT_EQUAL(array.nlevs(), nlevs);
+  EXPECT_EQUAL(array.nlocs(), nlocs);
+
+  // Fill each channel through channel() and check the values are seen by level() and
+  // operator() at the expected positions.
+  for (size_t ichan = 0; ichan < nchans; ++ichan) {
+    gsl::span<double> channel = array.channel(ichan);
+    EXPECT_EQUAL(channel.size(), nlevs * nlocs);
+    for (size_t i = 0; i < channel.size(); ++i)
+      channel[i] = 100 * ichan + i;
+  }
+  const ChannelLevelLocationArray<double> & constArray = array;
+  for (size_t ichan = 0; ichan < nchans; ++ichan)
+    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
+      gsl::span<const double> level = constArray.level(ichan, ilev);
+      EXPECT_EQUAL(level.size(), nlocs);
+      for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+        const double expected = 100 * ichan + ilev * nlocs + iloc;
+        EXPECT_EQUAL(level[iloc], expected);
+        EXPECT_EQUAL(constArray(ichan, ilev, iloc), expected);
+      }
+    }
+
+  // Levels are writable too.
+  array.level(1, 2)[3] = -1;
+  EXPECT_EQUAL(constArray(1, 2, 3), -1);
+  EXPECT_EQUAL(array.channel(1)[2 * nlocs + 3], -1);
+
+  array.resize(1, 2, 3);
+  EXPECT_EQUAL(array.nchans(), 1);
+  EXPECT_EQUAL(array.nlevs(), 2);
+  EXPECT_EQUAL(array.nlocs(), 3);
+  EXPECT_EQUAL(array.channel(0).size(), 6);
+}
+
+class ChannelLevelLocationArray : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ChannelLevelLocationArray";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_CHANNELLEVELLOCATIONARRAY_H_
@@ -10,6 +10,8 @@
 
 #include "ufo/utils/dataextractor/DataExtractor.h"
 
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
 #include <memory>
 #include <set>
@@ -350,6 +352,52 @@ CASE("ufo/DataExtractor/get1DSlice/not_1d_slice") {
 }
 
 
+CASE("ufo/DataExtractor/interleaved_queries") {
+  const std::string filepath = "dataextractor_interleaved_queries.csv";
+  {
+    std::ofstream file(filepath);
+    file << "MetaData/station_id,MetaData/air_pressure,ObsBias/air_temperature\n"
+         << "string,float,float\n"
+         << "ABC,30000,0.1\n"
+         << "ABC,60000,0.2\n"
+         << "ABC,90000,0.3\n"
+         << "XYZ,40000,0.4\n"
+         << "XYZ,80000,0.5\n";
+  }
+
+  ufo::DataExtractor<float> extractor(filepath, "ObsBias");
+  extractor.scheduleSort("MetaData/station_id", InterpMethod::EXACT,
+                         ExtrapolationMode::ERROR, EquidistantChoice::FIRST);
+  extractor.scheduleSort("MetaData/air_pressure", InterpMethod::LINEAR,
+                         ExtrapolationMode::ERROR, EquidistantChoice::FIRST);
+  extractor.sort();
+
+  // Each query keeps its own state, so extractions from different stations can be interleaved.
+  ufo::DataExtractor<float>::Query first = extractor.newQuery();
+  ufo::DataExtractor<float>::Query second = extractor.newQuery();
+  first.extract(std::string("ABC"));
+  second.extract(std::string("XYZ"));
+  first.extract(45000.0f);
+  second.extract(60000.0f);
+  EXPECT(oops::is_close_absolute(second.getResult(), 0.45f, 1e-5f, 0,
+                                 oops::TestVerbosity::LOG_SUCCESS_AND_FAILURE));
+  EXPECT(oops::is_close_absolute(first.getResult(), 0.15f, 1e-5f, 0,
+                                 oops::TestVerbosity::LOG_SUCCESS_AND_FAILURE));
+
+  // Queries can be reused after getResult(), independently of the extractor's own query.
+  extractor.extract(std::string("XYZ"));
+  first.extract(std::string("XYZ"));
+  first.extract(80000.0f);
+  extractor.extract(40000.0f);
+  EXPECT(oops::is_close_absolute(first.getResult(), 0.5f, 1e-5f, 0,
+                                 oops::TestVerbosity::LOG_SUCCESS_AND_FAILURE));
+  EXPECT(oops::is_close_absolute(extractor.getResult(), 0.4f, 1e-5f, 0,
+                                 oops::TestVerbosity::LOG_SUCCESS_AND_FAILURE));
+
+  std::remove(filepath.c_str());
+}
+
+
 class DataExtractor : public oops::Test {
  public:
   DataExtractor() {}
@@ -0,0 +1,159 @@
+/*
+ * (C) Copyright 2021 NOAA NWS NCEP EMC
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_ESGDOMAINLOOKUP_H_
+#define TEST_UFO_ESGDOMAINLOOKUP_H_
+
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/obsfunctions/LAMDomainCheck/ESGDomainLookup.h"
+#include "ufo/filters/obsfunctions/LAMDomainCheck/LAMDomainCheck.interface.h"
+
+namespace ufo {
+namespace test {
+
+/// Parameters of an ESG grid, named as in the options of the LAMDomainCheck obs function.
+struct ESGGrid {
+  explicit ESGGrid(const eckit::LocalConfiguration &conf)
+    : a(conf.getFloat("a")), k(conf.getFloat("k")), plat(conf.getFloat("plat")),
+      plon(conf.getFloat("plon")), pazi(conf.getFloat("pazi", 0.0f)), dx(conf.getFloat("dx")),
+      dy(conf.getFloat("dy")), npx(conf.getInt("npx")), npy(conf.getInt("npy"))
+  {}
+
+  /// Return 1 if the point (\p lat, \p lon) is inside the domain according to the per-point check
+  /// and 0 otherwise.
+  int inDomain(float lat, float lon) const {
+    int mask = 0;
+    lam_domaincheck_esg_f90(a, k, plat, plon, pazi, npx, npy, dx, dy, lat, lon, mask);
+    return mask;
+  }
+
+  float a, k, plat, plon, pazi, dx, dy;
+  int npx, npy;
+};
+
+/// Append to \p lat and \p lon two points on either side of the domain edge crossed by the
+/// segment from (\p lat1, \p lon1) to (\p lat2, \p lon2), whose ends are on different sides.
+void addEdgePoints(const ESGGrid &grid, float lat1, float lon1, float lat2, float lon2,
+                   std::vector<float> &lat, std::vector<float> &lon) {
+  const int mask1 = grid.inDomain(lat1, lon1);
+  for (int iter = 0; iter < 40; ++iter) {
+    const float latMid = 0.5f * (lat1 + lat2);
+    const float lonMid = 0.5f * (lon1 + lon2);
+    if ((latMid == lat1 || latMid == lat2) && (lonMid == lon1 || lonMid == lon2))
+      break;
+    if (grid.inDomain(latMid, lonMid) == mask1) {
+      lat1 = latMid;
+      lon1 = lonMid;
+    } else {
+      lat2 = latMid;
+      lon2 = lonMid;
+    }
+  }
+  lat.push_back(lat1);
+  lon.push_back(lon1);
+  lat.push_back(lat2);
+  lon.push_back(lon2);
+}
+
+void testESGDomainLookup(const eckit::LocalConfiguration &conf) {
+  const ESGGrid grid(conf);
+  const float spacing = conf.getFloat("point spacing");
+
+  // Dense global grid of points, including both -180 and 180 degrees of longitude.
+  const int nlat = static_cast<int>(180.0f / spacing) + 1;
+  const int nlon = static_cast<int>(360.0f / spacing) + 1;
+  std::vector<float> lat, lon;
+  for (int ilat = 0; ilat < nlat; ++ilat) {
+    for (int ilon = 0; ilon < nlon; ++ilon) {
+      lat.push_back(-90.0f + ilat * spacing);
+      lon.push_back(-180.0f + ilon * spacing);
+    }
+  }
+  const size_t ngrid = lat.size();
+
+  // Points on either side of the domain edge, found by bisection between neighbouring grid
+  // points classified differently.
+  std::vector<int> gridMask(ngrid);
+  for (size_t i = 0; i < ngrid; ++i)
+    gridMask[i] = grid.inDomain(lat[i], lon[i]);
+  size_t ninside = 0;
+  for (int ilat = 0; ilat < nlat; ++ilat) {
+    for (int ilon = 0; ilon < nlon; ++ilon) {
+      const size_t i = ilat * nlon + ilon;
+      ninside += gridMask[i];
+      if (ilon + 1 < nlon && gridMask[i] != gridMask[i + 1])
+        addEdgePoints(grid, lat[i], lon[i], lat[i + 1], lon[i + 1], lat, lon);
+      if (ilat + 1 < nlat && gridMask[i] != gridMask[i + nlon])
+        addEdgePoints(grid, lat[i], lon[i], lat[i + nlon], lon[i + nlon], lat, lon);
+    }
+  }
+  const size_t nedge = lat.size() - ngrid;
+  EXPECT(ninside > 0);
+  EXPECT(nedge > 0);
+
+  // The same points with longitudes shifted by +-360 degrees.
+  const size_t nbase = lat.size();
+  for (const float shift : {360.0f, -360.0f}) {
+    for (size_t i = 0; i < nbase; ++i) {
+      lat.push_back(lat[i]);
+      lon.push_back(lon[i] + shift);
+    }
+  }
+
+  std::vector<int> mask;
+  ufo::ESGDomainLookup(grid.a, grid.k, grid.plat, grid.plon, grid.pazi, grid.dx, grid.dy,
+                       grid.npx, grid.npy).inDomain(lat, lon, mask);
+  EXPECT_EQUAL(mask.size(), lat.size());
+
+  size_t nmismatches = 0;
+  for (size_t i = 0; i < lat.size(); ++i) {
+    if (mask[i] != grid.inDomain(lat[i], lon[i])) {
+      if (nmismatches < 10)
+        oops::Log::info() << "Mismatch at lat = " << lat[i] << ", lon = " << lon[i] << std::endl;
+      ++nmismatches;
+    }
+  }
+  oops::Log::info() << lat.size() << " points compared (" << ninside << " grid points inside "
+                    << "the domain, " << nedge << " points next to its edge)" << std::endl;
+  EXPECT_EQUAL(nmismatches, 0);
+}
+
+class ESGDomainLookup : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ESGDomainLookup";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+    for (const std::string & testCaseName : conf.keys())
+    {
+      const eckit::LocalConfiguration testCaseConf(::test::TestEnvironment::config(), testCaseName);
+      ts.emplace_back(CASE("ufo/ESGDomainLookup/" + testCaseName, testCaseConf)
+                      {
+                        testESGDomainLookup(testCaseConf);
+                      });
+    }
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_ESGDOMAINLOOKUP_H_
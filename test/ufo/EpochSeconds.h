@@ -0,0 +1,171 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_EPOCHSECONDS_H_
+#define TEST_UFO_EPOCHSECONDS_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Duration.h"
+#include "oops/util/Expect.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+#include "ufo/utils/EpochSeconds.h"
+
+namespace ufo {
+namespace test {
+
+void expectFields(const CalendarFields & fields,
+                  int year, int month, int day, int hour, int minute, int second) {
+  EXPECT_EQUAL(fields.year, year);
+  EXPECT_EQUAL(fields.month, month);
+  EXPECT_EQUAL(fields.day, day);
+  EXPECT_EQUAL(fields.hour, hour);
+  EXPECT_EQUAL(fields.minute, minute);
+  EXPECT_EQUAL(fields.second, second);
+}
+
+/// Reference implementation of PartialDateTimeBound::compare(): compare the fields of
+/// \p dateTime specified in \p bound (-1 if unspecified) one by one.
+int compareFields(const std::array<int, 6> & bound, const util::DateTime & dateTime) {
+  std::array<int, 6> fields;
+  dateTime.toYYYYMMDDhhmmss(fields[0], fields[1], fields[2], fields[3], fields[4], fields[5]);
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (bound[i] < 0 || fields[i] == bound[i])
+      continue;
+    return fields[i] < bound[i] ? -1 : 1;
+  }
+  return 0;
+}
+
+int sign(int x) {
+  return (x > 0) - (x < 0);
+}
+
+CASE("ufo/EpochSeconds/toAndFromDateTime") {
+  EXPECT_EQUAL(toEpochSeconds(util::DateTime(1970, 1, 1, 0, 0, 0)), 0);
+  EXPECT_EQUAL(toEpochSeconds(util::DateTime(2000, 2, 29, 12, 0, 0)), 951825600);
+  EXPECT_EQUAL(toEpochSeconds(util::DateTime(1969, 12, 31, 23, 59, 59)), -1);
+  EXPECT_EQUAL(toEpochSeconds(util::DateTime(1900, 1, 1, 0, 0, 0)), -2208988800);
+  EXPECT(fromEpochSeconds(-2208988800) == util::DateTime(1900, 1, 1, 0, 0, 0));
+
+  const util::DateTime missing = util::missingValue(missing);
+  EXPECT(fromEpochSeconds(missingEpochSeconds()) == missing);
+  const std::vector<util::DateTime> dateTimes{util::DateTime(2021, 6, 1, 6, 30, 0), missing};
+  const std::vector<ufo::EpochSeconds> seconds = toEpochSeconds(dateTimes);
+  EXPECT_EQUAL(seconds[1], missingEpochSeconds());
+  EXPECT(fromEpochSeconds(seconds) == dateTimes);
+}
+
+CASE("ufo/EpochSeconds/calendarFields") {
+  expectFields(toCalendarFields(0), 1970, 1, 1, 0, 0, 0);
+  expectFields(toCalendarFields(-1), 1969, 12, 31, 23, 59, 59);
+  // Leap days, including that of a century year divisible by 400
+  expectFields(toCalendarFields(951825600), 2000, 2, 29, 12, 0, 0);
+  expectFields(toCalendarFields(1709164800), 2024, 2, 29, 0, 0, 0);
+  expectFields(toCalendarFields(-58060800), 1968, 2, 29, 0, 0, 0);
+  // Century years not divisible by 400 are not leap years
+  expectFields(toCalendarFields(-2203891200), 1900, 3, 1, 0, 0, 0);
+  expectFields(toCalendarFields(4107542400), 2100, 3, 1, 0, 0, 0);
+  // Before the start of the 400-year cycle containing the epoch
+  expectFields(toCalendarFields(-11676096001), 1599, 12, 31, 23, 59, 59);
+
+  EXPECT_EQUAL(fromCalendarFields({2000, 2, 29, 12, 0, 0}), 951825600);
+  EXPECT_EQUAL(fromCalendarFields({1900, 3, 1, 0, 0, 0}), -2203891200);
+  EXPECT_EQUAL(fromCalendarFields({1599, 12, 31, 23, 59, 59}), -11676096001);
+}
+
+CASE("ufo/EpochSeconds/calendarFieldsMatchDateTime") {
+  // Every day of two 400-year cycles, at a time of day varying from day to day
+  const util::DateTime start(1800, 1, 1, 0, 0, 0);
+  const util::DateTime end(2600, 1, 1, 0, 0, 0);
+  const util::Duration step(86400 + 3607);
+  for (util::DateTime dateTime = start; dateTime < end; dateTime += step) {
+    int year, month, day, hour, minute, second;
+    dateTime.toYYYYMMDDhhmmss(year, month, day, hour, minute, second);
+    const ufo::EpochSeconds seconds = toEpochSeconds(dateTime);
+    const CalendarFields fields = toCalendarFields(seconds);
+    if (fields.year != year || fields.month != month || fields.day != day ||
+        fields.hour != hour || fields.minute != minute || fields.second != second) {
+      expectFields(fields, year, month, day, hour, minute, second);
+      break;
+    }
+    EXPECT_EQUAL(fromCalendarFields(fields), seconds);
+  }
+}
+
+CASE("ufo/EpochSeconds/malformedBounds") {
+  for (const std::string & str : {"", "2000-01-01T00:00:00", "2000-01-01T00:00:00Z ",
+                                  "2000-01-01 00:00:00Z", "2000/01/01T00:00:00Z",
+                                  "2000-1-01T00:00:00Z", "20*0-01-01T00:00:00Z",
+                                  "2000-01-01T00:00:0aZ", "+200-01-01T00:00:00Z",
+                                  "2000-01-01T00:00:00+00:00"}) {
+    EXPECT(PartialDateTimeBound::parse(str) == boost::none);
+  }
+  EXPECT(PartialDateTimeBound::parse("****-**-**T**:**:**Z") != boost::none);
+}
+
+CASE("ufo/EpochSeconds/boundsMatchFieldComparison") {
+  const std::vector<std::string> bounds{
+    "2000-02-29T12:00:00Z",  // fully specified
+    "1900-02-28T23:59:59Z",  // fully specified, before the epoch
+    "2001-02-29T00:00:00Z",  // invalid date: compared field by field
+    "****-**-**T12:30:**Z",  // time of day only
+    "****-**-**T**:**:30Z",
+    "****-02-29T**:**:**Z",  // date fields only
+    "2000-**-**T**:**:**Z",
+    "1969-12-**T23:**:**Z",
+    "****-**-**T**:**:**Z"   // no fields specified: every date/time compares equal
+  };
+  std::vector<util::DateTime> dateTimes;
+  for (int year : {1899, 1900, 1969, 1970, 2000, 2001, 2100})
+    for (int month : {1, 2, 3, 12})
+      for (int day : {1, 28, 29}) {
+        if (month == 2 && day == 29 && !(year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)))
+          continue;
+        for (int hour : {0, 12, 23})
+          for (int minute : {0, 30, 59})
+            for (int second : {0, 30, 59})
+              dateTimes.push_back(util::DateTime(year, month, day, hour, minute, second));
+      }
+
+  for (const std::string & str : bounds) {
+    const boost::optional<PartialDateTimeBound> bound = PartialDateTimeBound::parse(str);
+    EXPECT(bound != boost::none);
+    std::array<int, 6> fields;
+    const std::array<size_t, 6> offsets{0, 5, 8, 11, 14, 17};
+    for (size_t i = 0; i < fields.size(); ++i)
+      fields[i] = str[offsets[i]] == '*' ? -1 : std::stoi(str.substr(offsets[i], i == 0 ? 4 : 2));
+    for (const util::DateTime & dateTime : dateTimes) {
+      const int expected = compareFields(fields, dateTime);
+      const int actual = sign(bound->compare(toEpochSeconds(dateTime)));
+      if (actual != expected) {
+        oops::Log::error() << "Bound " << str << ", date/time " << dateTime << std::endl;
+        EXPECT_EQUAL(actual, expected);
+      }
+    }
+  }
+}
+
+class EpochSeconds : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::EpochSeconds";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_EPOCHSECONDS_H_
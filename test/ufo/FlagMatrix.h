@@ -0,0 +1,108 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_FLAGMATRIX_H_
+#define TEST_UFO_FLAGMATRIX_H_
+
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "ufo/filters/FlagMatrix.h"
+
+namespace ufo {
+namespace test {
+
+std::vector<size_t> flaggedLocations(const FlagMatrix &matrix, size_t ivar) {
+  std::vector<size_t> locs;
+  matrix.forEachFlagged(ivar, [&locs](size_t iloc) { locs.push_back(iloc); });
+  return locs;
+}
+
+void checkAgainstVectors(const FlagMatrix &matrix, const std::vector<std::vector<bool>> &flags) {
+  EXPECT_EQUAL(matrix.nvars(), flags.size());
+  for (size_t ivar = 0; ivar < flags.size(); ++ivar) {
+    std::vector<size_t> expected;
+    for (size_t iloc = 0; iloc < flags[ivar].size(); ++iloc) {
+      EXPECT_EQUAL(matrix(ivar, iloc), flags[ivar][iloc]);
+      if (flags[ivar][iloc])
+        expected.push_back(iloc);
+    }
+    EXPECT_EQUAL(matrix.count(ivar), expected.size());
+    EXPECT_EQUAL(matrix.any(ivar), !expected.empty());
+    EXPECT_EQUAL(flaggedLocations(matrix, ivar), expected);
+  }
+}
+
+CASE("ufo/FlagMatrix/Empty") {
+  const FlagMatrix matrix(std::vector<std::vector<bool>>(3, std::vector<bool>(100, false)));
+  EXPECT(matrix.nlocs() == 100);
+  for (size_t ivar = 0; ivar < 3; ++ivar) {
+    EXPECT(matrix.count(ivar) == 0);
+    EXPECT(flaggedLocations(matrix, ivar).empty());
+  }
+}
+
+CASE("ufo/FlagMatrix/SparseAndDense") {
+  const size_t nlocs = 1000;
+  std::vector<std::vector<bool>> flags(3, std::vector<bool>(nlocs, false));
+  // Variable 0: a few flagged locations (stored as an index list).
+  flags[0][3] = flags[0][64] = flags[0][999] = true;
+  // Variable 1: every other location (stored as a bitset).
+  for (size_t iloc = 0; iloc < nlocs; iloc += 2)
+    flags[1][iloc] = true;
+  // Variable 2: all locations.
+  flags[2].assign(nlocs, true);
+  checkAgainstVectors(FlagMatrix(flags), flags);
+}
+
+CASE("ufo/FlagMatrix/View") {
+  const size_t nlocs = 200;
+  std::vector<std::vector<bool>> flags(3, std::vector<bool>(nlocs, false));
+  flags[0][0] = flags[0][127] = flags[0][199] = true;
+  for (size_t iloc = 1; iloc < nlocs; iloc += 2)
+    flags[2][iloc] = true;
+  const FlagMatrix view = FlagMatrix::viewOf(flags);
+  EXPECT(view.nlocs() == nlocs);
+  checkAgainstVectors(view, flags);
+  // The view refers to the flags rather than copying them.
+  flags[1][64] = true;
+  checkAgainstVectors(view, flags);
+}
+
+CASE("ufo/FlagMatrix/Set") {
+  const size_t nlocs = 300;
+  std::vector<std::vector<bool>> flags(2, std::vector<bool>(nlocs, false));
+  FlagMatrix matrix(2, nlocs);
+  // Flag enough locations of variable 1 to switch it from an index list to a bitset.
+  for (size_t iloc = nlocs; iloc-- > 0; ) {
+    if (iloc % 3 == 0) {
+      matrix.set(1, iloc);
+      flags[1][iloc] = true;
+    }
+  }
+  matrix.set(0, 5);
+  matrix.set(0, 5);
+  flags[0][5] = true;
+  checkAgainstVectors(matrix, flags);
+}
+
+class FlagMatrix : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::FlagMatrix";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_FLAGMATRIX_H_
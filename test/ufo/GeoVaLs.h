@@ -8,10 +8,12 @@
 #ifndef TEST_UFO_GEOVALS_H_
 #define TEST_UFO_GEOVALS_H_
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -26,6 +28,8 @@
 #include "oops/util/Logger.h"
 #include "test/TestEnvironment.h"
 #include "ufo/GeoVaLs.h"
+#include "ufo/GeoVaLsIndexMap.h"
+#include "ufo/GeoVaLsSubsetView.h"
 #include "ufo/Locations.h"
 #include "ufo/ObsOperator.h"
 
@@ -146,6 +150,117 @@ void testGeoVaLs() {
     oops::Log::trace() <<
       "GeoVaLs merge followed by a split test succeeded" << std::endl;
 
+/// Check that GeoVaLs scatter copies the mapped locations, matching variables by name
+    oops::Log::trace() <<
+      "GeoVaLs scatter copies the mapped locations, matching variables by name" << std::endl;
+    {
+      // Keep the first half of the locations in order and reverse the second half.
+      const size_t nlocs = gval.nlocs();
+      std::vector<size_t> targets(nlocs), sources(nlocs);
+      for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+        targets[jloc] = jloc;
+        sources[jloc] = jloc < nlocs / 2 ? jloc : nlocs - 1 - (jloc - nlocs / 2);
+      }
+      const GeoVaLsIndexMap map(targets, sources);
+      EXPECT_EQUAL(map.size(), nlocs);
+      EXPECT(map.nruns() <= nlocs - nlocs / 2 + 1);
+
+      // The target holds the same variables in the opposite order.
+      oops::Variables reversedVars;
+      for (size_t jvar = ingeovars.size(); jvar > 0; --jvar)
+        reversedVars.push_back(ingeovars[jvar - 1]);
+      GeoVaLs scattered(geovalsparams, ospace, reversedVars);
+      scattered.zero();
+      gval.scatter(scattered, map);
+      for (size_t jvar = 0; jvar < ingeovars.size(); ++jvar) {
+        const std::string &var = ingeovars[jvar];
+        std::vector<double> scatteredVals(scattered.nlevs(var));
+        std::vector<double> originalVals(gval.nlevs(var));
+        for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+          scattered.getAtLocation(scatteredVals, var, jloc);
+          gval.getAtLocation(originalVals, var, sources[jloc]);
+          EXPECT_EQUAL(scatteredVals, originalVals);
+        }
+      }
+
+      // Locations not mapped are left unchanged.
+      GeoVaLs partial(gval);
+      partial.zero();
+      const std::vector<size_t> firstHalf(targets.begin(), targets.begin() + nlocs / 2);
+      gval.scatter(partial, GeoVaLsIndexMap(firstHalf, firstHalf));
+      for (size_t jvar = 0; jvar < ingeovars.size(); ++jvar) {
+        const std::string &var = ingeovars[jvar];
+        std::vector<double> partialVals(partial.nlevs(var));
+        std::vector<double> expectedVals(gval.nlevs(var));
+        for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+          partial.getAtLocation(partialVals, var, jloc);
+          if (jloc < nlocs / 2)
+            gval.getAtLocation(expectedVals, var, jloc);
+          else
+            std::fill(expectedVals.begin(), expectedVals.end(), 0.0);
+          EXPECT_EQUAL(partialVals, expectedVals);
+        }
+      }
+    }
+    oops::Log::trace() <<
+      "GeoVaLs scatter test succeeded" << std::endl;
+
+/// Check that GeoVaLs gather matches a subset view and that scattering back restores the original
+    oops::Log::trace() <<
+      "GeoVaLs gather matches a subset view and is undone by a scatter" << std::endl;
+    {
+      // Keep the first half of the locations in order and reverse the second half.
+      const size_t nlocs = gval.nlocs();
+      std::vector<size_t> sources(nlocs), identity(nlocs);
+      for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+        identity[jloc] = jloc;
+        sources[jloc] = jloc < nlocs / 2 ? jloc : nlocs - 1 - (jloc - nlocs / 2);
+      }
+      const GeoVaLsIndexMap map(sources);
+      EXPECT_EQUAL(map.targetExtent(), nlocs);
+
+      GeoVaLs gathered(ospace.distribution(), gval.getVars());
+      gathered.gather(gval, map);
+      EXPECT_EQUAL(gathered.nlocs(), nlocs);
+      const GeoVaLsSubsetView view(gval, sources);
+      EXPECT_EQUAL(view.nlocs(), nlocs);
+      for (size_t jvar = 0; jvar < ingeovars.size(); ++jvar) {
+        const std::string &var = ingeovars[jvar];
+        std::vector<double> gatheredVals(gathered.nlevs(var));
+        std::vector<double> viewVals(view.nlevs(var));
+        for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+          gathered.getAtLocation(gatheredVals, var, jloc);
+          view.getAtLocation(viewVals, var, jloc);
+          EXPECT_EQUAL(gatheredVals, viewVals);
+        }
+        std::vector<double> viewLevel, gatheredLevel(nlocs);
+        view.getAtLevel(viewLevel, var, 0);
+        gathered.getAtLevel(gatheredLevel, var, 0);
+        EXPECT_EQUAL(viewLevel, gatheredLevel);
+      }
+
+      GeoVaLs restored(gval);
+      restored.zero();
+      gathered.scatter(restored, GeoVaLsIndexMap(sources, identity));
+      restored -= gval;
+      EXPECT(restored.rms() == 0.0);
+
+      // The single-location copy constructor copies one column.
+      const int lastLoc = nlocs - 1;
+      const GeoVaLs single(gval, lastLoc);
+      EXPECT_EQUAL(single.nlocs(), 1);
+      for (size_t jvar = 0; jvar < ingeovars.size(); ++jvar) {
+        const std::string &var = ingeovars[jvar];
+        std::vector<double> singleVals(single.nlevs(var));
+        std::vector<double> originalVals(gval.nlevs(var));
+        single.getAtLocation(singleVals, var, 0);
+        gval.getAtLocation(originalVals, var, lastLoc);
+        EXPECT_EQUAL(singleVals, originalVals);
+      }
+    }
+    oops::Log::trace() <<
+      "GeoVaLs gather test succeeded" << std::endl;
+
 ///  Check that  GeoVaLs & operator *= (const std::vector<float>);
     oops::Log::trace() <<
       "Check that GeoVaLs & operator *= (const std::vector<float>);" << std::endl;
@@ -354,6 +469,20 @@ void testGeoVaLsAllocatePutGet() {
     oops::Log::test() << jlev << " level: get result: " << testvalues << std::endl;
     EXPECT_EQUAL(testvalues, refvalues);
   }
+
+  /// test 3D put and get of all levels at once
+  const size_t nlocs = gval.nlocs();
+  std::vector<double> refallvalues(nlevs1 * nlocs);
+  std::iota(refallvalues.begin(), refallvalues.end(), 1.0);
+  gval.putAllLevels(refallvalues, var1);
+  std::vector<double> testallvalues;
+  gval.getAllLevels(testallvalues, var1);
+  EXPECT_EQUAL(testallvalues, refallvalues);
+  std::vector<double> testlevelvalues(nlocs);
+  gval.getAtLevel(testlevelvalues, var1, 2);
+  EXPECT_EQUAL(testlevelvalues, std::vector<double>(refallvalues.begin() + 2 * nlocs,
+                                                    refallvalues.begin() + 3 * nlocs));
+  EXPECT_THROWS(gval.putAllLevels(std::vector<double>(nlocs), var1));
 }
 
 /// \brief Tests GeoVaLs(const Locations &, const Variables &, const std::vector<size_t> &)
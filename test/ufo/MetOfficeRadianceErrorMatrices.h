@@ -85,6 +85,45 @@ void testMetOfficeRadianceErrorMatrices(const eckit::LocalConfiguration &conf) {
   ASSERT(std::abs(BHT(0, 0) - BHT_value) < tol);
   ASSERT(std::abs(HBHT(0, 0) - HBHT_value) < tol);
   ASSERT(std::abs(HBHT_R(0, 0) - HBHT_R_value) < tol);
+
+  // -----------------------------
+  // Binary cache testing
+  // ----------------------------
+
+  const std::string bcache = "MetOfficeRadianceErrorMatrices_bmatrix.cache";
+  const std::string rcache = "MetOfficeRadianceErrorMatrices_rmatrix.cache";
+  bmatrix.writeCache(bcache, conf, true);
+  rmatrix.writeCache(rcache);
+  eckit::LocalConfiguration cacheConf(conf);
+  cacheConf.set("BMatrix cache", bcache);
+  cacheConf.set("RMatrix cache", rcache);
+
+  // Matrices read from the cache files behave like those read from the original files
+  MetOfficeBMatrixStatic cachedBmatrix(cacheConf);
+  MetOfficeRMatrixRadiance cachedRmatrix(cacheConf);
+  Eigen::MatrixXf cachedBHT, cachedHBHT_R;
+  cachedBmatrix.multiply(latitude, Hmatrix.transpose(), cachedBHT);
+  EXPECT(cachedBHT == BHT);
+  cachedRmatrix.add(channels, HBHT, cachedHBHT_R);
+  EXPECT(cachedHBHT_R == HBHT_R);
+
+  // Objects using the same cache file share it; a B-matrix modified by one is not modified
+  // for the others
+  MetOfficeBMatrixStatic scaledBmatrix(cacheConf);
+  scaledBmatrix.scale(0, 2.0f);
+  cachedBmatrix.multiply(latitude, Hmatrix.transpose(), cachedBHT);
+  EXPECT(cachedBHT == BHT);
+
+  // The stored inverse undoes the multiplication
+  Eigen::MatrixXf HT = Hmatrix.transpose();
+  Eigen::MatrixXf BinvBHT;
+  cachedBmatrix.multiplyInverse(latitude, BHT, BinvBHT);
+  EXPECT((BinvBHT - HT).norm() <= 1e-2f * HT.norm());
+
+  // A cache file cannot be used with options other than those it was written with
+  eckit::LocalConfiguration otherConf(cacheConf);
+  otherConf.set("qtotal", !conf.getBool("qtotal"));
+  EXPECT_THROWS(MetOfficeBMatrixStatic otherBmatrix(otherConf));
 }
 
 class MetOfficeRadianceErrorMatrices : public oops::Test {
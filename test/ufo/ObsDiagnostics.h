@@ -8,8 +8,11 @@
 #ifndef TEST_UFO_OBSDIAGNOSTICS_H_
 #define TEST_UFO_OBSDIAGNOSTICS_H_
 
+#include <limits>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define ECKIT_TESTING_SELF_REGISTER_CASES 0
@@ -21,11 +24,14 @@
 #include "oops/base/Variables.h"
 #include "oops/mpi/mpi.h"
 #include "oops/runs/Test.h"
+#include "oops/util/missingValues.h"
 #include "test/TestEnvironment.h"
+#include "ufo/filters/Variable.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/Locations.h"
 #include "ufo/ObsBias.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsDiagnosticsStorageParameters.h"
 #include "ufo/ObsOperator.h"
 
 namespace eckit
@@ -89,6 +95,24 @@ void testObsDiagnostics() {
   // call H(x) to compute diagnostics
   hop.simulateObs(gval, hofx, ybias, bias, diags);
 
+  // register two consumers: one of all diagnostics, the other of the first one only
+  const ObsDiagnosticsConsumer allVarsConsumer(diagvars);
+  const ObsDiagnosticsConsumer firstVarConsumer(
+        oops::Variables(std::vector<std::string>{diagvars[0]}));
+  diags.addConsumer(allVarsConsumer);
+  diags.addConsumer(firstVarConsumer);
+
+  // levels kept by diagnostics stored with a restricted level range
+  std::map<std::string, std::pair<size_t, size_t>> keptLevels;
+  for (const ObsDiagnosticsStorageParameters & storage :
+         obsopparams.operatorParameters.value().diagnosticsStorage.value()) {
+    for (const Variable & variable : storage.variables.value())
+      for (size_t jch = 0; jch < variable.size(); ++jch)
+        keptLevels[variable.variable(jch)] =
+            std::make_pair(storage.minLevel.value().value_or(0),
+                           storage.maxLevel.value().value_or(std::numeric_limits<int>::max()));
+  }
+
   // read tolerance and reference Diagnostics
   const double tol = conf.getDouble("tolerance");
   eckit::LocalConfiguration diagrefconf(conf, "reference obs diagnostics");
@@ -100,12 +124,22 @@ void testObsDiagnostics() {
   for (size_t ivar = 0; ivar < diagvars.size(); ivar++) {
     const size_t nlevs = diags.nlevs(diagvars[ivar]);
     EXPECT(nlevs == diagref.nlevs(diagvars[ivar]));
+    const auto kept = keptLevels.find(diagvars[ivar]);
     for (size_t ilev = 0; ilev < nlevs; ilev++) {
       std::vector<float> ref(nlocs);
       std::vector<float> computed(nlocs);
       diags.get(computed, diagvars[ivar], ilev);
       diagref.get(ref, diagvars[ivar], ilev);
 
+      if (kept != keptLevels.end() &&
+          (ilev < kept->second.first || ilev > kept->second.second)) {
+        // levels outside the kept range are returned as missing
+        const float missing = util::missingValue(missing);
+        for (size_t iloc = 0; iloc < nlocs; iloc++)
+          EXPECT(computed[iloc] == missing);
+        continue;
+      }
+
       float rms = 0.0;
       for (size_t iloc = 0; iloc < nlocs; iloc++) {
         ref[iloc] -= computed[iloc];
@@ -118,6 +152,31 @@ void testObsDiagnostics() {
           ": difference between reference and computed: " << ref << std::endl;
     }
   }
+
+  // diagnostics are released once all consumers registered for them have finished with them
+  std::vector<float> vals;
+  diags.finishedWith(allVarsConsumer);
+  EXPECT(diags.has(diagvars[0]));
+  for (size_t ivar = 1; ivar < diagvars.size(); ivar++) {
+    EXPECT(!diags.has(diagvars[ivar]));
+    EXPECT_THROWS_AS(diags.get(vals, diagvars[ivar], 0), eckit::UserError);
+    EXPECT_THROWS_AS(diags.getAllLevels(vals, diagvars[ivar]), eckit::UserError);
+  }
+  diags.finishedWith(firstVarConsumer);
+  EXPECT(!diags.has(diagvars[0]));
+  EXPECT_THROWS_AS(diags.get(vals, diagvars[0], 0), eckit::UserError);
+
+  // finishing with diagnostics has no effect for unregistered consumers
+  ObsDiagnostics diagref2(diagrefparams, ospace, diagvars);
+  const ObsDiagnosticsConsumer unregisteredConsumer;
+  diagref2.finishedWith(unregisteredConsumer);
+  for (size_t ivar = 0; ivar < diagvars.size(); ivar++)
+    EXPECT(diagref2.has(diagvars[ivar]));
+
+  // releasing diagnostics explicitly also works for diagnostics without any consumer
+  diagref2.release(diagvars);
+  for (size_t ivar = 0; ivar < diagvars.size(); ivar++)
+    EXPECT(!diagref2.has(diagvars[ivar]));
 }
 
 // -----------------------------------------------------------------------------
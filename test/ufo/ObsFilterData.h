@@ -25,6 +25,7 @@
 #include "ufo/filters/Variables.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/utils/ChannelLevelLocationArray.h"
 
 namespace ufo {
 namespace test {
@@ -73,6 +74,41 @@ void compareMissingValues(const std::vector<float> & float_ref,
   }
 }
 
+// -----------------------------------------------------------------------------
+
+void getLevel(const GeoVaLs & gval, std::vector<float> & vals, const std::string & var,
+              size_t ilev) {
+  gval.getAtLevel(vals, var, ilev);
+}
+
+void getLevel(const ObsDiagnostics & diags, std::vector<float> & vals, const std::string & var,
+              size_t ilev) {
+  diags.get(vals, var, ilev);
+}
+
+// -----------------------------------------------------------------------------
+// Check that the bulk get() filling a ChannelLevelLocationArray returns the same values as
+// getAtLevel(), in the original and reversed level order
+
+template <typename Source>
+void checkBulkGet(const ufo::ObsFilterData & data, const Source & source,
+                  const ufo::Variable & variable, size_t nlocs, size_t nlevs) {
+  ChannelLevelLocationArray<float> values, reversed;
+  data.get(variable, values);
+  data.get(variable, reversed, true);
+  EXPECT_EQUAL(values.nchans(), 1);
+  EXPECT_EQUAL(values.nlevs(), nlevs);
+  EXPECT_EQUAL(values.nlocs(), nlocs);
+  std::vector<float> ref(nlocs);
+  for (size_t ilev = 0; ilev < nlevs; ++ilev) {
+    getLevel(source, ref, variable.variable(), ilev);
+    const gsl::span<const float> level = values.level(0, ilev);
+    const gsl::span<const float> reversedLevel = reversed.level(0, nlevs - 1 - ilev);
+    EXPECT(std::vector<float>(level.begin(), level.end()) == ref);
+    EXPECT(std::vector<float>(reversedLevel.begin(), reversedLevel.end()) == ref);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // Check the different methods to read in geovals, and check that they have
 // missing data in the same locations
@@ -365,6 +401,7 @@ void testObsFilterData() {
       int nlevs_ref = gval.nlevs(geovars.variable(jvar).variable());
       EXPECT(nlevs == nlevs_ref);
       checkGeoVaLsGet(data, gval, geovars.variable(jvar), ospace.nlocs(), nlevs);
+      checkBulkGet(data, gval, geovars.variable(jvar), ospace.nlocs(), nlevs);
     }
 
 ///  Check that associate(), has() and get() work on ObsDiags:
@@ -380,6 +417,7 @@ void testObsFilterData() {
       int nlevs_ref = obsdiags.nlevs(diagvars.variable(jvar).variable());
       EXPECT(nlevs == nlevs_ref);
       checkObsDiagsGet(data, obsdiags, diagvars.variable(jvar), ospace.nlocs(), nlevs);
+      checkBulkGet(data, obsdiags, diagvars.variable(jvar), ospace.nlocs(), nlevs);
     }
 
 ///  Check that has(), get() and dtype() work on obs functions returning floats:
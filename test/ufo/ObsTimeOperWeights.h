@@ -0,0 +1,122 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_OBSTIMEOPERWEIGHTS_H_
+#define TEST_UFO_OBSTIMEOPERWEIGHTS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Duration.h"
+#include "oops/util/Expect.h"
+#include "oops/util/FloatCompare.h"
+#include "test/TestEnvironment.h"
+#include "ufo/Locations.h"
+#include "ufo/operators/timeoper/ObsTimeOperUtil.h"
+
+namespace ufo {
+namespace test {
+
+std::vector<util::DateTime> getDateTimes(const eckit::LocalConfiguration &conf,
+                                         const std::string &key) {
+  std::vector<util::DateTime> times;
+  for (const std::string &time : conf.getStringVector(key))
+    times.push_back(util::DateTime(time));
+  return times;
+}
+
+void testObsTimeOperWeights(const eckit::LocalConfiguration &conf) {
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  const eckit::LocalConfiguration obsSpaceConf(conf, "obs space");
+  ioda::ObsTopLevelParameters obsParams;
+  obsParams.validateAndDeserialize(obsSpaceConf);
+  ioda::ObsSpace obsspace(obsParams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+  const util::Duration windowSub(conf.getString("windowSub"));
+  std::string expectedMessage;
+  if (conf.get("expect exception with message", expectedMessage)) {
+    EXPECT_THROWS_MSG(ufo::ObsTimeOperWeights weights(obsspace, windowSub),
+                      expectedMessage.c_str());
+    return;
+  }
+  const ufo::ObsTimeOperWeights weights(obsspace, windowSub);
+
+  const size_t nlocs = obsspace.nlocs();
+  EXPECT_EQUAL(weights.nlocs(), nlocs);
+  EXPECT_EQUAL(weights.nstates(), conf.getUnsigned("expected nstates"));
+
+  const std::vector<int> expectedOffsets = conf.getIntVector("expected offsets");
+  const std::vector<int> expectedSources = conf.getIntVector("expected sources");
+  const std::vector<double> expectedWeights = conf.getDoubleVector("expected weights");
+  EXPECT_EQUAL(weights.offsets(), expectedOffsets);
+  EXPECT_EQUAL(weights.sources(), expectedSources);
+  EXPECT_EQUAL(weights.weights().size(), expectedWeights.size());
+  for (size_t i = 0; i < expectedWeights.size(); ++i)
+    EXPECT(oops::is_close_absolute(weights.weights()[i], expectedWeights[i], 1e-12));
+
+  // Each observation location is copied twice; each copy is valid at the time of one of the
+  // states bracketing the observation.
+  std::vector<float> lons(nlocs), lats(nlocs);
+  std::vector<util::DateTime> times(nlocs);
+  obsspace.get_db("MetaData", "longitude", lons);
+  obsspace.get_db("MetaData", "latitude", lats);
+  obsspace.get_db("MetaData", "dateTime", times);
+  const Locations locs(lons, lats, times, obsspace.distribution());
+  const std::unique_ptr<Locations> expanded = weights.expandLocations(locs);
+  ASSERT(expanded->size() == 2 * nlocs);
+
+  const std::vector<util::DateTime> expectedTimesBefore =
+      getDateTimes(conf, "expected times of states before");
+  const std::vector<util::DateTime> expectedTimesAfter =
+      getDateTimes(conf, "expected times of states after");
+  ASSERT(expectedTimesBefore.size() == nlocs && expectedTimesAfter.size() == nlocs);
+  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+    EXPECT_EQUAL(expanded->times()[iloc], expectedTimesBefore[iloc]);
+    EXPECT_EQUAL(expanded->times()[nlocs + iloc], expectedTimesAfter[iloc]);
+    EXPECT_EQUAL(expanded->lons()[iloc], lons[iloc]);
+    EXPECT_EQUAL(expanded->lons()[nlocs + iloc], lons[iloc]);
+    EXPECT_EQUAL(expanded->lats()[iloc], lats[iloc]);
+    EXPECT_EQUAL(expanded->lats()[nlocs + iloc], lats[iloc]);
+  }
+}
+
+class ObsTimeOperWeights : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ObsTimeOperWeights";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+    for (const std::string & testCaseName : conf.keys())
+    {
+      const eckit::LocalConfiguration testCaseConf(::test::TestEnvironment::config(), testCaseName);
+      ts.emplace_back(CASE("ufo/ObsTimeOperWeights/" + testCaseName, testCaseConf)
+                      {
+                        testObsTimeOperWeights(testCaseConf);
+                      });
+    }
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_OBSTIMEOPERWEIGHTS_H_
@@ -0,0 +1,103 @@
+/*
+ * (C) Crown copyright 2021, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_RECORDINDEX_H_
+#define TEST_UFO_RECORDINDEX_H_
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "ioda/ObsSpace.h"
+
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+
+#include "ufo/filters/ObsFilterData.h"
+#include "ufo/utils/RecordIndex.h"
+
+namespace ufo {
+namespace test {
+
+void testRecordIndex(const eckit::LocalConfiguration &conf) {
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  const eckit::LocalConfiguration obsSpaceConf(conf, "obs space");
+  ioda::ObsTopLevelParameters obsParams;
+  obsParams.validateAndDeserialize(obsSpaceConf);
+  ioda::ObsSpace obsspace(obsParams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+  const ufo::RecordIndex recordIndex(obsspace);
+  EXPECT(recordIndex.isValidFor(obsspace));
+
+  // (1) Check the index against the expected layout.
+  const std::vector<size_t> expectedOffsets = conf.getUnsignedVector("expected offsets");
+  const std::vector<size_t> expectedIndices = conf.getUnsignedVector("expected indices");
+  EXPECT_EQUAL(recordIndex.offsets(), expectedOffsets);
+  EXPECT_EQUAL(recordIndex.indices(), expectedIndices);
+  EXPECT_EQUAL(recordIndex.nrecs(), expectedOffsets.size() - 1);
+  EXPECT_EQUAL(recordIndex.nlocs(), obsspace.nlocs());
+
+  // (2) Check consistency with the record index of the ObsSpace.
+  EXPECT_EQUAL(recordIndex.recordNumbers(), obsspace.recidx_all_recnums());
+  for (size_t irec = 0; irec < recordIndex.nrecs(); ++irec) {
+    const std::vector<size_t> &locs = obsspace.recidx_vector(recordIndex.recordNumbers()[irec]);
+    const gsl::span<const size_t> indexLocs = recordIndex.locations(irec);
+    EXPECT_EQUAL(static_cast<size_t>(indexLocs.size()), locs.size());
+    for (size_t pos = 0; pos < locs.size(); ++pos) {
+      EXPECT_EQUAL(indexLocs[pos], locs[pos]);
+      EXPECT_EQUAL(recordIndex.recordOfLocation()[locs[pos]], irec);
+      EXPECT_EQUAL(recordIndex.positionInRecord()[locs[pos]], pos);
+    }
+  }
+
+  // (3) Check sorting within records (here: by decreasing location index).
+  const std::vector<size_t> sorted =
+      recordIndex.sortedWithinRecords([](size_t a, size_t b) { return a > b; });
+  const std::vector<size_t> expectedSorted = conf.getUnsignedVector("expected sorted indices");
+  EXPECT_EQUAL(sorted, expectedSorted);
+
+  // (4) Check that copies of ObsFilterData share the same index.
+  const ObsFilterData data(obsspace);
+  const ObsFilterData dataCopy(data);
+  const std::shared_ptr<const RecordIndex> sharedIndex = data.recordIndex();
+  EXPECT(dataCopy.recordIndex() == sharedIndex);
+  EXPECT(data.recordIndex() == sharedIndex);
+  EXPECT_EQUAL(sharedIndex->indices(), expectedIndices);
+}
+
+class RecordIndex : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::RecordIndex";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+    for (const std::string & testCaseName : conf.keys())
+    {
+      const eckit::LocalConfiguration testCaseConf(::test::TestEnvironment::config(), testCaseName);
+      ts.emplace_back(CASE("ufo/RecordIndex/" + testCaseName, testCaseConf)
+                      {
+                        testRecordIndex(testCaseConf);
+                      });
+    }
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_RECORDINDEX_H_
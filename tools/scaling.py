@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+#
+# (C) Crown copyright 2021, Met Office
+#
+# This software is licensed under the terms of the Apache Licence Version 2.0
+# which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+
+"""Run ufo_scaling.x at several MPI task counts and tabulate the results.
+
+Example:
+
+    ufo_scaling.py --tasks 1 2 4 8 --launcher "mpiexec -n {tasks}" config.yaml
+
+Each stage of the observer pipeline is listed with its time, parallel efficiency relative to
+the smallest task count (strong scaling if the obs space has a fixed size, weak scaling if it is
+set with 'locations per task'), data received per task and peak memory. Components whose data
+received per task does not decrease with the number of tasks gather the whole obs space.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+
+
+def run(executable, launcher, config, tasks, workdir):
+    """Run the executable on `tasks` tasks and return the parsed JSON output."""
+    output = os.path.join(workdir, 'scaling_{}.json'.format(tasks))
+    with open(config) as f:
+        text = f.read()
+    # Drop any 'output file' set in the configuration and write to our own file instead.
+    text = re.sub(r'^output file:.*$', '', text, flags=re.MULTILINE)
+    task_config = os.path.join(workdir, 'scaling_{}.yaml'.format(tasks))
+    with open(task_config, 'w') as f:
+        f.write(text + '\noutput file: {}\n'.format(output))
+    command = shlex.split(launcher.format(tasks=tasks)) + [executable, task_config]
+    subprocess.run(command, check=True)
+    with open(output) as f:
+        return json.load(f)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('config', help='ufo_scaling.x configuration file')
+    parser.add_argument('--tasks', type=int, nargs='+', required=True,
+                        help='numbers of MPI tasks')
+    parser.add_argument('--launcher', default='mpiexec -n {tasks}',
+                        help='MPI launcher command; {tasks} is replaced by the number of tasks')
+    parser.add_argument('--executable', default='ufo_scaling.x',
+                        help='path to ufo_scaling.x')
+    parser.add_argument('--output', help='file to which all results are written (in JSON)')
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as workdir:
+        results = [run(args.executable, args.launcher, args.config, tasks, workdir)
+                   for tasks in sorted(args.tasks)]
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=2)
+
+    reference = results[0]
+    for iobs, obs in enumerate(reference['observations']):
+        print('\n{} ({} locations on {} tasks)'.format(obs['obs space'], obs['nlocs'],
+                                                       reference['tasks']))
+        print('{:>12} {:>6} {:>12} {:>10} {:>16} {:>14}  {}'.format(
+            'stage', 'tasks', 'seconds', 'efficiency', 'bytes/task', 'peak memory', 'sites'))
+        for istage, stage in enumerate(obs['stages']):
+            for result in results:
+                s = result['observations'][iobs]['stages'][istage]
+                nlocs_ratio = result['observations'][iobs]['nlocs'] / obs['nlocs']
+                tasks_ratio = result['tasks'] / reference['tasks']
+                # Ideal time is proportional to the number of locations per task.
+                ideal = stage['seconds'] * nlocs_ratio / tasks_ratio
+                efficiency = ideal / s['seconds'] if s['seconds'] > 0 else float('nan')
+                sites = ', '.join('{}: {}'.format(site, nbytes)
+                                  for site, nbytes in s['bytes received per site'].items())
+                print('{:>12} {:>6} {:>12.4g} {:>10.2f} {:>16} {:>14}  {}'.format(
+                    stage['stage'], result['tasks'], s['seconds'], efficiency,
+                    s['max bytes received per task'], s['peak memory'], sites))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())